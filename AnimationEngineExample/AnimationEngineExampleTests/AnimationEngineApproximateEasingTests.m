@@ -0,0 +1,126 @@
+//
+//  AnimationEngineApproximateEasingTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import "INTUEasingFunctions.h"
+#include "INTUApproximateEasingKernels.h"
+
+#define MAXIMUM_ERROR                               2e-6  // The documented bound on the error of every approximate kernel
+#define SWEEP_COUNT                                 1000000
+
+#define KERNELS(name)                               { #name, INTU##name##Kernel, INTU##name##ApproximateKernel, INTU##name##ApproximateKernelf }
+
+typedef struct {
+    const char *name;
+    double (*exact)(double);
+    double (*approximate)(double);
+    float (*approximatef)(float);
+} KernelPair;
+
+static const KernelPair kKernelPairs[] = {
+    KERNELS(EaseInSine), KERNELS(EaseOutSine), KERNELS(EaseInOutSine),
+    KERNELS(EaseInExponential), KERNELS(EaseOutExponential), KERNELS(EaseInOutExponential),
+    KERNELS(EaseInBack), KERNELS(EaseOutBack), KERNELS(EaseInOutBack),
+    KERNELS(EaseInElastic), KERNELS(EaseOutElastic), KERNELS(EaseInOutElastic),
+};
+
+static const size_t kKernelPairCount = sizeof(kKernelPairs) / sizeof(KernelPair);
+
+@interface AnimationEngineApproximateEasingTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineApproximateEasingTests
+
+#pragma mark Kernels
+
+- (void)testKernelsAreWithinErrorBound
+{
+    for (size_t k = 0; k < kKernelPairCount; k++) {
+        const KernelPair *pair = &kKernelPairs[k];
+        double maximumError = 0.0, maximumErrorf = 0.0;
+        for (int i = 0; i <= SWEEP_COUNT; i++) {
+            double p = (double)i / SWEEP_COUNT;
+            maximumError = fmax(maximumError, fabs(pair->approximate(p) - pair->exact(p)));
+            // The single precision kernel is compared at the same (rounded) progress, so only its own error is measured.
+            float pf = (float)p;
+            maximumErrorf = fmax(maximumErrorf, fabs(pair->approximatef(pf) - pair->exact(pf)));
+        }
+        XCTAssertLessThan(maximumError, MAXIMUM_ERROR, @"%s", pair->name);
+        XCTAssertLessThan(maximumErrorf, MAXIMUM_ERROR, @"%s", pair->name);
+    }
+}
+
+- (void)testKernelEndpointsAreExact
+{
+    for (size_t k = 0; k < kKernelPairCount; k++) {
+        const KernelPair *pair = &kKernelPairs[k];
+        XCTAssertEqual(pair->approximate(0.0), 0.0, @"%s", pair->name);
+        XCTAssertEqual(pair->approximate(1.0), 1.0, @"%s", pair->name);
+        XCTAssertEqual(pair->approximatef(0.0f), 0.0f, @"%s", pair->name);
+        XCTAssertEqual(pair->approximatef(1.0f), 1.0f, @"%s", pair->name);
+    }
+}
+
+#pragma mark Easing Functions
+
+- (void)testApproximateEasingFunction
+{
+    INTUEasingFunction exactFunctions[] = {
+        INTUEaseInSine, INTUEaseOutSine, INTUEaseInOutSine,
+        INTUEaseInExponential, INTUEaseOutExponential, INTUEaseInOutExponential,
+        INTUEaseInBack, INTUEaseOutBack, INTUEaseInOutBack,
+        INTUEaseInElastic, INTUEaseOutElastic, INTUEaseInOutElastic
+    };
+    INTUEasingFunction approximateFunctions[] = {
+        INTUEaseInSineApproximate, INTUEaseOutSineApproximate, INTUEaseInOutSineApproximate,
+        INTUEaseInExponentialApproximate, INTUEaseOutExponentialApproximate, INTUEaseInOutExponentialApproximate,
+        INTUEaseInBackApproximate, INTUEaseOutBackApproximate, INTUEaseInOutBackApproximate,
+        INTUEaseInElasticApproximate, INTUEaseOutElasticApproximate, INTUEaseInOutElasticApproximate
+    };
+    for (size_t i = 0; i < sizeof(exactFunctions) / sizeof(exactFunctions[0]); i++) {
+        // Each exact curve maps to its approximate version, which maps to itself.
+        XCTAssertTrue(INTUApproximateEasingFunction(exactFunctions[i]) == approximateFunctions[i], @"%zu", i);
+        XCTAssertTrue(INTUApproximateEasingFunction(approximateFunctions[i]) == approximateFunctions[i], @"%zu", i);
+        for (int j = 0; j <= 100; j++) {
+            CGFloat p = j / 100.0;
+            XCTAssertEqualWithAccuracy(approximateFunctions[i](p), exactFunctions[i](p), MAXIMUM_ERROR, @"%zu at %f", i, p);
+        }
+    }
+    
+    // Curves without an approximate version, custom easing functions and nil are passed through unchanged.
+    INTUEasingFunction unchangedFunctions[] = {
+        INTULinear, INTUEaseInOutCubic, INTUEaseInCircular, INTUEaseOutBounce,
+        ^CGFloat(CGFloat p) { return sin(p); },
+    };
+    for (size_t i = 0; i < sizeof(unchangedFunctions) / sizeof(unchangedFunctions[0]); i++) {
+        XCTAssertTrue(INTUApproximateEasingFunction(unchangedFunctions[i]) == unchangedFunctions[i], @"%zu", i);
+    }
+    XCTAssertNil(INTUApproximateEasingFunction(nil));
+}
+
+@end
@@ -0,0 +1,244 @@
+//
+//  AnimationEngineDecayTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUAnimationEngine.h"
+
+#define FRAME_DURATION                              (1.0 / 60.0)
+#define MAX_FRAMES                                  1200  // 20 seconds at 60 fps, far longer than any of these decays takes to settle
+
+@interface AnimationEngineDecayTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineDecayTests
+
+#pragma mark Decay Solver
+
+- (void)testPositionAndVelocity
+{
+    INTUDecay decay = INTUDecayMake(100.0, 1000.0, kINTUDecelerationRateNormal);
+    XCTAssertEqualWithAccuracy(INTUDecayPositionAtTime(decay, 0.0), 100.0, 1e-9);
+    XCTAssertEqualWithAccuracy(INTUDecayVelocityAtTime(decay, 0.0), 1000.0, 1e-9);
+    
+    // After one millisecond, the velocity has been multiplied by the deceleration rate once.
+    XCTAssertEqualWithAccuracy(INTUDecayVelocityAtTime(decay, 0.001), 1000.0 * kINTUDecelerationRateNormal, 1e-9);
+    
+    // The velocity is the derivative of the position.
+    for (double time = 0.0; time < 5.0; time += 0.25) {
+        double h = 1e-6;
+        double derivative = (INTUDecayPositionAtTime(decay, time + h) - INTUDecayPositionAtTime(decay, time - h)) / (2.0 * h);
+        XCTAssertEqualWithAccuracy(derivative, INTUDecayVelocityAtTime(decay, time), 1e-3);
+    }
+    
+    // The position approaches the resting position (and never passes it), which is the initial velocity divided by the decay constant
+    // away from the initial position.
+    double restingPosition = INTUDecayRestingPosition(decay);
+    XCTAssertEqualWithAccuracy(restingPosition, 100.0 - 1000.0 / (1000.0 * log(kINTUDecelerationRateNormal)), 1e-9);
+    double previousPosition = 100.0;
+    for (double time = 0.5; time <= 20.0; time += 0.5) {
+        double position = INTUDecayPositionAtTime(decay, time);
+        XCTAssertGreaterThanOrEqual(position, previousPosition);
+        XCTAssertLessThanOrEqual(position, restingPosition);
+        previousPosition = position;
+    }
+    XCTAssertEqualWithAccuracy(previousPosition, restingPosition, 1e-9 * restingPosition);
+    
+    // A negative velocity moves the other way, the same distance.
+    INTUDecay reversed = INTUDecayMake(100.0, -1000.0, kINTUDecelerationRateNormal);
+    XCTAssertEqualWithAccuracy(INTUDecayRestingPosition(reversed) - 100.0, 100.0 - restingPosition, 1e-9);
+    
+    // A faster deceleration rate stops sooner.
+    INTUDecay fast = INTUDecayMake(100.0, 1000.0, kINTUDecelerationRateFast);
+    XCTAssertLessThan(INTUDecayRestingPosition(fast), restingPosition);
+}
+
+- (void)testInvalidDecelerationRate
+{
+    // A decay with an invalid deceleration rate does not move.
+    const double rates[] = {0.0, 1.0, -0.5, 1.5};
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        INTUDecay decay = INTUDecayMake(10.0, 1000.0, rates[i]);
+        XCTAssertEqual(INTUDecayRestingPosition(decay), 10.0);
+        XCTAssertEqual(INTUDecayPositionAtTime(decay, 1.0), 10.0);
+        XCTAssertEqual(INTUDecayVelocityAtTime(decay, 1.0), 0.0);
+        XCTAssertEqual(INTUDecayDuration(decay, 0.01), 0.0);
+    }
+}
+
+- (void)testDuration
+{
+    INTUDecay decay = INTUDecayMake(-50.0, -2000.0, kINTUDecelerationRateNormal);
+    double restingPosition = INTUDecayRestingPosition(decay);
+    const double thresholds[] = {1.0, 0.1, 0.001};
+    double previousDuration = 0.0;
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); i++) {
+        // At the end of the duration, the decay is exactly the threshold away from its resting position.
+        double duration = INTUDecayDuration(decay, thresholds[i]);
+        XCTAssertEqualWithAccuracy(fabs(INTUDecayPositionAtTime(decay, duration) - restingPosition), thresholds[i], 1e-6);
+        XCTAssertGreaterThan(duration, previousDuration);
+        previousDuration = duration;
+    }
+    
+    // The duration does not depend on where the decay starts.
+    XCTAssertEqualWithAccuracy(INTUDecayDuration(INTUDecayMake(5000.0, -2000.0, kINTUDecelerationRateNormal), 0.001), previousDuration, 1e-9);
+    
+    // A decay that starts within the threshold of its resting position (or with a nonpositive threshold) takes no time.
+    XCTAssertEqual(INTUDecayDuration(INTUDecayMake(0.0, 0.0, kINTUDecelerationRateNormal), 0.01), 0.0);
+    XCTAssertEqual(INTUDecayDuration(INTUDecayMake(0.0, 0.01, kINTUDecelerationRateNormal), 0.01), 0.0);
+    XCTAssertEqual(INTUDecayDuration(decay, 0.0), 0.0);
+}
+
+- (void)testTimeToReachPosition
+{
+    INTUDecay decay = INTUDecayMake(0.0, 1000.0, kINTUDecelerationRateNormal);
+    double restingPosition = INTUDecayRestingPosition(decay);
+    XCTAssertEqual(INTUDecayTimeToReachPosition(decay, 0.0), 0.0);
+    
+    const double positions[] = {1.0, 100.0, 250.0, 450.0, restingPosition - 0.01};
+    double previousTime = 0.0;
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        double time = INTUDecayTimeToReachPosition(decay, positions[i]);
+        XCTAssertTrue(isfinite(time));
+        XCTAssertGreaterThan(time, previousTime);
+        XCTAssertEqualWithAccuracy(INTUDecayPositionAtTime(decay, time), positions[i], 1e-6);
+        previousTime = time;
+    }
+    
+    // Positions behind the direction of motion, or at or beyond the resting position, are never reached.
+    XCTAssertTrue(isinf(INTUDecayTimeToReachPosition(decay, -1.0)));
+    XCTAssertTrue(isinf(INTUDecayTimeToReachPosition(decay, restingPosition)));
+    XCTAssertTrue(isinf(INTUDecayTimeToReachPosition(decay, restingPosition + 100.0)));
+    XCTAssertTrue(isinf(INTUDecayTimeToReachPosition(INTUDecayMake(0.0, 0.0, kINTUDecelerationRateNormal), 1.0)));
+}
+
+#pragma mark Decay Animations
+
+- (void)testProjectedPositionAndDuration
+{
+    XCTAssertEqualWithAccuracy([INTUAnimationEngine projectedPositionForDecayWithPosition:100.0 velocity:1000.0 decelerationRate:kINTUDecelerationRateNormal],
+                               INTUDecayRestingPosition(INTUDecayMake(100.0, 1000.0, kINTUDecelerationRateNormal)), 1e-9);
+    
+    // The projected duration is how long the decay takes to come within a small fraction of its travel distance of rest.
+    NSTimeInterval duration = [INTUAnimationEngine projectedDurationForDecayWithVelocity:1000.0 decelerationRate:kINTUDecelerationRateNormal];
+    INTUDecay decay = INTUDecayMake(0.0, 1000.0, kINTUDecelerationRateNormal);
+    double restingPosition = INTUDecayRestingPosition(decay);
+    XCTAssertGreaterThan(duration, 0.0);
+    XCTAssertLessThan(fabs(INTUDecayPositionAtTime(decay, duration) - restingPosition), 0.001 * restingPosition);
+    XCTAssertEqualWithAccuracy([INTUAnimationEngine projectedDurationForDecayWithVelocity:-1000.0 decelerationRate:kINTUDecelerationRateNormal], duration, 1e-9);
+    XCTAssertEqual([INTUAnimationEngine projectedDurationForDecayWithVelocity:0.0 decelerationRate:kINTUDecelerationRateNormal], 0.0);
+}
+
+- (void)testUnboundedDecayLastsProjectedDuration
+{
+    // A decay that never reaches a boundary completes after its projected duration, wherever it starts (in particular, far from zero).
+    const CGFloat startPositions[] = {0.0, 5000.0, -5000.0};
+    for (size_t i = 0; i < sizeof(startPositions) / sizeof(startPositions[0]); i++) {
+        __block CFTimeInterval now = 0.0;
+        INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+        __block CGFloat lastPosition = NAN;
+        __block CFTimeInterval completionTime = NAN;
+        [engine animateDecayWithPosition:startPositions[i]
+                                velocity:1000.0
+                        decelerationRate:kINTUDecelerationRateNormal
+                         minimumPosition:-CGFLOAT_MAX
+                         maximumPosition:CGFLOAT_MAX
+                              animations:^(CGFloat position) { lastPosition = position; }
+                              completion:^(BOOL finished) { XCTAssertTrue(finished); completionTime = now; }];
+        for (int frame = 0; frame <= MAX_FRAMES && isnan(completionTime); frame++) {
+            now = frame * FRAME_DURATION;
+            [engine tick];
+        }
+        
+        NSTimeInterval duration = [INTUAnimationEngine projectedDurationForDecayWithVelocity:1000.0 decelerationRate:kINTUDecelerationRateNormal];
+        XCTAssertGreaterThanOrEqual(completionTime, duration);
+        XCTAssertLessThan(completionTime, duration + FRAME_DURATION);
+        CGFloat restingPosition = [INTUAnimationEngine projectedPositionForDecayWithPosition:startPositions[i] velocity:1000.0 decelerationRate:kINTUDecelerationRateNormal];
+        XCTAssertEqualWithAccuracy(lastPosition, restingPosition, 0.1);
+    }
+}
+
+- (void)testBoundaryHandoff
+{
+    // The decay would come to rest at about 500, but crosses the maximum position of 100 on the way, where a spring takes over and
+    // brings it back to the boundary.
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    __block CGFloat lastPosition = 0.0;
+    __block CGFloat maximumPosition = 0.0;
+    __block BOOL wasMonotonic = YES;
+    __block BOOL completed = NO;
+    [engine animateDecayWithPosition:0.0
+                            velocity:1000.0
+                    decelerationRate:kINTUDecelerationRateNormal
+                     minimumPosition:0.0
+                     maximumPosition:100.0
+                          animations:^(CGFloat position) {
+                              if (maximumPosition < 100.0 && position < lastPosition) {
+                                  // Until it crosses the boundary, the position only increases.
+                                  wasMonotonic = NO;
+                              }
+                              maximumPosition = MAX(maximumPosition, position);
+                              lastPosition = position;
+                          }
+                          completion:^(BOOL finished) { XCTAssertTrue(finished); completed = YES; }];
+    for (int frame = 0; frame <= MAX_FRAMES && !completed; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+    }
+    
+    XCTAssertTrue(completed);
+    XCTAssertTrue(wasMonotonic);
+    // The spring lets the motion carry past the boundary before pulling it back, but not as far as the decay would have gone.
+    XCTAssertGreaterThan(maximumPosition, 100.0);
+    XCTAssertLessThan(maximumPosition, 0.5 * [INTUAnimationEngine projectedPositionForDecayWithPosition:0.0 velocity:1000.0 decelerationRate:kINTUDecelerationRateNormal]);
+    XCTAssertEqualWithAccuracy(lastPosition, 100.0, 0.1);
+}
+
+- (void)testStartingOutOfBounds
+{
+    // A decay that starts past a boundary (for example, after the user dragged past the edge) springs straight back to it.
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    __block CGFloat lastPosition = NAN;
+    __block BOOL completed = NO;
+    [engine animateDecayWithPosition:-60.0
+                            velocity:0.0
+                    decelerationRate:kINTUDecelerationRateNormal
+                     minimumPosition:0.0
+                     maximumPosition:100.0
+                          animations:^(CGFloat position) { lastPosition = position; }
+                          completion:^(BOOL finished) { XCTAssertTrue(finished); completed = YES; }];
+    for (int frame = 0; frame <= MAX_FRAMES && !completed; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+    }
+    
+    XCTAssertTrue(completed);
+    XCTAssertEqualWithAccuracy(lastPosition, 0.0, 0.1);
+}
+
+@end
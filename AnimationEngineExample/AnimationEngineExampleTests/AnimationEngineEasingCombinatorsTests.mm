@@ -0,0 +1,207 @@
+//
+//  AnimationEngineEasingCombinatorsTests.mm
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import "INTUEasingFunctions.h"
+#include "INTUEasingCombinators.h"
+
+#define SAMPLE_COUNT                                1000
+#define ACCURACY                                    1e-12
+#define ACCURACY_FLOAT                              1e-6
+
+using namespace INTUEasing;
+
+static constexpr auto kSoftBack = crossfade(EaseOutBack(), EaseOutCubic(), 0.5);
+
+/** Returns YES if the curve starts at start and ends at end exactly, in both double and single precision. */
+template <typename F>
+static BOOL HasExactEndpoints(F f, double start = 0.0, double end = 1.0)
+{
+    return f(0.0) == start && f(1.0) == end && f(0.0f) == (float)start && f(1.0f) == (float)end;
+}
+
+/** Returns the largest difference between the two curves over evenly spaced samples in [0, 1], evaluated in double precision. */
+template <typename F, typename G>
+static double MaximumDifference(F f, G g)
+{
+    double maximumDifference = 0.0;
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        double p = (double)i / SAMPLE_COUNT;
+        maximumDifference = fmax(maximumDifference, fabs(f(p) - g(p)));
+    }
+    return maximumDifference;
+}
+
+/** Returns the largest difference between the two curves over evenly spaced samples in [0, 1], evaluated in single precision. */
+template <typename F, typename G>
+static double MaximumDifferencef(F f, G g)
+{
+    double maximumDifference = 0.0;
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        float p = (float)i / SAMPLE_COUNT;
+        maximumDifference = fmax(maximumDifference, fabs(f(p) - g(p)));
+    }
+    return maximumDifference;
+}
+
+@interface AnimationEngineEasingCombinatorsTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineEasingCombinatorsTests
+
+#pragma mark Reverse
+
+- (void)testReverse
+{
+    // Reversing an ease in curve gives the matching ease out curve, and vice versa.
+    XCTAssertLessThan(MaximumDifference(reverse(EaseInCubic()), EaseOutCubic()), ACCURACY);
+    XCTAssertLessThan(MaximumDifference(reverse(EaseOutQuintic()), EaseInQuintic()), ACCURACY);
+    XCTAssertLessThan(MaximumDifference(reverse(EaseInSine()), EaseOutSine()), ACCURACY);
+    XCTAssertLessThan(MaximumDifferencef(reverse(EaseInCubic()), EaseOutCubic()), ACCURACY_FLOAT);
+    
+    // A symmetric curve is its own reverse, and reversing twice gives back the original curve.
+    XCTAssertLessThan(MaximumDifference(reverse(EaseInOutCubic()), EaseInOutCubic()), ACCURACY);
+    XCTAssertLessThan(MaximumDifference(reverse(reverse(EaseOutElastic())), EaseOutElastic()), ACCURACY);
+}
+
+#pragma mark Mirror
+
+- (void)testMirror
+{
+    const auto mirrored = mirror(EaseOutCubic());
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        double p = (double)i / SAMPLE_COUNT;
+        // The curve runs at twice the speed over the first half, then backwards over the second half.
+        if (p < 0.5) {
+            XCTAssertEqual(mirrored(p), INTUEaseOutCubicKernel(2 * p), @"%f", p);
+        }
+        XCTAssertEqualWithAccuracy(mirrored(1 - p), mirrored(p), ACCURACY, @"%f", p);
+    }
+    
+    // The full curve is reached exactly at the midpoint.
+    XCTAssertEqual(mirrored(0.5), 1.0);
+    XCTAssertEqual(mirrored(0.5f), 1.0f);
+}
+
+#pragma mark Sequence
+
+- (void)testSequence
+{
+    const double splits[] = { 0.5, 0.25, 0.3, 0.9 };
+    for (size_t i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+        const double split = splits[i];
+        const auto sequenced = sequence(EaseInCubic(), EaseOutElastic(), split);
+        for (int j = 0; j <= SAMPLE_COUNT; j++) {
+            double p = (double)j / SAMPLE_COUNT;
+            // Each curve is scaled in both time and output to its part of the animation.
+            double expected = p < split ? split * INTUEaseInCubicKernel(p / split)
+                                        : split + (1 - split) * INTUEaseOutElasticKernel((p - split) / (1 - split));
+            XCTAssertEqualWithAccuracy(sequenced(p), expected, ACCURACY, @"%f at %f", split, p);
+        }
+        
+        // The second curve starts exactly at the split, and the first curve ends there.
+        XCTAssertEqual(sequenced(split), split, @"%f", split);
+        XCTAssertEqual(sequenced((float)split), (float)split, @"%f", split);
+        XCTAssertEqualWithAccuracy(sequenced(nextafter(split, 0.0)), split, ACCURACY, @"%f", split);
+    }
+    
+    // With the default split at the midpoint, a sequence of two linear curves is linear.
+    XCTAssertLessThan(MaximumDifference(sequence(Linear(), Linear()), Linear()), ACCURACY);
+}
+
+#pragma mark Crossfade
+
+- (void)testCrossfade
+{
+    // A constant weight of 0.0 or 1.0 gives exactly the first or the second curve.
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        double p = (double)i / SAMPLE_COUNT;
+        XCTAssertEqual(crossfade(EaseInSine(), EaseOutBounce(), 0.0)(p), INTUEaseInSineKernel(p), @"%f", p);
+        XCTAssertEqual(crossfade(EaseInSine(), EaseOutBounce(), 1.0)(p), INTUEaseOutBounceKernel(p), @"%f", p);
+        XCTAssertEqualWithAccuracy(crossfade(EaseInSine(), EaseOutBounce(), 0.25)(p),
+                                   0.75 * INTUEaseInSineKernel(p) + 0.25 * INTUEaseOutBounceKernel(p), ACCURACY, @"%f", p);
+        
+        // A linear weight fades from the first curve to the second over the course of the animation.
+        XCTAssertEqualWithAccuracy(crossfade(EaseInSine(), EaseOutBounce(), Linear())(p),
+                                   (1 - p) * INTUEaseInSineKernel(p) + p * INTUEaseOutBounceKernel(p), ACCURACY, @"%f", p);
+    }
+}
+
+#pragma mark Endpoints
+
+- (void)testEndpointsAreExact
+{
+    // These kernels start and end exactly at 0.0 and 1.0 (the back and bounce kernels are off by a few ulps, so they are not used here),
+    // and the combinators must preserve that for any split or weight.
+    XCTAssertTrue(HasExactEndpoints(EaseInOutCubic()));
+    XCTAssertTrue(HasExactEndpoints(EaseOutElastic()));
+    XCTAssertTrue(HasExactEndpoints(EaseInOutExponential()));
+    XCTAssertTrue(HasExactEndpoints(EaseOutSineApproximate()));
+    
+    XCTAssertTrue(HasExactEndpoints(reverse(EaseInOutCubic())));
+    XCTAssertTrue(HasExactEndpoints(reverse(EaseOutElastic())));
+    XCTAssertTrue(HasExactEndpoints(mirror(EaseInOutCubic()), 0.0, 0.0));
+    XCTAssertTrue(HasExactEndpoints(mirror(EaseOutElastic()), 0.0, 0.0));
+    XCTAssertTrue(HasExactEndpoints(crossfade(EaseInOutExponential(), EaseOutSineApproximate(), Linear())));
+    for (int i = 1; i < SAMPLE_COUNT; i++) {
+        double fraction = (double)i / SAMPLE_COUNT;
+        XCTAssertTrue(HasExactEndpoints(sequence(EaseInOutCubic(), EaseOutElastic(), fraction)), @"%f", fraction);
+        XCTAssertTrue(HasExactEndpoints(sequence(EaseInOutExponential(), EaseOutSineApproximate(), fraction)), @"%f", fraction);
+        XCTAssertTrue(HasExactEndpoints(crossfade(EaseInOutCubic(), EaseOutElastic(), fraction)), @"%f", fraction);
+        XCTAssertTrue(HasExactEndpoints(crossfade(EaseInOutExponential(), EaseOutSineApproximate(), fraction)), @"%f", fraction);
+    }
+    
+    // Nested combinators keep their endpoints as well.
+    XCTAssertTrue(HasExactEndpoints(reverse(sequence(EaseOutElastic(), crossfade(EaseInOutCubic(), EaseOutSineApproximate(), 0.3), 0.7))));
+    XCTAssertTrue(HasExactEndpoints(mirror(sequence(reverse(EaseOutElastic()), EaseInOutExponential(), 0.4)), 0.0, 0.0));
+}
+
+#pragma mark Exported Curves
+
+- (void)testExportedCurves
+{
+    INTUEasingKernel kernel = INTU_EASING_KERNEL(kSoftBack);
+    INTUEasingKernelf kernelf = INTU_EASING_KERNELF(kSoftBack);
+    INTUEasingBatchKernel batchKernel = INTU_EASING_BATCH_KERNEL(kSoftBack);
+    INTUEasingFunction easing = easingFunction(kSoftBack);
+    
+    double input[SAMPLE_COUNT + 1], output[SAMPLE_COUNT + 1];
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        input[i] = (double)i / SAMPLE_COUNT;
+    }
+    batchKernel(input, output, SAMPLE_COUNT + 1);
+    for (int i = 0; i <= SAMPLE_COUNT; i++) {
+        double p = input[i];
+        XCTAssertEqual(kernel(p), kSoftBack(p), @"%f", p);
+        XCTAssertEqual(kernelf((float)p), kSoftBack((float)p), @"%f", p);
+        XCTAssertEqual(output[i], kSoftBack(p), @"%f", p);
+        XCTAssertEqual(easing(p), (CGFloat)kSoftBack((CGFloat)p), @"%f", p);
+    }
+}
+
+@end
@@ -0,0 +1,246 @@
+//
+//  AnimationEngineEasingTableTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include "INTUEasingTable.h"
+
+#define KERNEL(name)                                { #name, INTU##name##Kernel }
+
+typedef struct {
+    const char *name;
+    INTUEasingKernel kernel;
+} NamedKernel;
+
+static const NamedKernel kSmoothKernels[] = {
+    KERNEL(Linear),
+    KERNEL(EaseInSine), KERNEL(EaseOutSine), KERNEL(EaseInOutSine),
+    KERNEL(EaseInQuadratic), KERNEL(EaseOutQuadratic), KERNEL(EaseInOutQuadratic),
+    KERNEL(EaseInCubic), KERNEL(EaseOutCubic), KERNEL(EaseInOutCubic),
+    KERNEL(EaseInQuartic), KERNEL(EaseOutQuartic), KERNEL(EaseInOutQuartic),
+    KERNEL(EaseInQuintic), KERNEL(EaseOutQuintic), KERNEL(EaseInOutQuintic),
+};
+
+static const NamedKernel kOvershootingKernels[] = {
+    KERNEL(EaseInBack), KERNEL(EaseOutBack), KERNEL(EaseInOutBack),
+    KERNEL(EaseInElastic), KERNEL(EaseOutElastic), KERNEL(EaseInOutElastic),
+};
+
+static const NamedKernel kOtherKernels[] = {
+    KERNEL(EaseInExponential), KERNEL(EaseOutExponential), KERNEL(EaseInOutExponential),
+    KERNEL(EaseInCircular), KERNEL(EaseOutCircular), KERNEL(EaseInOutCircular),
+    KERNEL(EaseInBounce), KERNEL(EaseOutBounce), KERNEL(EaseInOutBounce),
+};
+
+/** Returns the maximum difference between the table and the kernel, measured independently of the table's own error report. */
+static double maximumError(INTUEasingTableRef table, INTUEasingKernel kernel)
+{
+    double maximum = 0.0;
+    for (int i = 0; i <= 100000; i++) {
+        double p = i / 100000.0;
+        maximum = fmax(maximum, fabs(INTUEasingTableEvaluate(table, p) - kernel(p)));
+    }
+    return maximum;
+}
+
+/** Returns the maximum difference between the table and the kernel over a dense sweep, including points within 1e-15 of either end. */
+static double denseMaximumError(INTUEasingTableRef table, INTUEasingKernel kernel)
+{
+    double maximum = 0.0;
+    for (int i = 0; i <= 4000000; i++) {
+        double p = i / 4000000.0;
+        maximum = fmax(maximum, fabs(INTUEasingTableEvaluate(table, p) - kernel(p)));
+    }
+    for (int i = 1; i <= 15; i++) {
+        double distance = pow(10.0, -i);
+        maximum = fmax(maximum, fabs(INTUEasingTableEvaluate(table, distance) - kernel(distance)));
+        maximum = fmax(maximum, fabs(INTUEasingTableEvaluate(table, 1.0 - distance) - kernel(1.0 - distance)));
+    }
+    return maximum;
+}
+
+/** Checks that every evaluation function returns the kernel's values at p = 0.0 and p = 1.0 exactly (to single precision). */
+static bool endpointsAreExact(INTUEasingTableRef table, INTUEasingKernel kernel)
+{
+    const double input[] = {0.0, 1.0, -1.0, 2.0};
+    const float inputf[] = {0.0f, 1.0f, -1.0f, 2.0f};
+    const float expected[] = {(float)kernel(0.0), (float)kernel(1.0), (float)kernel(0.0), (float)kernel(1.0)};
+    double output[4];
+    float outputf[4];
+    INTUEasingTableEvaluateBatch(table, input, output, 4);
+    INTUEasingTableEvaluateBatchf(table, inputf, outputf, 4);
+    for (int i = 0; i < 4; i++) {
+        if (INTUEasingTableEvaluate(table, input[i]) != expected[i] || INTUEasingTableEvaluatef(table, inputf[i]) != expected[i] ||
+            output[i] != expected[i] || outputf[i] != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+@interface AnimationEngineEasingTableTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineEasingTableTests
+
+- (void)testEndpointsAreExact
+{
+    const NamedKernel *groups[] = {kSmoothKernels, kOvershootingKernels, kOtherKernels};
+    const size_t counts[] = {sizeof(kSmoothKernels) / sizeof(NamedKernel), sizeof(kOvershootingKernels) / sizeof(NamedKernel), sizeof(kOtherKernels) / sizeof(NamedKernel)};
+    const size_t segmentCounts[] = {1, 7, kINTUEasingTableDefaultSegmentCount};
+    for (size_t g = 0; g < 3; g++) {
+        for (size_t i = 0; i < counts[g]; i++) {
+            for (size_t s = 0; s < 3; s++) {
+                INTUEasingTableRef table = INTUEasingTableCreateWithKernel(groups[g][i].kernel, segmentCounts[s], NULL);
+                XCTAssertTrue(endpointsAreExact(table, groups[g][i].kernel), @"%s with %zu segments", groups[g][i].name, segmentCounts[s]);
+                INTUEasingTableDestroy(table);
+            }
+        }
+    }
+    
+    // Every easing curve starts at exactly 0.0 and ends at exactly 1.0, and so does its table.
+    INTUEasingTableRef table = INTUEasingTableCreateWithKernel(INTUEaseInOutSineKernel, kINTUEasingTableDefaultSegmentCount, NULL);
+    XCTAssertEqual(INTUEasingTableEvaluate(table, 0.0), 0.0);
+    XCTAssertEqual(INTUEasingTableEvaluate(table, 1.0), 1.0);
+    INTUEasingTableDestroy(table);
+    table = INTUEasingTableCreateWithKernel(INTUEaseInOutElasticKernel, kINTUEasingTableDefaultSegmentCount, NULL);
+    XCTAssertEqual(INTUEasingTableEvaluate(table, 0.0), 0.0);
+    XCTAssertEqual(INTUEasingTableEvaluate(table, 1.0), 1.0);
+    INTUEasingTableDestroy(table);
+}
+
+- (void)testDocumentedErrorBounds
+{
+    // The error bounds documented for kINTUEasingTableDefaultSegmentCount, checked both by the error report and independently.
+    for (size_t i = 0; i < sizeof(kSmoothKernels) / sizeof(NamedKernel); i++) {
+        INTUEasingTableError error;
+        INTUEasingTableRef table = INTUEasingTableCreateWithKernel(kSmoothKernels[i].kernel, kINTUEasingTableDefaultSegmentCount, &error);
+        XCTAssertLessThan(error.maximumError, 1e-7, @"%s", kSmoothKernels[i].name);
+        XCTAssertLessThan(maximumError(table, kSmoothKernels[i].kernel), 1e-7, @"%s", kSmoothKernels[i].name);
+        XCTAssertLessThanOrEqual(error.rmsError, error.maximumError);
+        INTUEasingTableDestroy(table);
+    }
+    for (size_t i = 0; i < sizeof(kOvershootingKernels) / sizeof(NamedKernel); i++) {
+        INTUEasingTableError error;
+        INTUEasingTableRef table = INTUEasingTableCreateWithKernel(kOvershootingKernels[i].kernel, kINTUEasingTableDefaultSegmentCount, &error);
+        XCTAssertLessThan(error.maximumError, 4e-4, @"%s", kOvershootingKernels[i].name);
+        XCTAssertLessThan(maximumError(table, kOvershootingKernels[i].kernel), 4e-4, @"%s", kOvershootingKernels[i].name);
+        INTUEasingTableDestroy(table);
+    }
+    
+    // More segments are more accurate.
+    INTUEasingTableError coarse, fine;
+    INTUEasingTableRef coarseTable = INTUEasingTableCreateWithKernel(INTUEaseOutElasticKernel, 32, &coarse);
+    INTUEasingTableRef fineTable = INTUEasingTableCreateWithKernel(INTUEaseOutElasticKernel, 1024, &fine);
+    XCTAssertLessThan(fine.maximumError, coarse.maximumError);
+    INTUEasingTableDestroy(coarseTable);
+    INTUEasingTableDestroy(fineTable);
+}
+
+- (void)testErrorReportIsCloseToDenseSweep
+{
+    // The exponential curves jump at their ends (EaseInExponential is 0.0 at p = 0.0, but 2^-10 just after it), which the table cannot
+    // follow, and the circular and bounce curves have infinite slopes or sharp corners. The report finds their errors to within 1%.
+    for (size_t i = 0; i < sizeof(kOtherKernels) / sizeof(NamedKernel); i++) {
+        INTUEasingTableError error;
+        INTUEasingTableRef table = INTUEasingTableCreateWithKernel(kOtherKernels[i].kernel, kINTUEasingTableDefaultSegmentCount, &error);
+        double dense = denseMaximumError(table, kOtherKernels[i].kernel);
+        XCTAssertGreaterThan(error.maximumError, 0.99 * dense, @"%s", kOtherKernels[i].name);
+        XCTAssertLessThanOrEqual(error.maximumError, dense * (1.0 + 1e-9), @"%s", kOtherKernels[i].name);
+        INTUEasingTableDestroy(table);
+    }
+    INTUEasingTableError error;
+    INTUEasingTableRef table = INTUEasingTableCreateWithKernel(INTUEaseInExponentialKernel, kINTUEasingTableDefaultSegmentCount, &error);
+    XCTAssertEqualWithAccuracy(error.maximumError, pow(2.0, -10.0), 1e-7);
+    XCTAssertLessThan(error.maximumErrorProgress, 1e-6);
+    INTUEasingTableDestroy(table);
+}
+
+- (void)testSinglePrecisionMatchesDoublePrecision
+{
+    INTUEasingTableRef table = INTUEasingTableCreateWithKernel(INTUEaseInOutBackKernel, kINTUEasingTableDefaultSegmentCount, NULL);
+    float input[1001], output[1001];
+    for (int i = 0; i <= 1000; i++) {
+        input[i] = i / 1000.0f;
+    }
+    INTUEasingTableEvaluateBatchf(table, input, output, 1001);
+    for (int i = 0; i <= 1000; i++) {
+        XCTAssertEqualWithAccuracy(output[i], INTUEasingTableEvaluate(table, input[i]), 1e-6);
+        XCTAssertEqual(output[i], INTUEasingTableEvaluatef(table, input[i]));
+    }
+    INTUEasingTableDestroy(table);
+}
+
+- (void)testSamples
+{
+    // Five evenly spaced samples of a monotone curve, baked with a segment count that puts every sample on a segment boundary.
+    const double progress[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+    const double values[] = {0.0, 0.1, 0.6, 0.65, 1.0};
+    INTUEasingTableError error;
+    INTUEasingTableRef table = INTUEasingTableCreateWithSamples(progress, values, 5, 64, &error);
+    XCTAssert(table != NULL);
+    for (int i = 0; i < 5; i++) {
+        XCTAssertEqual(INTUEasingTableEvaluate(table, progress[i]), (float)values[i]);
+    }
+    // The spline does not overshoot the samples, so the table is monotone (to within its error).
+    double previous = 0.0;
+    for (int i = 0; i <= 1000; i++) {
+        double value = INTUEasingTableEvaluate(table, i / 1000.0);
+        XCTAssertGreaterThanOrEqual(value, previous - error.maximumError);
+        previous = value;
+    }
+    INTUEasingTableDestroy(table);
+    
+    // A sample that does not fall on a segment boundary (0.3 * 256 = 76.8) is only matched to within the error of the table.
+    const double unevenProgress[] = {0.1, 0.3, 0.9};
+    const double unevenValues[] = {0.2, 0.8, 0.9};
+    table = INTUEasingTableCreateWithSamples(unevenProgress, unevenValues, 3, kINTUEasingTableDefaultSegmentCount, &error);
+    XCTAssert(table != NULL);
+    XCTAssertEqualWithAccuracy(INTUEasingTableEvaluate(table, 0.3), 0.8, error.maximumError);
+    // Outside of the samples, the curve holds the value of the nearest sample.
+    XCTAssertEqualWithAccuracy(INTUEasingTableEvaluate(table, 0.0), 0.2, 1e-7);
+    XCTAssertEqualWithAccuracy(INTUEasingTableEvaluate(table, 1.0), 0.9, 1e-7);
+    INTUEasingTableDestroy(table);
+}
+
+- (void)testInvalidParameters
+{
+    const double progress[] = {0.0, 0.5, 0.5};
+    const double values[] = {0.0, 0.5, 1.0};
+    XCTAssert(INTUEasingTableCreateWithKernel(NULL, 16, NULL) == NULL);
+    XCTAssert(INTUEasingTableCreateWithKernel(INTULinearKernel, 0, NULL) == NULL);
+    XCTAssert(INTUEasingTableCreateWithSamples(progress, values, 1, 16, NULL) == NULL);
+    // The progress values must be strictly increasing.
+    XCTAssert(INTUEasingTableCreateWithSamples(progress, values, 3, 16, NULL) == NULL);
+    
+    // NaN input evaluates the start of the table rather than reading out of bounds.
+    INTUEasingTableRef table = INTUEasingTableCreateWithKernel(INTULinearKernel, 16, NULL);
+    XCTAssertEqual(INTUEasingTableEvaluate(table, NAN), 0.0);
+    XCTAssertEqual(INTUEasingTableEvaluatef(table, NAN), 0.0f);
+    INTUEasingTableDestroy(table);
+}
+
+@end
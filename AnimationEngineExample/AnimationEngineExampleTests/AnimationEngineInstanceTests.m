@@ -0,0 +1,373 @@
+//
+//  AnimationEngineInstanceTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import "INTUAnimationEngine.h"
+
+#define FRAME_DURATION                              (1.0 / 60.0)
+#define MAXIMUM_PRESENTATION_LEAD                   0.05  // The furthest ahead of the clock that a frame is evaluated (see the header)
+#define PRODUCER_COUNT                              4
+#define ANIMATIONS_PER_PRODUCER                     2000
+
+@interface AnimationEngineInstanceTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineInstanceTests
+
+#pragma mark Independent Engines
+
+- (void)testSeparateAnimationIDs
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *first = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    INTUAnimationEngine *second = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    __block int firstCompletions = 0, secondCompletions = 0;
+    __block BOOL firstFinished = YES, secondFinished = NO;
+    __block CGFloat secondProgress = 0.0;
+    INTUAnimationID firstID = [first animateWithDuration:1.0
+                                                   delay:0.0
+                                              animations:nil
+                                              completion:^(BOOL finished) { firstCompletions++; firstFinished = finished; }];
+    INTUAnimationID secondID = [second animateWithDuration:1.0
+                                                     delay:0.0
+                                                animations:^(CGFloat percentage) { secondProgress = percentage; }
+                                                completion:^(BOOL finished) { secondCompletions++; secondFinished = finished; }];
+    
+    // Each engine numbers its own animations, so the first animation of each has the same ID.
+    XCTAssertEqual(firstID, secondID);
+    
+    // Canceling the ID on one engine leaves the other engine's animation with the same ID running.
+    now = FRAME_DURATION;
+    [first tick];
+    [second tick];
+    [first cancelAnimationWithID:firstID];
+    XCTAssertEqual(firstCompletions, 1);
+    XCTAssertFalse(firstFinished);
+    XCTAssertEqual(secondCompletions, 0);
+    
+    // Canceling an ID that is no longer (or was never) active does nothing.
+    [first cancelAnimationWithID:firstID];
+    [second cancelAnimationWithID:secondID + 1];
+    XCTAssertEqual(firstCompletions, 1);
+    XCTAssertEqual(secondCompletions, 0);
+    
+    for (int frame = 2; frame <= 61; frame++) {
+        now = frame * FRAME_DURATION;
+        [first tick];
+        [second tick];
+    }
+    XCTAssertEqual(firstCompletions, 1);
+    XCTAssertEqual(secondCompletions, 1);
+    XCTAssertTrue(secondFinished);
+    XCTAssertEqual(secondProgress, (CGFloat)1.0);
+    
+    // The next animation on the first engine gets the next ID of that engine, whatever the second engine has used.
+    [second animateWithDuration:1.0 delay:0.0 animations:nil completion:nil];
+    [second animateWithDuration:1.0 delay:0.0 animations:nil completion:nil];
+    XCTAssertEqual([first animateWithDuration:1.0 delay:0.0 animations:nil completion:nil], firstID + 1);
+}
+
+#pragma mark Command Queue
+
+- (void)testConcurrentProducers
+{
+    // The clock never advances, so no animation finishes by itself.
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return 0.0; }];
+    INTUAnimationID *animationIDs = calloc(PRODUCER_COUNT * ANIMATIONS_PER_PRODUCER, sizeof(INTUAnimationID));
+    int *executionCounts = calloc(PRODUCER_COUNT * ANIMATIONS_PER_PRODUCER, sizeof(int));
+    // The index of each animation of each producer that completes, in the order they complete (or -1 if one finishes instead).
+    NSMutableArray *completions = [NSMutableArray array];
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        [completions addObject:[NSMutableArray array]];
+    }
+    
+    // Each producer starts animations from its own thread, canceling every other one right after starting it, while this thread (the
+    // engine's thread) ticks the engine. Commands from one thread are applied in the order they were submitted, so every cancel finds its
+    // animation already started, and the canceled animations complete in the order they were started.
+    dispatch_group_t group = dispatch_group_create();
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        NSMutableArray *producerCompletions = completions[p];
+        dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            for (int i = 0; i < ANIMATIONS_PER_PRODUCER; i++) {
+                size_t index = p * ANIMATIONS_PER_PRODUCER + i;
+                animationIDs[index] = [engine animateWithDuration:1.0
+                                                            delay:0.0
+                                                       animations:^(CGFloat percentage) { executionCounts[index]++; }
+                                                       completion:^(BOOL finished) { [producerCompletions addObject:@(finished ? -1 : i)]; }];
+                if (i % 2 == 1) {
+                    [engine cancelAnimationWithID:animationIDs[index]];
+                }
+            }
+        });
+    }
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0) {
+        [engine tick];
+    }
+    // Apply the commands submitted since the last tick.
+    [engine tick];
+    
+    NSMutableSet *uniqueIDs = [NSMutableSet set];
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        NSArray *producerCompletions = completions[p];
+        XCTAssertEqual([producerCompletions count], (NSUInteger)(ANIMATIONS_PER_PRODUCER / 2));
+        for (NSUInteger k = 0; k < [producerCompletions count]; k++) {
+            XCTAssertEqual([producerCompletions[k] intValue], (int)(2 * k + 1), @"producer %d", p);
+        }
+        for (int i = 0; i < ANIMATIONS_PER_PRODUCER; i++) {
+            size_t index = p * ANIMATIONS_PER_PRODUCER + i;
+            [uniqueIDs addObject:@(animationIDs[index])];
+            // Canceled animations never run; the others have all been started, and have run on every tick since.
+            if (i % 2 == 1) {
+                XCTAssertEqual(executionCounts[index], 0, @"producer %d animation %d", p, i);
+            } else {
+                XCTAssertGreaterThan(executionCounts[index], 0, @"producer %d animation %d", p, i);
+            }
+        }
+    }
+    XCTAssertEqual([uniqueIDs count], (NSUInteger)(PRODUCER_COUNT * ANIMATIONS_PER_PRODUCER));
+    
+    // On the engine's thread, cancels are applied immediately, and leave nothing running.
+    for (int p = 0; p < PRODUCER_COUNT; p++) {
+        for (int i = 0; i < ANIMATIONS_PER_PRODUCER; i += 2) {
+            [engine cancelAnimationWithID:animationIDs[p * ANIMATIONS_PER_PRODUCER + i]];
+        }
+        XCTAssertEqual([completions[p] count], (NSUInteger)ANIMATIONS_PER_PRODUCER);
+        XCTAssertEqual([[completions[p] lastObject] intValue], ANIMATIONS_PER_PRODUCER - 2);
+    }
+    int executionCount = executionCounts[0];
+    [engine tick];
+    XCTAssertEqual(executionCounts[0], executionCount);
+    
+    free(animationIDs);
+    free(executionCounts);
+}
+
+#pragma mark Output Quantum
+
+- (void)testOutputQuantumSkipsSmallChangesAndDeliversTheFinalOutput
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    // A linear animation that advances by 1/60 each frame, with a quantum of 0.14, so it is delivered every ninth frame (0.0, 0.15 ... 0.9).
+    // The last frame (1.0) is within the quantum of 0.9, but is delivered anyway because the animation finishes.
+    NSMutableArray *delivered = [NSMutableArray array];
+    __block BOOL completed = NO;
+    INTUAnimationID animationID = [engine animateWithDuration:1.0
+                                                        delay:0.0
+                                                   animations:^(CGFloat percentage) { [delivered addObject:@(percentage)]; }
+                                                   completion:^(BOOL finished) {
+                                                       XCTAssertTrue(finished);
+                                                       XCTAssertEqual([[delivered lastObject] doubleValue], 1.0);
+                                                       completed = YES;
+                                                   }];
+    [engine setOutputQuantum:0.14 forAnimationWithID:animationID];
+    
+    // The same animation bound to the output buffer, from 0 to 100.
+    const CGFloat fromValue = 0.0, toValue = 100.0;
+    INTUAnimationID boundID = [engine animateWithDuration:1.0
+                                                    delay:0.0
+                                                   easing:nil
+                                                  options:INTUAnimationOptionNone
+                                               fromValues:&fromValue
+                                                 toValues:&toValue
+                                             channelCount:1
+                                               completion:nil];
+    [engine setOutputQuantum:0.14 forAnimationWithID:boundID];
+    NSUInteger boundOffset = [engine outputOffsetForAnimationID:boundID];
+    NSMutableArray *bufferValues = [NSMutableArray array];
+    [engine setOutputHandler:^(const CGFloat *outputBuffer, NSRange dirtyRange) {
+        if (NSLocationInRange(boundOffset, dirtyRange)) {
+            [bufferValues addObject:@(outputBuffer[boundOffset])];
+        }
+    }];
+    
+    for (int frame = 0; frame <= 60; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+        BOOL deliveredThisFrame = (frame % 9 == 0 || frame == 60);
+        XCTAssertEqual([engine elidedCallbackCount], deliveredThisFrame ? (NSUInteger)0 : (NSUInteger)2, @"frame %d", frame);
+    }
+    XCTAssertTrue(completed);
+    XCTAssertEqual([delivered count], (NSUInteger)8);
+    for (NSUInteger i = 1; i + 1 < [delivered count]; i++) {
+        XCTAssertGreaterThanOrEqual([delivered[i] doubleValue] - [delivered[i - 1] doubleValue], 0.14);
+    }
+    XCTAssertEqualWithAccuracy([delivered[6] doubleValue], 0.9, 1e-9);
+    XCTAssertEqual([bufferValues count], (NSUInteger)8);
+    XCTAssertEqual([[bufferValues lastObject] doubleValue], 100.0);
+}
+
+- (void)testOutputQuantumDeliversTheLastSkippedOutputOnCancel
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    __block CGFloat lastPercentage = NAN;
+    __block NSUInteger deliveredCount = 0;
+    __block BOOL canceled = NO;
+    INTUAnimationID animationID = [engine animateWithDuration:1.0
+                                                        delay:0.0
+                                                   animations:^(CGFloat percentage) { lastPercentage = percentage; deliveredCount++; }
+                                                   completion:^(BOOL finished) {
+                                                       XCTAssertFalse(finished);
+                                                       // The skipped output is delivered before the completion block.
+                                                       XCTAssertEqualWithAccuracy(lastPercentage, 50 * FRAME_DURATION, 1e-9);
+                                                       canceled = YES;
+                                                   }];
+    [engine setOutputQuantum:0.14 forAnimationWithID:animationID];
+    for (int frame = 0; frame <= 50; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+    }
+    // Frames 46 to 50 were within the quantum of the output delivered at frame 45.
+    XCTAssertEqual(deliveredCount, (NSUInteger)6);
+    XCTAssertEqualWithAccuracy(lastPercentage, 45 * FRAME_DURATION, 1e-9);
+    
+    [engine cancelAnimationWithID:animationID];
+    XCTAssertTrue(canceled);
+    XCTAssertEqual(deliveredCount, (NSUInteger)7);
+    
+    // An animation canceled right after its output was delivered is not delivered again.
+    deliveredCount = 0;
+    canceled = NO;
+    animationID = [engine animateWithDuration:1.0
+                                        delay:0.0
+                                   animations:^(CGFloat percentage) { deliveredCount++; }
+                                   completion:^(BOOL finished) { canceled = YES; }];
+    [engine setOutputQuantum:0.14 forAnimationWithID:animationID];
+    now += FRAME_DURATION;
+    [engine tick];
+    [engine cancelAnimationWithID:animationID];
+    XCTAssertTrue(canceled);
+    XCTAssertEqual(deliveredCount, (NSUInteger)1);
+}
+
+#pragma mark Presentation Time
+
+- (void)testPresentationTimeLeadIsLimited
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    [engine setTargetsPresentationTime:YES];
+    // A linear animation lasting one second, so its percentage is the time it was evaluated at.
+    __block CGFloat percentage = NAN;
+    [engine animateWithDuration:1.0 delay:0.0 animations:^(CGFloat p) { percentage = p; } completion:nil];
+    
+    // A prediction within the limit is followed exactly.
+    now = 0.1;
+    [engine tickWithPresentationTime:0.12];
+    XCTAssertEqualWithAccuracy(percentage, 0.12, 1e-12);
+    
+    // A prediction further ahead than the limit (for example, a stale one after a stall) is clamped to it.
+    now = 0.2;
+    [engine tickWithPresentationTime:0.5];
+    XCTAssertEqualWithAccuracy(percentage, 0.2 + MAXIMUM_PRESENTATION_LEAD, 1e-12);
+    
+    // A prediction behind the clock is not followed either; the frame is evaluated at the current time.
+    now = 0.3;
+    [engine tickWithPresentationTime:0.28];
+    XCTAssertEqualWithAccuracy(percentage, 0.3, 1e-12);
+}
+
+- (void)testPresentationTimeIsHeldUntilTheClockCatchesUp
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    [engine setTargetsPresentationTime:YES];
+    __block CGFloat percentage = NAN;
+    [engine animateWithDuration:1.0 delay:0.0 animations:^(CGFloat p) { percentage = p; } completion:nil];
+    
+    now = 0.1;
+    [engine tickWithPresentationTime:0.14];
+    XCTAssertEqualWithAccuracy(percentage, 0.14, 1e-12);
+    
+    // The next frame comes early, with an earlier prediction: time is held at the last prediction rather than going back.
+    now = 0.11;
+    [engine tickWithPresentationTime:0.12];
+    XCTAssertEqualWithAccuracy(percentage, 0.14, 1e-12);
+    
+    // A frame without a prediction (or with targeting turned off) is also held until the clock passes the last prediction.
+    now = 0.13;
+    [engine tick];
+    XCTAssertEqualWithAccuracy(percentage, 0.14, 1e-12);
+    [engine setTargetsPresentationTime:NO];
+    now = 0.135;
+    [engine tickWithPresentationTime:0.15];
+    XCTAssertEqualWithAccuracy(percentage, 0.14, 1e-12);
+    
+    // Once the clock has passed it, the hold is released, and (with targeting off) frames follow the clock.
+    now = 0.16;
+    [engine tickWithPresentationTime:0.18];
+    XCTAssertEqualWithAccuracy(percentage, 0.16, 1e-12);
+    now = 0.17;
+    [engine tickWithPresentationTime:0.19];
+    XCTAssertEqualWithAccuracy(percentage, 0.17, 1e-12);
+}
+
+- (void)testPresentationLag
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    
+    // Without targeting, every frame trails its predicted presentation time by one refresh. Frames without a prediction are not recorded.
+    for (int frame = 1; frame <= 100; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tickWithPresentationTime:now + FRAME_DURATION];
+        [engine tick];
+    }
+    INTUAnimationLatencySummary summary = [engine presentationLagSummary];
+    XCTAssertEqual(summary.count, (uint64_t)100);
+    XCTAssertEqualWithAccuracy(summary.mean, FRAME_DURATION, 1e-9);
+    XCTAssertEqualWithAccuracy(summary.minimum, FRAME_DURATION, 1e-9);
+    XCTAssertEqualWithAccuracy(summary.maximum, FRAME_DURATION, 1e-9);
+    XCTAssertEqualWithAccuracy(summary.median, FRAME_DURATION, kINTUAnimationLatencyHistogramBucketWidth);
+    XCTAssertEqualWithAccuracy(summary.percentile99, FRAME_DURATION, kINTUAnimationLatencyHistogramBucketWidth);
+    
+    // With targeting, the lag is zero, except for a frame clamped to the limit (which trails by the rest of its prediction) and a frame
+    // held behind an earlier prediction (which is evaluated after its own, so its lag is negative).
+    [engine resetPresentationLag];
+    XCTAssertEqual([engine presentationLagSummary].count, (uint64_t)0);
+    [engine setTargetsPresentationTime:YES];
+    for (int frame = 101; frame <= 197; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tickWithPresentationTime:now + FRAME_DURATION];
+    }
+    now = 198 * FRAME_DURATION;
+    [engine tickWithPresentationTime:now + 0.08];
+    now = 199 * FRAME_DURATION;
+    [engine tickWithPresentationTime:now + 0.01];
+    now = 200 * FRAME_DURATION + 0.05;
+    [engine tickWithPresentationTime:now + FRAME_DURATION];
+    summary = [engine presentationLagSummary];
+    XCTAssertEqual(summary.count, (uint64_t)100);
+    XCTAssertEqualWithAccuracy(summary.maximum, 0.08 - MAXIMUM_PRESENTATION_LEAD, 1e-9);
+    XCTAssertEqualWithAccuracy(summary.minimum, (199 * FRAME_DURATION + 0.01) - (198 * FRAME_DURATION + MAXIMUM_PRESENTATION_LEAD), 1e-9);
+    XCTAssertEqualWithAccuracy(summary.median, 0.0, kINTUAnimationLatencyHistogramBucketWidth);
+    XCTAssertEqualWithAccuracy(summary.percentile90, 0.0, kINTUAnimationLatencyHistogramBucketWidth);
+}
+
+@end
@@ -98,6 +98,48 @@
     XCTAssert(ROUNDED_EQUALS(INTUInterpolateCGFloat(50.0, 100.0, 1.2), 110.0));
 }
 
+- (void)testInterpolateCGAffineTransform
+{
+    CGAffineTransform start = CGAffineTransformMakeTranslation(10.0, 20.0);
+    CGAffineTransform end = CGAffineTransformScale(CGAffineTransformMakeRotation(M_PI_2), 3.0, 3.0);
+    XCTAssert(CGAffineTransformEqualToTransform(INTUInterpolateCGAffineTransform(start, end, 0.0), start));
+    
+    // Halfway, the transform should be rotated by 45 degrees and scaled by 2 (with no shear), not a lerp of the matrix elements.
+    CGAffineTransform halfway = INTUInterpolateCGAffineTransform(start, end, 0.5);
+    CGAffineTransform expected = CGAffineTransformScale(CGAffineTransformMakeRotation(M_PI_4), 2.0, 2.0);
+    XCTAssert(ROUNDED_EQUALS(halfway.a, expected.a) && ROUNDED_EQUALS(halfway.b, expected.b));
+    XCTAssert(ROUNDED_EQUALS(halfway.c, expected.c) && ROUNDED_EQUALS(halfway.d, expected.d));
+    XCTAssert(ROUNDED_EQUALS(halfway.tx, 5.0) && ROUNDED_EQUALS(halfway.ty, 10.0));
+    
+    CGAffineTransform final = INTUInterpolateCGAffineTransform(start, end, 1.0);
+    XCTAssert(ROUNDED_EQUALS(final.a, end.a) && ROUNDED_EQUALS(final.b, end.b) && ROUNDED_EQUALS(final.c, end.c) && ROUNDED_EQUALS(final.d, end.d));
+    
+    // Rotating from 170 to -170 degrees should take the short way around, through 180 degrees.
+    halfway = INTUInterpolateCGAffineTransform(CGAffineTransformMakeRotation(170.0 * M_PI / 180.0), CGAffineTransformMakeRotation(-170.0 * M_PI / 180.0), 0.5);
+    XCTAssert(ROUNDED_EQUALS(halfway.a, -1.0) && ROUNDED_EQUALS(halfway.b, 0.0));
+}
+
+- (void)testInterpolateCATransform3D
+{
+    CATransform3D start = CATransform3DIdentity;
+    CATransform3D end = CATransform3DScale(CATransform3DMakeRotation(M_PI_2, 0.0, 1.0, 0.0), 3.0, 3.0, 3.0);
+    CATransform3D halfway = INTUInterpolateCATransform3D(start, end, 0.5);
+    CATransform3D expected = CATransform3DScale(CATransform3DMakeRotation(M_PI_4, 0.0, 1.0, 0.0), 2.0, 2.0, 2.0);
+    XCTAssert(ROUNDED_EQUALS(halfway.m11, expected.m11) && ROUNDED_EQUALS(halfway.m13, expected.m13));
+    XCTAssert(ROUNDED_EQUALS(halfway.m22, expected.m22));
+    XCTAssert(ROUNDED_EQUALS(halfway.m31, expected.m31) && ROUNDED_EQUALS(halfway.m33, expected.m33));
+    
+    // Perspective is preserved.
+    CATransform3D perspective = CATransform3DIdentity;
+    perspective.m34 = -1.0 / 500.0;
+    halfway = INTUInterpolateCATransform3D(perspective, CATransform3DRotate(perspective, M_PI_2, 1.0, 0.0, 0.0), 0.5);
+    XCTAssert(ROUNDED_EQUALS(halfway.m44, 1.0) && fabs(halfway.m24) > 0.0);
+    
+    // Singular transforms can't be decomposed, so their matrix elements are interpolated directly.
+    halfway = INTUInterpolateCATransform3D(CATransform3DMakeScale(0.0, 0.0, 0.0), CATransform3DIdentity, 0.5);
+    XCTAssert(ROUNDED_EQUALS(halfway.m11, 0.5));
+}
+
 - (void)testInterpolate
 {
     XCTAssertEqualObjects(INTUInterpolate(@(10), @(20), -0.5), @(5));
@@ -109,6 +151,9 @@
     XCTAssertEqualObjects(INTUInterpolate(@(-4.5), @(2.5), 0.0), @(-4.5));
     XCTAssertEqualObjects(INTUInterpolate(@(-4.5), @(2.5), 0.5), @(-1.0));
     XCTAssertEqualObjects(INTUInterpolate(@(-4.5), @(2.5), 1.0), @(2.5));
+    
+    NSValue *transform = INTUInterpolate([NSValue valueWithCGAffineTransform:CGAffineTransformIdentity], [NSValue valueWithCGAffineTransform:CGAffineTransformMakeRotation(M_PI_2)], 0.5);
+    XCTAssert(ROUNDED_EQUALS([transform CGAffineTransformValue].b, sin(M_PI_4)));
 }
 
 @end
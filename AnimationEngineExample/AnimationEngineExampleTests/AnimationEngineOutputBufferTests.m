@@ -0,0 +1,194 @@
+//
+//  AnimationEngineOutputBufferTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include "INTUAnimationOutputBuffer.h"
+#include <stdint.h>
+
+@interface AnimationEngineOutputBufferTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineOutputBufferTests
+
+- (void)testAllocateIsContiguous
+{
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 0), (size_t)SIZE_MAX);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 2), (size_t)0);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 1), (size_t)2);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 4), (size_t)3);
+    XCTAssertEqual(buffer.length, (size_t)7);
+    
+    // Growing past the initial capacity keeps every slot contiguous.
+    for (size_t i = 0; i < 100; i++) {
+        XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 3), 7 + 3 * i);
+    }
+    XCTAssertGreaterThan(buffer.capacity, (size_t)300);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+- (void)testFreedSlotIsReused
+{
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    size_t a = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    size_t b = INTUAnimationOutputBufferAllocate(&buffer, 4);
+    size_t c = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    
+    INTUAnimationOutputBufferFree(&buffer, b, 4);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)1);
+    XCTAssertEqual(buffer.length, (size_t)8);
+    
+    // A smaller slot is split off the start of the free range, and the remainder is left free.
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 1), b);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 3), b + 1);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    
+    // A slot that does not fit in any free range is appended.
+    INTUAnimationOutputBufferFree(&buffer, a, 2);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 3), c + 2);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 2), a);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+- (void)testFreedRangesAreSortedAndMerged
+{
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    size_t slots[6];
+    for (size_t i = 0; i < 6; i++) {
+        slots[i] = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    }
+    
+    // Freed out of order, the ranges are still sorted by offset.
+    INTUAnimationOutputBufferFree(&buffer, slots[3], 2);
+    INTUAnimationOutputBufferFree(&buffer, slots[1], 2);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)2);
+    XCTAssertEqual(buffer.freeRanges[0], slots[1]);
+    XCTAssertEqual(buffer.freeRanges[2], slots[3]);
+    
+    // Freeing the slot between them merges all three into one range.
+    INTUAnimationOutputBufferFree(&buffer, slots[2], 2);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)1);
+    XCTAssertEqual(buffer.freeRanges[0], slots[1]);
+    XCTAssertEqual(buffer.freeRanges[1], (size_t)6);
+    
+    // Freeing a slot just below or just above a range extends it.
+    INTUAnimationOutputBufferFree(&buffer, slots[0], 2);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)1);
+    XCTAssertEqual(buffer.freeRanges[0], slots[0]);
+    XCTAssertEqual(buffer.freeRanges[1], (size_t)8);
+    
+    // The merged range can hold a slot larger than any of the slots that were freed.
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 8), slots[0]);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    XCTAssertEqual(buffer.length, (size_t)12);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+- (void)testFreeingLastSlotShrinksBuffer
+{
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    size_t a = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    size_t b = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    size_t c = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    
+    INTUAnimationOutputBufferFree(&buffer, c, 2);
+    XCTAssertEqual(buffer.length, c);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    
+    // Freeing the new last slot also releases the free range below it, leaving the buffer empty.
+    INTUAnimationOutputBufferFree(&buffer, a, 2);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)1);
+    INTUAnimationOutputBufferFree(&buffer, b, 2);
+    XCTAssertEqual(buffer.length, (size_t)0);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    
+    // Slots past the end of the buffer, or empty slots, are ignored.
+    INTUAnimationOutputBufferFree(&buffer, 0, 2);
+    INTUAnimationOutputBufferFree(&buffer, 0, 0);
+    XCTAssertEqual(buffer.length, (size_t)0);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    XCTAssertEqual(INTUAnimationOutputBufferAllocate(&buffer, 2), (size_t)0);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+- (void)testManyFreesDoNotFragment
+{
+    // Freeing every other slot and then the rest, in a scattered order, must leave nothing but an empty buffer.
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    const size_t count = 64;
+    size_t slots[64];
+    for (size_t i = 0; i < count; i++) {
+        slots[i] = INTUAnimationOutputBufferAllocate(&buffer, 1 + i % 3);
+    }
+    for (size_t i = 0; i < count; i += 2) {
+        INTUAnimationOutputBufferFree(&buffer, slots[i], 1 + i % 3);
+    }
+    XCTAssertEqual(buffer.freeRangeCount, count / 2);
+    for (size_t i = 0; i < count / 2; i++) {
+        XCTAssertEqual(buffer.freeRanges[2 * i], slots[2 * i]);
+    }
+    for (size_t i = 0; i < count; i += 2) {
+        size_t j = (i * 37 + 1) % count; // visits every odd slot once
+        INTUAnimationOutputBufferFree(&buffer, slots[j], 1 + j % 3);
+    }
+    XCTAssertEqual(buffer.length, (size_t)0);
+    XCTAssertEqual(buffer.freeRangeCount, (size_t)0);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+- (void)testUpdateWritesDirtyRange
+{
+    INTUAnimationOutputBuffer buffer;
+    INTUAnimationOutputBufferInit(&buffer);
+    size_t a = INTUAnimationOutputBufferAllocate(&buffer, 2);
+    size_t b = INTUAnimationOutputBufferAllocate(&buffer, 1);
+    const CGFloat startA[] = {0.0, 10.0}, endA[] = {100.0, 20.0};
+    const CGFloat startB[] = {-1.0}, endB[] = {1.0};
+    INTUAnimationOutputBufferSetValues(&buffer, a, 2, startA, endA);
+    INTUAnimationOutputBufferSetValues(&buffer, b, 1, startB, endB);
+    size_t dirtyOffset = 0, dirtyLength = 0;
+    XCTAssertTrue(INTUAnimationOutputBufferUpdate(&buffer, &dirtyOffset, &dirtyLength));
+    XCTAssertEqual(dirtyOffset, (size_t)0);
+    XCTAssertEqual(dirtyLength, (size_t)3);
+    XCTAssertFalse(INTUAnimationOutputBufferUpdate(&buffer, &dirtyOffset, &dirtyLength));
+    
+    INTUAnimationOutputBufferSetProgress(&buffer, b, 1, 0.75);
+    XCTAssertTrue(INTUAnimationOutputBufferUpdate(&buffer, &dirtyOffset, &dirtyLength));
+    XCTAssertEqual(dirtyOffset, b);
+    XCTAssertEqual(dirtyLength, (size_t)1);
+    XCTAssertEqualWithAccuracy(buffer.values[a], 0.0, 1e-9);
+    XCTAssertEqualWithAccuracy(buffer.values[a + 1], 10.0, 1e-9);
+    XCTAssertEqualWithAccuracy(buffer.values[b], 0.5, 1e-9);
+    INTUAnimationOutputBufferDestroy(&buffer);
+}
+
+@end
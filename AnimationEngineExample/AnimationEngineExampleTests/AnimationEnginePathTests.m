@@ -0,0 +1,222 @@
+//
+//  AnimationEnginePathTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include "INTUPath.h"
+
+#define EPSILON                                     0.001  // the allowable delta between the expected result and the actual result
+#define KAPPA                                       0.5522847498307936  // the control point distance of a cubic quarter circle of radius 1
+
+/** Adds a circle of the given radius centered on the origin, the same way as CGPathAddEllipseInRect(): four counterclockwise cubic arcs starting at (radius, 0), then a close. */
+static void addCircle(INTUPathRef path, CGFloat radius)
+{
+    const CGFloat k = KAPPA * radius;
+    INTUPathMoveToPoint(path, (CGPoint){radius, 0.0});
+    INTUPathAddCurveToPoint(path, (CGPoint){radius, k}, (CGPoint){k, radius}, (CGPoint){0.0, radius});
+    INTUPathAddCurveToPoint(path, (CGPoint){-k, radius}, (CGPoint){-radius, k}, (CGPoint){-radius, 0.0});
+    INTUPathAddCurveToPoint(path, (CGPoint){-radius, -k}, (CGPoint){-k, -radius}, (CGPoint){0.0, -radius});
+    INTUPathAddCurveToPoint(path, (CGPoint){k, -radius}, (CGPoint){radius, -k}, (CGPoint){radius, 0.0});
+    INTUPathCloseSubpath(path);
+}
+
+/** Returns the difference between two angles, wrapped to the range -pi to pi. */
+static double angleDifference(double a, double b)
+{
+    return remainder(a - b, 2.0 * M_PI);
+}
+
+@interface AnimationEnginePathTests : XCTestCase
+
+@end
+
+@implementation AnimationEnginePathTests
+
+- (void)testConstantSpeed
+{
+    // A curve whose control points bunch up near its start, so that its bezier parameter moves very unevenly along it.
+    INTUPathRef path = INTUPathCreate();
+    INTUPathAddCurveToPoint(path, (CGPoint){5.0, 0.0}, (CGPoint){10.0, 0.0}, (CGPoint){300.0, 200.0});
+    const CGFloat length = INTUPathGetLength(path);
+    XCTAssertGreaterThan(length, 300.0);
+    
+    CGPoint previous;
+    CGFloat angle;
+    INTUPathEvaluate(path, 0.0, &previous, &angle);
+    XCTAssertEqualWithAccuracy(previous.x, 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(previous.y, 0.0, EPSILON);
+    for (int i = 1; i <= 200; i++) {
+        CGPoint position;
+        INTUPathEvaluate(path, i / 200.0, &position, &angle);
+        // Equal steps of progress move (nearly) equal distances along the curve.
+        XCTAssertEqualWithAccuracy(hypot(position.x - previous.x, position.y - previous.y), length / 200.0, 0.01 * length / 200.0);
+        previous = position;
+    }
+    XCTAssertEqualWithAccuracy(previous.x, 300.0, EPSILON);
+    XCTAssertEqualWithAccuracy(previous.y, 200.0, EPSILON);
+    
+    // The batch evaluation matches the single evaluation.
+    CGFloat progress[] = {0.9, 0.1, 0.5, 0.5, 1.0};
+    CGPoint positions[5];
+    CGFloat angles[5];
+    INTUPathEvaluateBatch(path, progress, positions, angles, 5);
+    for (int i = 0; i < 5; i++) {
+        CGPoint position;
+        INTUPathEvaluate(path, progress[i], &position, &angle);
+        XCTAssertEqual(positions[i].x, position.x);
+        XCTAssertEqual(positions[i].y, position.y);
+        XCTAssertEqual(angles[i], angle);
+    }
+    INTUPathDestroy(path);
+}
+
+- (void)testClosedOvalEndAngle
+{
+    // Closing a subpath that already ends at its start adds no segment, so the end of the circle still faces along the circle.
+    INTUPathRef path = INTUPathCreate();
+    addCircle(path, 100.0);
+    XCTAssertEqual(INTUPathGetSegmentCount(path), (size_t)4);
+    XCTAssertEqualWithAccuracy(INTUPathGetLength(path), 2.0 * M_PI * 100.0, 0.1);
+    
+    CGPoint position;
+    CGFloat angle, almostEndAngle;
+    INTUPathEvaluate(path, 0.0, &position, &angle);
+    XCTAssertEqualWithAccuracy(angleDifference(angle, M_PI_2), 0.0, EPSILON);
+    INTUPathEvaluate(path, 0.9999999, &position, &almostEndAngle);
+    INTUPathEvaluate(path, 1.0, &position, &angle);
+    XCTAssertEqualWithAccuracy(angleDifference(almostEndAngle, M_PI_2), 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(angleDifference(angle, M_PI_2), 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.x, 100.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, 0.0, EPSILON);
+    
+    // Around the circle, the angle is always perpendicular to the radius.
+    for (int i = 0; i <= 100; i++) {
+        INTUPathEvaluate(path, i / 100.0, &position, &angle);
+        XCTAssertEqualWithAccuracy(hypot(position.x, position.y), 100.0, 0.05);
+        XCTAssertEqualWithAccuracy(angleDifference(angle, atan2(position.y, position.x) + M_PI_2), 0.0, 0.01);
+    }
+    INTUPathDestroy(path);
+    
+    // Closing a subpath that does not end at its start adds a line back to the start.
+    path = INTUPathCreate();
+    INTUPathMoveToPoint(path, (CGPoint){0.0, 0.0});
+    INTUPathAddLineToPoint(path, (CGPoint){30.0, 0.0});
+    INTUPathAddLineToPoint(path, (CGPoint){30.0, 40.0});
+    XCTAssertTrue(INTUPathCloseSubpath(path));
+    XCTAssertEqual(INTUPathGetSegmentCount(path), (size_t)3);
+    XCTAssertEqualWithAccuracy(INTUPathGetLength(path), 120.0, EPSILON);
+    INTUPathEvaluate(path, 1.0, &position, &angle);
+    XCTAssertEqualWithAccuracy(angle, atan2(-40.0, -30.0), EPSILON);
+    INTUPathDestroy(path);
+}
+
+- (void)testOvershootDirection
+{
+    // Beyond the end of the circle, the path continues straight along the tangent at its end: up from (100, 0).
+    INTUPathRef path = INTUPathCreate();
+    addCircle(path, 100.0);
+    const CGFloat length = INTUPathGetLength(path);
+    CGPoint position;
+    CGFloat angle;
+    INTUPathEvaluate(path, 1.05, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 100.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, 0.05 * length, EPSILON);
+    XCTAssertEqualWithAccuracy(angleDifference(angle, M_PI_2), 0.0, EPSILON);
+    
+    // Before the start, it continues backwards along the tangent at the start: down from (100, 0).
+    INTUPathEvaluate(path, -0.05, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 100.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, -0.05 * length, EPSILON);
+    XCTAssertEqualWithAccuracy(angleDifference(angle, M_PI_2), 0.0, EPSILON);
+    INTUPathDestroy(path);
+    
+    // Zero length segments at either end (here, a redundant line at the start and end) do not change the direction of the overshoot.
+    path = INTUPathCreate();
+    INTUPathMoveToPoint(path, (CGPoint){10.0, 10.0});
+    INTUPathAddLineToPoint(path, (CGPoint){10.0, 10.0});
+    INTUPathAddLineToPoint(path, (CGPoint){10.0, 50.0});
+    INTUPathAddLineToPoint(path, (CGPoint){10.0, 50.0});
+    INTUPathEvaluate(path, 1.5, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 10.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, 70.0, EPSILON);
+    XCTAssertEqualWithAccuracy(angle, M_PI_2, EPSILON);
+    INTUPathEvaluate(path, -0.5, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 10.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, -10.0, EPSILON);
+    XCTAssertEqualWithAccuracy(angle, M_PI_2, EPSILON);
+    INTUPathDestroy(path);
+}
+
+- (void)testMultipleSubpaths
+{
+    // Two separate lines; the jump between the subpaths takes no time, so each line takes half of the progress.
+    INTUPathRef path = INTUPathCreate();
+    INTUPathMoveToPoint(path, (CGPoint){0.0, 0.0});
+    INTUPathAddLineToPoint(path, (CGPoint){100.0, 0.0});
+    INTUPathMoveToPoint(path, (CGPoint){0.0, 500.0});
+    INTUPathAddLineToPoint(path, (CGPoint){0.0, 600.0});
+    XCTAssertEqual(INTUPathGetSegmentCount(path), (size_t)2);
+    XCTAssertEqualWithAccuracy(INTUPathGetLength(path), 200.0, EPSILON);
+    
+    CGPoint position;
+    CGFloat angle;
+    INTUPathEvaluate(path, 0.25, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 50.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(angle, 0.0, EPSILON);
+    INTUPathEvaluate(path, 0.75, &position, &angle);
+    XCTAssertEqualWithAccuracy(position.x, 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(position.y, 550.0, EPSILON);
+    XCTAssertEqualWithAccuracy(angle, M_PI_2, EPSILON);
+    
+    // Closing the second subpath returns to its own start, not the start of the path.
+    XCTAssertTrue(INTUPathCloseSubpath(path));
+    XCTAssertEqual(INTUPathGetSegmentCount(path), (size_t)3);
+    CGPoint points[4];
+    INTUPathGetSegment(path, 2, points);
+    XCTAssertEqualWithAccuracy(points[3].x, 0.0, EPSILON);
+    XCTAssertEqualWithAccuracy(points[3].y, 500.0, EPSILON);
+    XCTAssertEqualWithAccuracy(INTUPathGetLength(path), 300.0, EPSILON);
+    INTUPathDestroy(path);
+}
+
+- (void)testEmptyPath
+{
+    INTUPathRef path = INTUPathCreate();
+    XCTAssertEqual(INTUPathGetLength(path), 0.0);
+    // Closing an empty subpath adds nothing.
+    XCTAssertTrue(INTUPathCloseSubpath(path));
+    XCTAssertEqual(INTUPathGetSegmentCount(path), (size_t)0);
+    INTUPathMoveToPoint(path, (CGPoint){3.0, 4.0});
+    CGPoint position;
+    CGFloat angle;
+    INTUPathEvaluate(path, 0.5, &position, &angle);
+    XCTAssertEqual(position.x, 3.0);
+    XCTAssertEqual(position.y, 4.0);
+    XCTAssertEqual(angle, 0.0);
+    INTUPathDestroy(path);
+}
+
+@end
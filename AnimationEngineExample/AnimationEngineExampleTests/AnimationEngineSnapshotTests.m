@@ -0,0 +1,254 @@
+//
+//  AnimationEngineSnapshotTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import "INTUAnimationEngine.h"
+
+#define FRAME_DURATION                              (1.0 / 60.0)
+#define FRAMES_BEFORE_SNAPSHOT                      30
+#define FRAMES_AFTER_SNAPSHOT                       120
+
+// The offset of the version in the snapshot header, which follows the 32-bit magic number.
+#define SNAPSHOT_VERSION_OFFSET                     4
+
+typedef void (^ProgressBlock)(CGFloat progress);
+typedef void (^PathBlock)(CGPoint position, CGFloat angle);
+typedef void (^CompletionBlock)(BOOL finished);
+
+static ProgressBlock progressLogger(NSMutableArray *log)
+{
+    return ^(CGFloat progress) { [log addObject:@(progress)]; };
+}
+
+static PathBlock pathLogger(NSMutableArray *log)
+{
+    return ^(CGPoint position, CGFloat angle) { [log addObject:@[@(position.x), @(position.y), @(angle)]]; };
+}
+
+static CompletionBlock completionLogger(NSMutableArray *log)
+{
+    return ^(BOOL finished) { [log addObject:finished ? @"finished" : @"canceled"]; };
+}
+
+/** The IDs of the animations started by -startAnimationsOnEngine:logs:. */
+typedef struct {
+    INTUAnimationID tween;
+    INTUAnimationID spring;
+    INTUAnimationID decay;
+    INTUAnimationID path;
+    INTUAnimationID bound;
+} AnimationIDs;
+
+@interface AnimationEngineSnapshotTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineSnapshotTests
+
+/**
+ Starts one animation of each kind on the engine, logging their output into the corresponding arrays of logs (tween, spring, decay,
+ path), and returns their IDs. The bound animation is logged by the engine's output handler.
+ */
+- (AnimationIDs)startAnimationsOnEngine:(INTUAnimationEngine *)engine logs:(NSArray *)logs
+{
+    AnimationIDs animationIDs;
+    animationIDs.tween = [engine animateWithDuration:0.4
+                                               delay:0.0
+                                              easing:INTUEaseInOutCubic
+                                             options:INTUAnimationOptionRepeat | INTUAnimationOptionAutoreverse
+                                          animations:progressLogger(logs[0])
+                                          completion:completionLogger(logs[0])];
+    animationIDs.spring = [engine animateWithDamping:14.0
+                                           stiffness:120.0
+                                                mass:1.0
+                                               delay:0.0
+                                          animations:progressLogger(logs[1])
+                                          completion:completionLogger(logs[1])];
+    // Crosses the maximum position early on, so the snapshot is taken while a spring pulls it back to the boundary.
+    animationIDs.decay = [engine animateDecayWithPosition:0.0
+                                                 velocity:1500.0
+                                         decelerationRate:kINTUDecelerationRateNormal
+                                          minimumPosition:0.0
+                                          maximumPosition:200.0
+                                               animations:progressLogger(logs[2])
+                                               completion:completionLogger(logs[2])];
+    CGMutablePathRef path = CGPathCreateMutable();
+    CGPathMoveToPoint(path, NULL, 0.0, 0.0);
+    CGPathAddLineToPoint(path, NULL, 100.0, 0.0);
+    CGPathAddQuadCurveToPoint(path, NULL, 150.0, 50.0, 100.0, 100.0);
+    CGPathAddCurveToPoint(path, NULL, 60.0, 140.0, 20.0, 60.0, 40.0, 40.0);
+    CGPathCloseSubpath(path);
+    animationIDs.path = [engine animateAlongPath:path
+                                        duration:1.5
+                                           delay:0.1
+                                          easing:INTUEaseOutSine
+                                         options:INTUAnimationOptionNone
+                                      animations:pathLogger(logs[3])
+                                      completion:completionLogger(logs[3])];
+    CGPathRelease(path);
+    const CGFloat fromValues[] = {0.0, 10.0, -5.0};
+    const CGFloat toValues[] = {320.0, -10.0, 5.0};
+    animationIDs.bound = [engine animateWithDuration:1.0
+                                               delay:0.05
+                                              easing:INTUEaseOutBack
+                                             options:INTUAnimationOptionNone
+                                          fromValues:fromValues
+                                            toValues:toValues
+                                        channelCount:3
+                                          completion:completionLogger(logs[4])];
+    return animationIDs;
+}
+
+/** Sets an output handler on the engine that logs the values of the bound animation with the given ID whenever they change. */
+- (void)logBoundAnimationWithID:(INTUAnimationID)animationID onEngine:(INTUAnimationEngine *)engine log:(NSMutableArray *)log
+{
+    NSUInteger offset = [engine outputOffsetForAnimationID:animationID];
+    XCTAssertNotEqual(offset, (NSUInteger)NSNotFound);
+    [engine setOutputHandler:^(const CGFloat *outputBuffer, NSRange dirtyRange) {
+        if (NSLocationInRange(offset, dirtyRange)) {
+            [log addObject:@[@(outputBuffer[offset]), @(outputBuffer[offset + 1]), @(outputBuffer[offset + 2])]];
+        }
+    }];
+}
+
+- (NSArray *)newLogs
+{
+    return @[[NSMutableArray array], [NSMutableArray array], [NSMutableArray array], [NSMutableArray array], [NSMutableArray array]];
+}
+
+#pragma mark Round Trip
+
+- (void)testRestoredAnimationsContinueExactly
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    NSArray *logs = [self newLogs];
+    AnimationIDs animationIDs = [self startAnimationsOnEngine:engine logs:logs];
+    [self logBoundAnimationWithID:animationIDs.bound onEngine:engine log:logs[4]];
+    for (int frame = 1; frame <= FRAMES_BEFORE_SNAPSHOT; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+    }
+    NSData *snapshot = [engine snapshotActiveAnimations];
+    XCTAssertNotNil(snapshot);
+    
+    // Restore the snapshot into a fresh engine at the time it was taken, giving each animation blocks that log into a second set of logs.
+    INTUAnimationEngine *restoredEngine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    NSArray *restoredLogs = [self newLogs];
+    NSUInteger restoredCount = [restoredEngine restoreAnimationsFromSnapshot:snapshot handler:^BOOL(INTURestoredAnimation *animation) {
+        XCTAssertFalse(animation.hasCustomEasing);
+        NSUInteger index;
+        if (animation.animationID == animationIDs.tween) {
+            index = 0;
+        } else if (animation.animationID == animationIDs.spring) {
+            index = 1;
+        } else if (animation.animationID == animationIDs.decay) {
+            index = 2;
+        } else if (animation.animationID == animationIDs.path) {
+            animation.pathAnimations = pathLogger(restoredLogs[3]);
+            animation.completion = completionLogger(restoredLogs[3]);
+            return YES;
+        } else {
+            XCTAssertEqual(animation.animationID, animationIDs.bound);
+            XCTAssertTrue(animation.bound);
+            animation.completion = completionLogger(restoredLogs[4]);
+            return YES;
+        }
+        XCTAssertFalse(animation.bound);
+        animation.animations = progressLogger(restoredLogs[index]);
+        animation.completion = completionLogger(restoredLogs[index]);
+        return YES;
+    }];
+    XCTAssertEqual(restoredCount, (NSUInteger)5);
+    [self logBoundAnimationWithID:animationIDs.bound onEngine:restoredEngine log:restoredLogs[4]];
+    
+    // From here on, both engines produce exactly the same output, frame by frame, including when each animation completes.
+    for (NSMutableArray *log in logs) {
+        [log removeAllObjects];
+    }
+    for (int frame = FRAMES_BEFORE_SNAPSHOT + 1; frame <= FRAMES_BEFORE_SNAPSHOT + FRAMES_AFTER_SNAPSHOT; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+        [restoredEngine tick];
+        for (NSUInteger i = 0; i < [logs count]; i++) {
+            XCTAssertEqualObjects(restoredLogs[i], logs[i], @"animation %lu at frame %d", (unsigned long)i, frame);
+        }
+    }
+    for (NSUInteger i = 0; i < [logs count]; i++) {
+        XCTAssertGreaterThan([logs[i] count], (NSUInteger)0);
+    }
+    // All but the repeating tween have finished.
+    XCTAssertEqualObjects([logs[1] lastObject], @"finished");
+    XCTAssertEqualObjects([logs[2] lastObject], @"finished");
+    XCTAssertEqualObjects([logs[3] lastObject], @"finished");
+    XCTAssertEqualObjects([logs[4] lastObject], @"finished");
+    
+    // The restored engine does not hand out the restored IDs again.
+    XCTAssertGreaterThan([restoredEngine animateWithDuration:1.0 delay:0.0 animations:nil completion:nil], animationIDs.bound);
+}
+
+#pragma mark Invalid Snapshots
+
+- (void)testInvalidSnapshotsAreRejected
+{
+    __block CFTimeInterval now = 0.0;
+    INTUAnimationEngine *engine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    AnimationIDs animationIDs = [self startAnimationsOnEngine:engine logs:[self newLogs]];
+    for (int frame = 1; frame <= FRAMES_BEFORE_SNAPSHOT; frame++) {
+        now = frame * FRAME_DURATION;
+        [engine tick];
+    }
+    NSData *snapshot = [engine snapshotActiveAnimations];
+    XCTAssertNotNil(snapshot);
+    
+    // Every truncation of the snapshot is rejected, and restores nothing: the whole snapshot can still be restored afterwards, which it
+    // could not be if any of its animations (with the same IDs) had been restored.
+    INTUAnimationEngine *restoredEngine = [[INTUAnimationEngine alloc] initWithClock:^CFTimeInterval{ return now; }];
+    for (NSUInteger length = 0; length < [snapshot length]; length++) {
+        NSData *truncated = [snapshot subdataWithRange:NSMakeRange(0, length)];
+        NSUInteger restoredCount = [restoredEngine restoreAnimationsFromSnapshot:truncated handler:nil];
+        XCTAssertEqual(restoredCount, (NSUInteger)NSNotFound, @"length %lu", (unsigned long)length);
+    }
+    
+    // A snapshot from another version of the format, or that is not a snapshot at all, is rejected.
+    NSMutableData *wrongVersion = [snapshot mutableCopy];
+    uint16_t version;
+    [wrongVersion getBytes:&version range:NSMakeRange(SNAPSHOT_VERSION_OFFSET, sizeof(version))];
+    version++;
+    [wrongVersion replaceBytesInRange:NSMakeRange(SNAPSHOT_VERSION_OFFSET, sizeof(version)) withBytes:&version];
+    XCTAssertEqual([restoredEngine restoreAnimationsFromSnapshot:wrongVersion handler:nil], (NSUInteger)NSNotFound);
+    NSMutableData *wrongMagic = [snapshot mutableCopy];
+    ((uint8_t *)[wrongMagic mutableBytes])[0] ^= 0xFF;
+    XCTAssertEqual([restoredEngine restoreAnimationsFromSnapshot:wrongMagic handler:nil], (NSUInteger)NSNotFound);
+    
+    XCTAssertEqual([restoredEngine restoreAnimationsFromSnapshot:snapshot handler:nil], (NSUInteger)5);
+    XCTAssertNotEqual([restoredEngine outputOffsetForAnimationID:animationIDs.bound], (NSUInteger)NSNotFound);
+    // Restoring it again skips the animations that are already active.
+    XCTAssertEqual([restoredEngine restoreAnimationsFromSnapshot:snapshot handler:nil], (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,166 @@
+//
+//  AnimationEngineSpringNetworkTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include "INTUSpringNetwork.h"
+
+#define FRAME_DURATION                              (1.0 / 60.0)
+#define MAX_FRAMES                                  600  // 10 seconds at 60 fps, far longer than any of these networks takes to settle
+
+@interface AnimationEngineSpringNetworkTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineSpringNetworkTests
+
+- (void)testFreeNodesConvergeToRestLength
+{
+    // Two free nodes of equal mass, connected by a spring with a rest length of 10.0, starting on top of each other.
+    INTUSpringNetworkContextRef network = INTUSpringNetworkContextCreate(2, 1, 0.01);
+    XCTAssert(network != NULL);
+    INTUSpringScalar zero[kINTUSpringSolverDimensions] = {0.0};
+    INTUSpringScalar restOffset[kINTUSpringSolverDimensions] = {0.0};
+    restOffset[0] = 10.0;
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 0, 1.0, zero, zero, false));
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 1, 1.0, zero, zero, false));
+    XCTAssertTrue(INTUSpringNetworkConnect(network, 0, 1, 100.0, 10.0, restOffset));
+    
+    for (int frame = 1; frame <= MAX_FRAMES && !INTUSpringNetworkHasConverged(network); frame++) {
+        INTUAdvanceSpringNetwork(network, frame * FRAME_DURATION);
+    }
+    XCTAssertTrue(INTUSpringNetworkHasConverged(network));
+    
+    const INTUSpringScalar *positions = INTUSpringNetworkGetPositions(network);
+    XCTAssertEqualWithAccuracy(positions[kINTUSpringSolverDimensions] - positions[0], 10.0, 0.01);
+    // The spring pulls both nodes equally, so their center of mass does not move.
+    XCTAssertEqualWithAccuracy(positions[0], -5.0, 0.01);
+    XCTAssertEqualWithAccuracy(positions[kINTUSpringSolverDimensions], 5.0, 0.01);
+    
+    INTUSpringNetworkContextDestroy(network);
+}
+
+- (void)testPinnedNodeDoesNotMove
+{
+    // A pinned leader at 20.0, with a free follower that starts at rest at 0.0 and is pulled to 5.0 past the leader.
+    INTUSpringNetworkContextRef network = INTUSpringNetworkContextCreate(2, 1, 0.01);
+    XCTAssert(network != NULL);
+    INTUSpringScalar zero[kINTUSpringSolverDimensions] = {0.0};
+    INTUSpringScalar leaderPosition[kINTUSpringSolverDimensions] = {0.0};
+    INTUSpringScalar restOffset[kINTUSpringSolverDimensions] = {0.0};
+    leaderPosition[0] = 20.0;
+    restOffset[0] = 5.0;
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 0, 1.0, leaderPosition, zero, true));
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 1, 1.0, zero, zero, false));
+    XCTAssertTrue(INTUSpringNetworkConnect(network, 0, 1, 200.0, 20.0, restOffset));
+    
+    const INTUSpringScalar *positions = INTUSpringNetworkGetPositions(network);
+    int frame = 1;
+    for (; frame <= MAX_FRAMES && !INTUSpringNetworkHasConverged(network); frame++) {
+        INTUAdvanceSpringNetwork(network, frame * FRAME_DURATION);
+        // The spring pulls on the leader as hard as on the follower, but a pinned node has no inverse mass, so it never moves.
+        XCTAssertEqual(positions[0], (INTUSpringScalar)20.0);
+    }
+    XCTAssertTrue(INTUSpringNetworkHasConverged(network));
+    XCTAssertEqualWithAccuracy(positions[kINTUSpringSolverDimensions], 25.0, 0.01);
+    
+    // Moving the pinned node stretches the spring again, and the follower chases the leader to its new position.
+    leaderPosition[0] = 40.0;
+    INTUSpringNetworkSetNodePosition(network, 0, leaderPosition);
+    INTUAdvanceSpringNetwork(network, frame * FRAME_DURATION);
+    XCTAssertEqual(positions[0], (INTUSpringScalar)40.0);
+    XCTAssertFalse(INTUSpringNetworkHasConverged(network));
+    int lastFrame = frame + MAX_FRAMES;
+    for (frame++; frame <= lastFrame && !INTUSpringNetworkHasConverged(network); frame++) {
+        INTUAdvanceSpringNetwork(network, frame * FRAME_DURATION);
+        XCTAssertEqual(positions[0], (INTUSpringScalar)40.0);
+    }
+    XCTAssertTrue(INTUSpringNetworkHasConverged(network));
+    XCTAssertEqualWithAccuracy(positions[kINTUSpringSolverDimensions], 45.0, 0.01);
+    
+    INTUSpringNetworkContextDestroy(network);
+}
+
+- (void)testConvergence
+{
+    INTUSpringNetworkContextRef network = INTUSpringNetworkContextCreate(2, 1, 0.01);
+    XCTAssert(network != NULL);
+    INTUSpringScalar zero[kINTUSpringSolverDimensions] = {0.0};
+    INTUSpringScalar restOffset[kINTUSpringSolverDimensions] = {0.0};
+    restOffset[0] = 100.0;
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 0, 1.0, zero, zero, true));
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 1, 1.0, zero, zero, false));
+    XCTAssertTrue(INTUSpringNetworkConnect(network, 0, 1, 100.0, 10.0, restOffset));
+    
+    // A network that has not been advanced yet has not converged, even if it happens to be at rest.
+    XCTAssertFalse(INTUSpringNetworkHasConverged(network));
+    
+    INTUAdvanceSpringNetwork(network, FRAME_DURATION);
+    XCTAssertFalse(INTUSpringNetworkHasConverged(network));
+    
+    int convergedFrame = 0;
+    for (int frame = 2; frame <= MAX_FRAMES; frame++) {
+        INTUAdvanceSpringNetwork(network, frame * FRAME_DURATION);
+        if (INTUSpringNetworkHasConverged(network)) {
+            convergedFrame = frame;
+            break;
+        }
+    }
+    XCTAssertGreaterThan(convergedFrame, 1);
+    // The network is only considered converged once the follower is within half the threshold of its rest point.
+    const INTUSpringScalar *positions = INTUSpringNetworkGetPositions(network);
+    XCTAssertEqualWithAccuracy(positions[kINTUSpringSolverDimensions], 100.0, 0.005);
+    
+    INTUSpringNetworkContextDestroy(network);
+}
+
+- (void)testInvalidParameters
+{
+    XCTAssert(INTUSpringNetworkContextCreate(0, 1, 0.01) == NULL);
+    XCTAssert(INTUSpringNetworkContextCreate(2, -1, 0.01) == NULL);
+    XCTAssert(INTUSpringNetworkContextCreate(2, 1, 0.0) == NULL);
+    XCTAssert(INTUSpringNetworkContextCreate(2, 1, NAN) == NULL);
+    XCTAssert(INTUSpringNetworkContextCreate(2, 1, INFINITY) == NULL);
+    
+    INTUSpringNetworkContextRef network = INTUSpringNetworkContextCreate(2, 1, 0.01);
+    XCTAssert(network != NULL);
+    INTUSpringScalar zero[kINTUSpringSolverDimensions] = {0.0};
+    XCTAssertFalse(INTUSpringNetworkSetNode(network, 2, 1.0, zero, zero, false));
+    XCTAssertFalse(INTUSpringNetworkSetNode(network, 0, 0.0, zero, zero, false));
+    // A non-finite mass would give a non-finite inverse mass, which would spread to every connected node.
+    XCTAssertFalse(INTUSpringNetworkSetNode(network, 0, NAN, zero, zero, false));
+    XCTAssertFalse(INTUSpringNetworkSetNode(network, 0, INFINITY, zero, zero, false));
+    XCTAssertTrue(INTUSpringNetworkSetNode(network, 0, 0.0, zero, zero, true));
+    XCTAssertFalse(INTUSpringNetworkConnect(network, 0, 1, 0.0, 10.0, NULL));
+    XCTAssertFalse(INTUSpringNetworkConnect(network, 0, 1, NAN, 10.0, NULL));
+    XCTAssertFalse(INTUSpringNetworkConnect(network, 0, 1, 100.0, NAN, NULL));
+    XCTAssertFalse(INTUSpringNetworkConnect(network, 0, 1, INFINITY, 10.0, NULL));
+    XCTAssertTrue(INTUSpringNetworkConnect(network, 0, 1, 100.0, 10.0, NULL));
+    // The network only has room for one spring.
+    XCTAssertFalse(INTUSpringNetworkConnect(network, 0, 1, 100.0, 10.0, NULL));
+    INTUSpringNetworkContextDestroy(network);
+}
+
+@end
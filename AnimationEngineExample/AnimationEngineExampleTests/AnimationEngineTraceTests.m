@@ -0,0 +1,181 @@
+//
+//  AnimationEngineTraceTests.m
+//  AnimationEngineExampleTests
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include "INTUAnimationTrace.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONCURRENT_EVENT_COUNT                      2000000  // enough events to wrap the ring buffer many times during the copies
+#define JSON_END                                    "\n]}\n"  // the end of every trace JSON document
+
+/** Records CONCURRENT_EVENT_COUNT events whose fields are all derived from the event's index, so a torn copy can be detected. */
+static void *recordEvents(void *info)
+{
+    INTUAnimationTrace *trace = info;
+    for (int32_t i = 0; i < CONCURRENT_EVENT_COUNT; i++) {
+        INTUAnimationTraceRecord(trace, (INTUAnimationTracePhase)(i % INTUAnimationTracePhaseCount), i, i, i);
+    }
+    return NULL;
+}
+
+/** Returns the number of non-overlapping occurrences of needle in haystack. */
+static size_t countOccurrences(const char *haystack, const char *needle)
+{
+    size_t count = 0;
+    for (const char *match = strstr(haystack, needle); match; match = strstr(match + strlen(needle), needle)) {
+        count++;
+    }
+    return count;
+}
+
+@interface AnimationEngineTraceTests : XCTestCase
+
+@end
+
+@implementation AnimationEngineTraceTests
+
+- (void)testWraparound
+{
+    INTUAnimationTrace trace;
+    XCTAssertTrue(INTUAnimationTraceInit(&trace, 6));
+    // The capacity is rounded up to a power of two.
+    XCTAssertEqual(trace.capacity, (size_t)8);
+    
+    size_t count;
+    XCTAssert(INTUAnimationTraceCopyEvents(&trace, &count) == NULL);
+    XCTAssertEqual(count, (size_t)0);
+    
+    for (int32_t i = 0; i < 5; i++) {
+        INTUAnimationTraceRecord(&trace, INTUAnimationTracePhaseEasing, 100 + i, 0.0, i);
+    }
+    INTUAnimationTraceEvent *events = INTUAnimationTraceCopyEvents(&trace, &count);
+    XCTAssertEqual(count, (size_t)5);
+    for (size_t i = 0; i < count; i++) {
+        XCTAssertEqual(events[i].argument, (int32_t)i);
+        XCTAssertEqual(events[i].animationID, (intptr_t)(100 + i));
+        XCTAssertEqual(events[i].phase, (int32_t)INTUAnimationTracePhaseEasing);
+    }
+    free(events);
+    
+    // Once the buffer is full, the oldest events are overwritten, and the copy holds the newest events, oldest first.
+    for (int32_t i = 5; i < 21; i++) {
+        INTUAnimationTraceRecord(&trace, INTUAnimationTracePhaseCallback, 100 + i, 0.0, i);
+    }
+    events = INTUAnimationTraceCopyEvents(&trace, &count);
+    XCTAssertEqual(count, (size_t)8);
+    for (size_t i = 0; i < count; i++) {
+        XCTAssertEqual(events[i].argument, (int32_t)(13 + i));
+        XCTAssertEqual(events[i].animationID, (intptr_t)(113 + i));
+        XCTAssertGreaterThanOrEqual(events[i].duration, 0.0);
+    }
+    free(events);
+    INTUAnimationTraceDestroy(&trace);
+}
+
+- (void)testConcurrentRecordAndCopy
+{
+    INTUAnimationTrace trace;
+    XCTAssertTrue(INTUAnimationTraceInit(&trace, 64));
+    pthread_t recorder;
+    XCTAssertEqual(pthread_create(&recorder, NULL, recordEvents, &trace), 0);
+    
+    // Every event copied while the recorder is overwriting the buffer must be whole (all of its fields from the same event), and the
+    // events must be in the order they were recorded.
+    size_t copies = 0, tornEvents = 0, unorderedEvents = 0;
+    while (__atomic_load_n(&trace.head, __ATOMIC_ACQUIRE) < CONCURRENT_EVENT_COUNT) {
+        size_t count;
+        INTUAnimationTraceEvent *events = INTUAnimationTraceCopyEvents(&trace, &count);
+        for (size_t i = 0; i < count; i++) {
+            const INTUAnimationTraceEvent *event = &events[i];
+            if (event->animationID != event->argument || event->start != event->argument ||
+                event->phase != event->argument % INTUAnimationTracePhaseCount) {
+                tornEvents++;
+            }
+            if (i > 0 && event->argument <= events[i - 1].argument) {
+                unorderedEvents++;
+            }
+        }
+        free(events);
+        copies++;
+    }
+    pthread_join(recorder, NULL);
+    XCTAssertGreaterThan(copies, (size_t)0);
+    XCTAssertEqual(tornEvents, (size_t)0);
+    XCTAssertEqual(unorderedEvents, (size_t)0);
+    
+    // Once recording stops, the copy holds the whole buffer.
+    size_t count;
+    INTUAnimationTraceEvent *events = INTUAnimationTraceCopyEvents(&trace, &count);
+    XCTAssertEqual(count, (size_t)64);
+    XCTAssertEqual(events[count - 1].argument, CONCURRENT_EVENT_COUNT - 1);
+    free(events);
+    INTUAnimationTraceDestroy(&trace);
+}
+
+- (void)testChromeJSON
+{
+    INTUAnimationTrace trace;
+    XCTAssertTrue(INTUAnimationTraceInit(&trace, 4));
+    size_t length;
+    char *json = INTUAnimationTraceCopyChromeJSON(&trace, &length);
+    XCTAssert(json != NULL);
+    XCTAssertEqual(strcmp(json, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n"), 0);
+    free(json);
+    
+    INTUAnimationTraceRecord(&trace, INTUAnimationTracePhaseSpringIntegration, 42, INTUAnimationTraceNow(), 7);
+    json = INTUAnimationTraceCopyChromeJSON(&trace, &length);
+    XCTAssertEqual(strlen(json), length);
+    XCTAssert(strstr(json, "\"name\":\"Spring Integration\"") != NULL);
+    XCTAssert(strstr(json, "\"args\":{\"animationID\":42,\"argument\":7}") != NULL);
+    free(json);
+    INTUAnimationTraceDestroy(&trace);
+}
+
+- (void)testChromeJSONWithWorstCaseFieldWidths
+{
+    // Huge timestamps and durations print hundreds of digits, far beyond the typical length the export buffer is sized for, so the
+    // buffer must grow rather than be overrun.
+    INTUAnimationTrace trace;
+    XCTAssertTrue(INTUAnimationTraceInit(&trace, 64));
+    for (int i = 0; i < 64; i++) {
+        INTUAnimationTraceRecord(&trace, (INTUAnimationTracePhase)(i % 2 ? 1000 : INTUAnimationTracePhaseSpringIntegration),
+                                 i % 2 ? INTPTR_MIN : INTPTR_MAX, -1e300, i % 2 ? INT32_MIN : INT32_MAX);
+    }
+    size_t length;
+    char *json = INTUAnimationTraceCopyChromeJSON(&trace, &length);
+    XCTAssert(json != NULL);
+    XCTAssertEqual(strlen(json), length);
+    XCTAssertGreaterThan(length, (size_t)(64 * 600));
+    XCTAssertEqual(countOccurrences(json, "\"name\":"), (size_t)64);
+    XCTAssertEqual(countOccurrences(json, "\"name\":\"Unknown\""), (size_t)32);
+    XCTAssertEqual(strcmp(json + length - strlen(JSON_END), JSON_END), 0);
+    free(json);
+    INTUAnimationTraceDestroy(&trace);
+}
+
+@end
@@ -0,0 +1,610 @@
+//
+//  SpringSolverRegression.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+// A regression harness for the spring solver and the easing kernels, runnable on any platform with a C compiler (see
+// run_regression.sh). The corpus contains reference trajectories of a damped spring, computed from the closed form solution in long
+// double precision, for a range of damping regimes, stiffness/mass values and frame timing patterns. Each build of this harness tests
+// one solver mode (selected with the same preprocessor macros as the solver itself), measuring for every case:
+//
+//  * the maximum absolute position error against the reference trajectory,
+//  * the drift of the frame on which the solver reports convergence, relative to the frame on which the reference settles,
+//  * the CPU cost of advancing the solver, in nanoseconds per simulated second.
+//
+// The results are compared against the recorded baseline for the mode, and written as a JSON report. The process exits with a nonzero
+// status if the error or settle drift of any case has regressed.
+//
+// Usage:
+//   SpringSolverRegression --corpus <file> --baseline <file> [--report <file>] [--record] [--cost-tolerance <ratio>]
+//   SpringSolverRegression --generate-corpus <file>
+
+#include "INTUSpringSolver.h"
+#include "INTUEasingKernels.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef INTU_SPRING_SOLVER_SINGLE_PRECISION
+#   define kModeName    "single"
+#else
+#   define kModeName    "double"
+#endif
+
+// The error and settle drift of a case may exceed the baseline by this much before it is reported as a regression. The slack allows
+// for differences between compilers and math libraries. Improvements (smaller error or drift) never fail; re-record the baseline to
+// lock them in.
+static const double kErrorRelativeTolerance = 0.05;
+static const double kErrorAbsoluteTolerance = 1e-9;
+static const int kSettleFrameTolerance = 1;
+
+// The maximum number of frames stored for each case in the corpus.
+static const int kMaxStoredFrames = 600;
+// When looking for the frame on which the solver converges, it is advanced for up to this many times the number of stored frames.
+static const int kSettleSearchFactor = 4;
+
+// The number of samples stored for each easing curve in the corpus.
+static const int kEasingSampleCount = 21;
+
+#pragma mark Frame Patterns
+
+typedef enum {
+    FramePatternSteady60,
+    FramePatternSteady120,
+    FramePatternJitter,
+    FramePatternDropped,
+    FramePatternStall,
+    FramePatternCount
+} FramePattern;
+
+static const char *kFramePatternNames[FramePatternCount] = { "steady60", "steady120", "jitter", "dropped", "stall" };
+
+/** Fills times with the timestamps (relative to the start of the animation) of the first frameCount frames of the pattern. */
+static void frameTimes(FramePattern pattern, int frameCount, double *times)
+{
+    unsigned int seed = 1;
+    double t = 0.0;
+    for (int i = 0; i < frameCount; i++) {
+        double gap = 1.0 / 60.0;
+        switch (pattern) {
+            case FramePatternSteady60:
+                break;
+            case FramePatternSteady120:
+                gap = 1.0 / 120.0;
+                break;
+            case FramePatternJitter:
+                // Deterministic jitter between 0.7 and 1.3 frames.
+                seed = seed * 1103515245u + 12345u;
+                gap *= 0.7 + 0.6 * ((seed >> 16) & 0x7fff) / 32768.0;
+                break;
+            case FramePatternDropped:
+                // One frame out of every eight is dropped.
+                if (i % 8 == 7) {
+                    gap *= 2.0;
+                }
+                break;
+            case FramePatternStall:
+                // A single long stall early in the animation, as when the main thread is blocked.
+                if (i == 5) {
+                    gap = 0.25;
+                }
+                break;
+            case FramePatternCount:
+                break;
+        }
+        t += gap;
+        times[i] = t;
+    }
+}
+
+static int framePatternNamed(const char *name)
+{
+    for (int i = 0; i < FramePatternCount; i++) {
+        if (strcmp(name, kFramePatternNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#pragma mark Reference Solution
+
+typedef struct {
+    char name[96];
+    double stiffness;
+    double damping;
+    double mass;
+    double initialPosition;
+    double initialVelocity;
+    FramePattern pattern;
+    /** The index of the first frame on which the reference solution has settled, or -1 if it never settles. */
+    int settleFrame;
+    int frameCount;
+    double *positions;
+} SpringCase;
+
+/** Evaluates the closed form solution of the damped spring, returning the position and writing the velocity and acceleration. */
+static long double referenceState(const SpringCase *c, long double t, long double *velocity, long double *acceleration)
+{
+    const long double k = c->stiffness, b = c->damping, m = c->mass;
+    const long double x0 = c->initialPosition, v0 = c->initialVelocity;
+    const long double w0 = sqrtl(k / m);
+    const long double zeta = b / (2.0L * sqrtl(k * m));
+    long double x, v;
+    
+    if (fabsl(zeta - 1.0L) < 1e-12L) {
+        // Critically damped
+        const long double e = expl(-w0 * t);
+        const long double c1 = x0, c2 = v0 + w0 * x0;
+        x = (c1 + c2 * t) * e;
+        v = (c2 - w0 * (c1 + c2 * t)) * e;
+    } else if (zeta < 1.0L) {
+        // Underdamped
+        const long double wd = w0 * sqrtl(1.0L - zeta * zeta);
+        const long double decay = zeta * w0;
+        const long double e = expl(-decay * t);
+        const long double a = x0, bb = (v0 + decay * x0) / wd;
+        const long double cs = cosl(wd * t), sn = sinl(wd * t);
+        x = e * (a * cs + bb * sn);
+        v = e * ((bb * wd - decay * a) * cs - (a * wd + decay * bb) * sn);
+    } else {
+        // Overdamped
+        const long double root = sqrtl(zeta * zeta - 1.0L);
+        const long double r1 = -w0 * (zeta - root), r2 = -w0 * (zeta + root);
+        const long double c1 = (v0 - r2 * x0) / (r1 - r2), c2 = x0 - c1;
+        x = c1 * expl(r1 * t) + c2 * expl(r2 * t);
+        v = c1 * r1 * expl(r1 * t) + c2 * r2 * expl(r2 * t);
+    }
+    
+    *velocity = v;
+    *acceleration = -(k * x + b * v) / m;
+    return x;
+}
+
+/** Returns whether the state is within the solver's convergence thresholds for the case, which are derived the same way as the solver's. */
+static bool isSettled(const SpringCase *c, long double x, long double v, long double a)
+{
+    const long double threshold = fabsl((long double)c->initialPosition) * 0.0001L;
+    return fabsl(x) < threshold / 2 && v * v < 25.0L * threshold && a * a < 625.0L * threshold * threshold;
+}
+
+#pragma mark Corpus
+
+// Each spring case is run with every frame pattern.
+static const double kSpringParameters[][5] = {
+    // stiffness, damping, mass, initial position, initial velocity
+    // Underdamped
+    { 100.0, 10.0, 1.0, -1.0, 0.0 },
+    { 300.0, 6.0, 1.0, -1.0, 0.0 },
+    { 20.0, 2.0, 0.5, -1.0, 0.0 },
+    { 500.0, 15.0, 2.0, -250.0, 1200.0 },
+    // Critically damped
+    { 100.0, 20.0, 1.0, -1.0, 0.0 },
+    { 50.0, 20.0, 2.0, -1.0, 0.0 },
+    { 400.0, 40.0, 1.0, -250.0, 1200.0 },
+    // Overdamped
+    { 100.0, 30.0, 1.0, -1.0, 0.0 },
+    { 40.0, 20.0, 1.0, -1.0, 0.0 },
+    { 200.0, 30.0, 0.5, -250.0, 1200.0 },
+};
+
+#define EASING_CURVES(X) \
+    X(Linear) \
+    X(EaseInSine) X(EaseOutSine) X(EaseInOutSine) \
+    X(EaseInQuadratic) X(EaseOutQuadratic) X(EaseInOutQuadratic) \
+    X(EaseInCubic) X(EaseOutCubic) X(EaseInOutCubic) \
+    X(EaseInQuartic) X(EaseOutQuartic) X(EaseInOutQuartic) \
+    X(EaseInQuintic) X(EaseOutQuintic) X(EaseInOutQuintic) \
+    X(EaseInExponential) X(EaseOutExponential) X(EaseInOutExponential) \
+    X(EaseInCircular) X(EaseOutCircular) X(EaseInOutCircular) \
+    X(EaseInBack) X(EaseOutBack) X(EaseInOutBack) \
+    X(EaseInElastic) X(EaseOutElastic) X(EaseInOutElastic) \
+    X(EaseInBounce) X(EaseOutBounce) X(EaseInOutBounce)
+
+typedef struct {
+    const char *name;
+    INTUEasingKernel kernel;
+    INTUEasingKernelf kernelf;
+} EasingCurve;
+
+#define EASING_CURVE_ENTRY(name) { #name, INTU##name##Kernel, INTU##name##Kernelf },
+static const EasingCurve kEasingCurves[] = { EASING_CURVES(EASING_CURVE_ENTRY) };
+#undef EASING_CURVE_ENTRY
+static const int kEasingCurveCount = sizeof(kEasingCurves) / sizeof(kEasingCurves[0]);
+
+static int generateCorpus(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Unable to write corpus to %s\n", path);
+        return 1;
+    }
+    fprintf(file, "# Spring solver regression corpus. Generated by SpringSolverRegression --generate-corpus; do not edit.\n");
+    fprintf(file, "# spring <name> <stiffness> <damping> <mass> <x0> <v0> <pattern> <settle frame> <frame count>, followed by one position per frame\n");
+    fprintf(file, "# easing <name> <sample count>, followed by one value per sample, for p evenly spaced over [0, 1]\n");
+    
+    double *times = malloc(sizeof(double) * kMaxStoredFrames);
+    const int parameterCount = sizeof(kSpringParameters) / sizeof(kSpringParameters[0]);
+    for (int i = 0; i < parameterCount; i++) {
+        for (int pattern = 0; pattern < FramePatternCount; pattern++) {
+            SpringCase c;
+            memset(&c, 0, sizeof(c));
+            c.stiffness = kSpringParameters[i][0];
+            c.damping = kSpringParameters[i][1];
+            c.mass = kSpringParameters[i][2];
+            c.initialPosition = kSpringParameters[i][3];
+            c.initialVelocity = kSpringParameters[i][4];
+            c.pattern = pattern;
+            snprintf(c.name, sizeof(c.name), "k%g_b%g_m%g_x%g_v%g/%s", c.stiffness, c.damping, c.mass,
+                     c.initialPosition, c.initialVelocity, kFramePatternNames[pattern]);
+            
+            // Store frames until a little after the reference settles.
+            frameTimes(pattern, kMaxStoredFrames, times);
+            c.settleFrame = -1;
+            c.frameCount = kMaxStoredFrames;
+            for (int frame = 0; frame < kMaxStoredFrames; frame++) {
+                long double v, a;
+                long double x = referenceState(&c, times[frame], &v, &a);
+                if (isSettled(&c, x, v, a)) {
+                    if (c.settleFrame < 0) {
+                        c.settleFrame = frame;
+                    }
+                } else {
+                    c.settleFrame = -1;
+                }
+            }
+            if (c.settleFrame >= 0 && c.settleFrame + 10 < kMaxStoredFrames) {
+                c.frameCount = c.settleFrame + 10;
+            }
+            
+            fprintf(file, "spring %s %.17g %.17g %.17g %.17g %.17g %s %d %d\n", c.name, c.stiffness, c.damping, c.mass,
+                    c.initialPosition, c.initialVelocity, kFramePatternNames[pattern], c.settleFrame, c.frameCount);
+            for (int frame = 0; frame < c.frameCount; frame++) {
+                long double v, a;
+                fprintf(file, "%.10Le\n", referenceState(&c, times[frame], &v, &a));
+            }
+        }
+    }
+    free(times);
+    
+    for (int i = 0; i < kEasingCurveCount; i++) {
+        fprintf(file, "easing %s %d\n", kEasingCurves[i].name, kEasingSampleCount);
+        for (int sample = 0; sample < kEasingSampleCount; sample++) {
+            fprintf(file, "%.17g\n", kEasingCurves[i].kernel((double)sample / (kEasingSampleCount - 1)));
+        }
+    }
+    
+    fclose(file);
+    return 0;
+}
+
+#pragma mark Baseline
+
+typedef struct {
+    char name[96];
+    double maxError;
+    int settleFrameDrift;
+    double cost;
+} BaselineEntry;
+
+typedef struct {
+    BaselineEntry *entries;
+    int count;
+} Baseline;
+
+static Baseline loadBaseline(const char *path)
+{
+    Baseline baseline = { NULL, 0 };
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return baseline;
+    }
+    int capacity = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        BaselineEntry entry;
+        if (sscanf(line, "%95s %lf %d %lf", entry.name, &entry.maxError, &entry.settleFrameDrift, &entry.cost) != 4) {
+            continue;
+        }
+        if (baseline.count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            baseline.entries = realloc(baseline.entries, sizeof(BaselineEntry) * capacity);
+        }
+        baseline.entries[baseline.count++] = entry;
+    }
+    fclose(file);
+    return baseline;
+}
+
+static const BaselineEntry *baselineEntryNamed(const Baseline *baseline, const char *name)
+{
+    for (int i = 0; i < baseline->count; i++) {
+        if (strcmp(baseline->entries[i].name, name) == 0) {
+            return &baseline->entries[i];
+        }
+    }
+    return NULL;
+}
+
+#pragma mark Running Cases
+
+static double monotonicSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    double maxError;
+    /** The frame from which the solver stayed converged minus the frame on which the reference settled. */
+    int settleFrameDrift;
+    /** The CPU cost in nanoseconds per simulated second, or zero if not measured. */
+    double cost;
+} CaseResult;
+
+static CaseResult runSpringCase(const SpringCase *c)
+{
+    CaseResult result = { 0.0, 0, 0.0 };
+    const int searchFrames = c->frameCount * kSettleSearchFactor;
+    double *times = malloc(sizeof(double) * searchFrames);
+    frameTimes(c->pattern, searchFrames, times);
+    
+    const INTUSpringScalar initialPosition[kINTUSpringSolverDimensions] = { (INTUSpringScalar)c->initialPosition };
+    const INTUSpringScalar initialVelocity[kINTUSpringSolverDimensions] = { (INTUSpringScalar)c->initialVelocity };
+    
+    // Accuracy and convergence
+    INTUSpringSolverContextRef context = INTUSpringSolverContextCreate(c->stiffness, c->damping, c->mass, initialPosition, initialVelocity);
+    // Like the reference, the solver settles on the first frame from which it stays converged, as it can briefly report convergence
+    // while still oscillating around its rest position.
+    int solverSettleFrame = -1;
+    for (int frame = 0; frame < searchFrames; frame++) {
+        INTUSpringState state = INTUAdvanceSpringSolver(context, times[frame]);
+        if (frame < c->frameCount) {
+            result.maxError = fmax(result.maxError, fabs(state.position[0] - c->positions[frame]));
+        }
+        if (!INTUSpringSolverHasConverged(context)) {
+            solverSettleFrame = -1;
+        } else if (solverSettleFrame < 0) {
+            solverSettleFrame = frame;
+        }
+    }
+    INTUSpringSolverContextDestroy(context);
+    if (solverSettleFrame < 0 || c->settleFrame < 0) {
+        // Report a case that does not settle (in either the solver or the reference) as a large drift.
+        result.settleFrameDrift = (solverSettleFrame == c->settleFrame) ? 0 : searchFrames;
+    } else {
+        result.settleFrameDrift = solverSettleFrame - c->settleFrame;
+    }
+    
+    // Cost: repeat the stored frames until enough time has elapsed to measure reliably.
+    int repetitions = 0;
+    double start = monotonicSeconds(), elapsed = 0.0;
+    volatile INTUSpringScalar sink = 0;
+    do {
+        context = INTUSpringSolverContextCreate(c->stiffness, c->damping, c->mass, initialPosition, initialVelocity);
+        for (int frame = 0; frame < c->frameCount; frame++) {
+            sink += INTUAdvanceSpringSolver(context, times[frame]).position[0];
+        }
+        INTUSpringSolverContextDestroy(context);
+        repetitions++;
+        elapsed = monotonicSeconds() - start;
+    } while (elapsed < 0.02);
+    result.cost = elapsed * 1e9 / (repetitions * times[c->frameCount - 1]);
+    
+    free(times);
+    return result;
+}
+
+static CaseResult runEasingCase(int curve, const double *values)
+{
+    CaseResult result = { 0.0, 0, 0.0 };
+    for (int sample = 0; sample < kEasingSampleCount; sample++) {
+        const double p = (double)sample / (kEasingSampleCount - 1);
+#ifdef INTU_SPRING_SOLVER_SINGLE_PRECISION
+        const double value = kEasingCurves[curve].kernelf((float)p);
+#else
+        const double value = kEasingCurves[curve].kernel(p);
+#endif
+        result.maxError = fmax(result.maxError, fabs(value - values[sample]));
+    }
+    return result;
+}
+
+#pragma mark Main
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: SpringSolverRegression --corpus <file> --baseline <file> [--report <file>] [--record] [--cost-tolerance <ratio>]\n"
+                    "       SpringSolverRegression --generate-corpus <file>\n");
+}
+
+int main(int argc, const char *argv[])
+{
+    const char *corpusPath = NULL, *baselinePath = NULL, *reportPath = NULL;
+    bool record = false;
+    double costTolerance = 0.0; // If zero, cost is reported but never treated as a regression.
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate-corpus") == 0 && i + 1 < argc) {
+            return generateCorpus(argv[i + 1]);
+        } else if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) {
+            corpusPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (strcmp(argv[i], "--cost-tolerance") == 0 && i + 1 < argc) {
+            costTolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0) {
+            record = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (!corpusPath || !baselinePath) {
+        usage();
+        return 2;
+    }
+    
+    FILE *corpus = fopen(corpusPath, "r");
+    if (!corpus) {
+        fprintf(stderr, "Unable to read corpus from %s\n", corpusPath);
+        return 2;
+    }
+    Baseline baseline = loadBaseline(baselinePath);
+    FILE *report = reportPath ? fopen(reportPath, "w") : stdout;
+    FILE *newBaseline = record ? fopen(baselinePath, "w") : NULL;
+    if (!report || (record && !newBaseline)) {
+        fprintf(stderr, "Unable to write results\n");
+        return 2;
+    }
+    if (newBaseline) {
+        fprintf(newBaseline, "# Spring solver regression baseline for the %s mode. Recorded by SpringSolverRegression --record.\n", kModeName);
+        fprintf(newBaseline, "# <case> <max error> <settle frame drift> <cost in ns per simulated second>\n");
+    }
+    
+    fprintf(report, "{\"mode\":\"%s\",\"cases\":[", kModeName);
+    
+    int caseCount = 0, regressionCount = 0;
+    double worstError = 0.0, totalCost = 0.0;
+    int worstDrift = 0, springCaseCount = 0;
+    double positions[kMaxStoredFrames > 64 ? kMaxStoredFrames : 64];
+    char line[256];
+    while (fgets(line, sizeof(line), corpus)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        
+        char kind[16], name[96], patternName[32];
+        CaseResult result;
+        bool isSpring = false;
+        if (sscanf(line, "%15s", kind) != 1) {
+            continue;
+        }
+        if (strcmp(kind, "spring") == 0) {
+            SpringCase c;
+            if (sscanf(line, "spring %95s %lf %lf %lf %lf %lf %31s %d %d", c.name, &c.stiffness, &c.damping, &c.mass,
+                       &c.initialPosition, &c.initialVelocity, patternName, &c.settleFrame, &c.frameCount) != 9 ||
+                framePatternNamed(patternName) < 0 || c.frameCount <= 0 || c.frameCount > kMaxStoredFrames) {
+                fprintf(stderr, "Malformed corpus entry: %s", line);
+                return 2;
+            }
+            c.pattern = framePatternNamed(patternName);
+            for (int frame = 0; frame < c.frameCount; frame++) {
+                if (fscanf(corpus, "%lf", &positions[frame]) != 1) {
+                    fprintf(stderr, "Truncated corpus entry: %s\n", c.name);
+                    return 2;
+                }
+            }
+            c.positions = positions;
+            strcpy(name, c.name);
+            result = runSpringCase(&c);
+            isSpring = true;
+        } else if (strcmp(kind, "easing") == 0) {
+            char curveName[48];
+            int sampleCount, curve = -1;
+            if (sscanf(line, "easing %47s %d", curveName, &sampleCount) != 2 || sampleCount != kEasingSampleCount) {
+                fprintf(stderr, "Malformed corpus entry: %s", line);
+                return 2;
+            }
+            for (int i = 0; i < kEasingCurveCount; i++) {
+                if (strcmp(kEasingCurves[i].name, curveName) == 0) {
+                    curve = i;
+                }
+            }
+            for (int sample = 0; sample < sampleCount; sample++) {
+                if (fscanf(corpus, "%lf", &positions[sample]) != 1) {
+                    fprintf(stderr, "Truncated corpus entry: %s\n", curveName);
+                    return 2;
+                }
+            }
+            if (curve < 0) {
+                fprintf(stderr, "Unknown easing curve: %s\n", curveName);
+                return 2;
+            }
+            snprintf(name, sizeof(name), "easing/%s", curveName);
+            result = runEasingCase(curve, positions);
+        } else {
+            fprintf(stderr, "Malformed corpus entry: %s", line);
+            return 2;
+        }
+        
+        const BaselineEntry *entry = baselineEntryNamed(&baseline, name);
+        const char *status = "new";
+        if (entry) {
+            bool regressed = result.maxError > entry->maxError * (1.0 + kErrorRelativeTolerance) + kErrorAbsoluteTolerance ||
+                             abs(result.settleFrameDrift) > abs(entry->settleFrameDrift) + kSettleFrameTolerance ||
+                             (costTolerance > 0.0 && entry->cost > 0.0 && result.cost > entry->cost * costTolerance);
+            status = regressed ? "regression" : "pass";
+            if (regressed) {
+                regressionCount++;
+                fprintf(stderr, "REGRESSION %s %s: max error %.3g (baseline %.3g), settle frame drift %d (baseline %d), cost %.0f (baseline %.0f)\n",
+                        kModeName, name, result.maxError, entry->maxError, result.settleFrameDrift, entry->settleFrameDrift,
+                        result.cost, entry->cost);
+            }
+        }
+        
+        fprintf(report, "%s\n{\"name\":\"%s\",\"status\":\"%s\",\"maxError\":%.6g,\"settleFrameDrift\":%d,\"costNsPerSimulatedSecond\":%.1f",
+                caseCount ? "," : "", name, status, result.maxError, result.settleFrameDrift, result.cost);
+        if (entry) {
+            fprintf(report, ",\"baselineMaxError\":%.6g,\"baselineSettleFrameDrift\":%d,\"baselineCostNsPerSimulatedSecond\":%.1f",
+                    entry->maxError, entry->settleFrameDrift, entry->cost);
+        }
+        fprintf(report, "}");
+        if (newBaseline) {
+            fprintf(newBaseline, "%s %.6g %d %.1f\n", name, result.maxError, result.settleFrameDrift, result.cost);
+        }
+        
+        caseCount++;
+        worstError = fmax(worstError, result.maxError);
+        if (isSpring) {
+            springCaseCount++;
+            worstDrift = abs(result.settleFrameDrift) > abs(worstDrift) ? result.settleFrameDrift : worstDrift;
+            totalCost += result.cost;
+        }
+    }
+    
+    fprintf(report, "\n],\"summary\":{\"cases\":%d,\"regressions\":%d,\"maxError\":%.6g,\"worstSettleFrameDrift\":%d,"
+                    "\"meanCostNsPerSimulatedSecond\":%.1f},\"passed\":%s}\n",
+            caseCount, regressionCount, worstError, worstDrift, springCaseCount ? totalCost / springCaseCount : 0.0,
+            regressionCount == 0 ? "true" : "false");
+    
+    fclose(corpus);
+    if (reportPath) {
+        fclose(report);
+    }
+    if (newBaseline) {
+        fclose(newBaseline);
+    }
+    free(baseline.entries);
+    return regressionCount == 0 ? 0 : 1;
+}
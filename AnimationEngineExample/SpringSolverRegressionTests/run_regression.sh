@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+#  run_regression.sh
+#  https://github.com/intuit/AnimationEngine
+#
+#  Builds the spring solver regression harness once for each solver mode, runs it against the corpus, and writes a combined JSON
+#  report. Exits with a nonzero status if any mode has regressed against its baseline.
+#
+#  Usage: ./run_regression.sh [--record]
+#
+#  Environment:
+#    CC              The C compiler to use (default: cc).
+#    REPORT          The path of the combined report (default: regression-report.json in the current directory).
+#    COST_TOLERANCE  If set, treat a case as a regression when its cost exceeds the baseline by this factor (e.g. 3). Cost is
+#                    otherwise reported only, since it depends on the machine.
+#
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ENGINE="$HERE/../../INTUAnimationEngine"
+CC=${CC:-cc}
+REPORT=${REPORT:-regression-report.json}
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+RECORD=
+if [ "$1" = "--record" ]; then
+    RECORD=--record
+fi
+COST=
+if [ -n "$COST_TOLERANCE" ]; then
+    COST="--cost-tolerance $COST_TOLERANCE"
+fi
+
+# Each mode is a name followed by the preprocessor flags used to build the solver in that mode.
+MODES="double:
+single:-DINTU_SPRING_SOLVER_SINGLE_PRECISION"
+
+STATUS=0
+printf '{"modes":[' > "$BUILD/report.json"
+SEPARATOR=
+for MODE in $MODES; do
+    NAME=${MODE%%:*}
+    FLAGS=${MODE#*:}
+    "$CC" -std=gnu99 -O2 -Wall -Wno-unknown-pragmas $FLAGS -I"$ENGINE" -I"$ENGINE/SpringSolver" \
+        "$HERE/SpringSolverRegression.c" "$ENGINE/SpringSolver/INTUSpringSolver.c" -lm -o "$BUILD/$NAME"
+    if "$BUILD/$NAME" --corpus "$HERE/SpringSolverCorpus.txt" --baseline "$HERE/Baselines/$NAME.txt" \
+        --report "$BUILD/$NAME.json" $RECORD $COST; then
+        echo "$NAME: passed"
+    else
+        echo "$NAME: FAILED"
+        STATUS=1
+    fi
+    printf '%s' "$SEPARATOR" >> "$BUILD/report.json"
+    cat "$BUILD/$NAME.json" >> "$BUILD/report.json"
+    SEPARATOR=,
+done
+printf ']}\n' >> "$BUILD/report.json"
+cp "$BUILD/report.json" "$REPORT"
+echo "Report written to $REPORT"
+
+exit $STATUS
@@ -0,0 +1,99 @@
+//
+//  INTUAnimationCommandQueue.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUAnimationCommandQueue.h"
+#include <stdlib.h>
+
+// This is an implementation of Dmitry Vyukov's intrusive MPSC node-based queue. Producers only ever exchange the head pointer, and the
+// consumer owns the tail pointer, so no locks or compare-and-swap loops are needed.
+
+void INTUAnimationCommandQueueInit(INTUAnimationCommandQueue *queue)
+{
+    queue->stub.next = NULL;
+    __atomic_store_n(&queue->head, &queue->stub, __ATOMIC_RELAXED);
+    queue->tail = &queue->stub;
+}
+
+INTUAnimationCommand *INTUAnimationCommandCreate(INTUAnimationCommandType type, intptr_t animationID, void *payload)
+{
+    INTUAnimationCommand *command = malloc(sizeof(INTUAnimationCommand));
+    if (command) {
+        command->next = NULL;
+        command->type = type;
+        command->animationID = animationID;
+        command->payload = payload;
+    }
+    return command;
+}
+
+void INTUAnimationCommandDestroy(INTUAnimationCommand *command)
+{
+    free(command);
+}
+
+void INTUAnimationCommandQueueEnqueue(INTUAnimationCommandQueue *queue, INTUAnimationCommand *command)
+{
+    __atomic_store_n(&command->next, NULL, __ATOMIC_RELAXED);
+    INTUAnimationCommand *previous = __atomic_exchange_n(&queue->head, command, __ATOMIC_ACQ_REL);
+    // Between the exchange above and the store below, the queue is briefly disconnected. The consumer treats that as empty.
+    __atomic_store_n(&previous->next, command, __ATOMIC_RELEASE);
+}
+
+INTUAnimationCommand *INTUAnimationCommandQueueDequeue(INTUAnimationCommandQueue *queue)
+{
+    INTUAnimationCommand *tail = queue->tail;
+    INTUAnimationCommand *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    
+    if (tail == &queue->stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        // Skip past the stub.
+        queue->tail = next;
+        tail = next;
+        next = __atomic_load_n(&next->next, __ATOMIC_ACQUIRE);
+    }
+    
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    
+    INTUAnimationCommand *head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    if (tail != head) {
+        // A producer is in the middle of enqueuing; its command will be available on a later call.
+        return NULL;
+    }
+    
+    // The tail is the last command in the queue. Re-insert the stub behind it so the tail can be handed out.
+    INTUAnimationCommandQueueEnqueue(queue, &queue->stub);
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
@@ -0,0 +1,90 @@
+//
+//  INTUAnimationCommandQueue.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUAnimationCommandQueue_h
+#define INTUAnimationCommandQueue_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A lock-free, unbounded, multiple producer/single consumer queue of commands. Any thread may enqueue commands at any time, and
+// a single consumer thread (the thread that ticks the animation engine) dequeues them. Enqueuing is wait-free (one atomic exchange),
+// and dequeuing never blocks on a producer: if a producer is midway through enqueuing a command, that command is simply picked up by
+// the next call to dequeue.
+//
+// The queue is intrusive: commands are allocated by the producer and ownership passes to the consumer when they are dequeued.
+
+/** The types of commands that can be sent to the animation engine. */
+typedef enum {
+    /** Start the animation in the payload. */
+    INTUAnimationCommandTypeStart,
+    /** Cancel the animation with the animation ID. */
+    INTUAnimationCommandTypeCancel,
+    /** Retarget the animation with the animation ID to the new values in the payload. */
+    INTUAnimationCommandTypeRetarget,
+    /** Set the output quantum of the animation with the animation ID to the value in the payload. */
+    INTUAnimationCommandTypeSetOutputQuantum
+} INTUAnimationCommandType;
+
+typedef struct INTUAnimationCommand INTUAnimationCommand;
+
+struct INTUAnimationCommand {
+    /** The next command in the queue. Owned by the queue. */
+    INTUAnimationCommand *next;
+    /** The type of this command. */
+    INTUAnimationCommandType type;
+    /** The ID of the animation that this command applies to. */
+    intptr_t animationID;
+    /** An arbitrary payload for the command, such as a retained reference to a new animation. */
+    void *payload;
+};
+
+/** A multiple producer/single consumer queue of commands. The queue must be initialized with INTUAnimationCommandQueueInit() before use. */
+typedef struct {
+    /** The most recently enqueued command. Shared by all producers. */
+    INTUAnimationCommand *head;
+    /** The oldest command that has not been dequeued. Only accessed by the consumer. */
+    INTUAnimationCommand *tail;
+    /** A placeholder command that keeps the queue from ever being empty, so that producers never need to touch the tail. */
+    INTUAnimationCommand stub;
+} INTUAnimationCommandQueue;
+
+/** Initializes an empty queue. */
+void                    INTUAnimationCommandQueueInit(INTUAnimationCommandQueue *queue);
+
+/** Allocates a new command, which must either be enqueued or freed with INTUAnimationCommandDestroy(). Returns NULL if allocation fails. */
+INTUAnimationCommand *  INTUAnimationCommandCreate(INTUAnimationCommandType type, intptr_t animationID, void *payload);
+
+/** Frees a command that has been dequeued. */
+void                    INTUAnimationCommandDestroy(INTUAnimationCommand *command);
+
+/** Adds a command to the queue. Safe to call from any thread. */
+void                    INTUAnimationCommandQueueEnqueue(INTUAnimationCommandQueue *queue, INTUAnimationCommand *command);
+
+/** Removes and returns the oldest command in the queue, or NULL if there is none. Must only be called from the consumer thread. */
+INTUAnimationCommand *  INTUAnimationCommandQueueDequeue(INTUAnimationCommandQueue *queue);
+
+#endif /* INTUAnimationCommandQueue_h */
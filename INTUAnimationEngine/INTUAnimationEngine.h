@@ -28,6 +28,9 @@
 #import "INTUAnimationEngineDefines.h"
 #import "INTUEasingFunctions.h"
 #import "INTUInterpolationFunctions.h"
+#import "INTUDecaySolver.h"
+#import "INTUPath.h"
+#import "INTUAnimationLatencyHistogram.h"
 
 __INTU_ASSUME_NONNULL_BEGIN
 
@@ -41,17 +44,76 @@ typedef NSInteger INTUAnimationID;
  */
 typedef NS_OPTIONS(NSUInteger, INTUAnimationOptions) {
     /** Default, no options. */
-    INTUAnimationOptionNone         = 0,
+    INTUAnimationOptionNone               = 0,
     /** Repeat animation indefinitely until canceled. Note: completion block will only be executed if animation is canceled. */
-    INTUAnimationOptionRepeat       = 1 << 0,
+    INTUAnimationOptionRepeat             = 1 << 0,
     /** If repeat, run animation forwards and backwards. */
-    INTUAnimationOptionAutoreverse  = 1 << 1
+    INTUAnimationOptionAutoreverse        = 1 << 1,
+    /** Replace a built-in easing function with its faster approximate version, if it has one. See INTUApproximateEasingFunction(). */
+    INTUAnimationOptionApproximateEasing  = 1 << 2
 };
 
+/**
+ A block that is executed once per frame when any animations bound to the output buffer have changed.
+ 
+ @param outputBuffer  The engine's output buffer. Each bound animation owns a slot of contiguous values in this buffer, starting at the
+                      offset returned by +[INTUAnimationEngine outputOffsetForAnimationID:]. The buffer is only valid for the duration of the block.
+ @param dirtyRange    The range of values in the buffer that changed during this frame.
+ */
+typedef void (^INTUAnimationOutputHandler)(const CGFloat *outputBuffer, NSRange dirtyRange);
+
+/**
+ An animation being restored from a snapshot. Blocks cannot be stored in a snapshot, so the restore handler sets the blocks to use for
+ each restored animation.
+ */
+@interface INTURestoredAnimation : NSObject
+
+/** The ID of the animation, which is the same as the ID of the animation when the snapshot was taken. */
+@property (nonatomic, readonly) INTUAnimationID animationID;
+/** Whether the animation is bound to the output buffer. Its slot in the output buffer may be at a different offset than before. */
+@property (nonatomic, readonly, getter=isBound) BOOL bound;
+/**
+ Whether the animation used an easing function other than one of the built-in easing functions. Built-in easing functions are restored
+ automatically; a custom easing function must be set again, or the animation will have no easing function.
+ */
+@property (nonatomic, readonly) BOOL hasCustomEasing;
+
+/** The easing function of the animation. */
+@property (nonatomic, copy, __INTU_NULLABLE) INTUEasingFunction easingFunction;
+/** The animations block, for animations that were started with an animations block taking a single value. */
+@property (nonatomic, copy, __INTU_NULLABLE) void (^animations)(CGFloat progress);
+/** The animations block, for animations that were started along a path. */
+@property (nonatomic, copy, __INTU_NULLABLE) void (^pathAnimations)(CGPoint position, CGFloat angle);
+/** The completion block. */
+@property (nonatomic, copy, __INTU_NULLABLE) void (^completion)(BOOL finished);
+
+@end
+
+/**
+ A block that is executed for each animation being restored from a snapshot, to set its blocks.
+ 
+ @param animation   The animation being restored.
+ 
+ @return Whether the animation should be restored.
+ */
+typedef BOOL (^INTUAnimationRestoreHandler)(INTURestoredAnimation *animation);
+
+/**
+ A block that returns the current time of an engine's clock, in seconds.
+ */
+typedef CFTimeInterval (^INTUAnimationClock)(void);
+
 
 /**
  A friendly interface to drive custom animations using a CADisplayLink, inspired by the UIView block-based animation API. Enables interactive
  animations (normally driven by user input, such as a pan or pinch gesture) to run automatically over a given duration.
+ 
+ Animations may be started and canceled from any thread. When called from the main thread, these take effect immediately; when called from
+ any other thread, they are passed to the main thread through a lock-free queue and take effect at the start of the next frame. The
+ animations and completion blocks are always executed on the main thread.
+ 
+ The class methods all act on a shared engine. Independent engines, each with their own clock and animations, can also be created to run
+ unrelated animation workloads on other threads (see -initWithClock:).
  */
 @interface INTUAnimationEngine : NSObject
 
@@ -140,13 +202,383 @@ typedef NS_OPTIONS(NSUInteger, INTUAnimationOptions) {
                            animations:(__INTU_NULLABLE void (^)(CGFloat progress))animations
                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
 
+/**
+ Executes a block of animations multiple times over a given duration, passing in a position along a path and the angle of the path at that
+ position each time. The position moves at a constant speed along the path (before the easing function is applied), regardless of how the
+ bezier curves in the path are parameterized. The length of the path is measured once, when the animation is started.
+ 
+ @param path            The path to move along. It may contain any number of lines, quadratic and cubic bezier curves, and subpaths. The
+                        path is copied, so it may be modified or released after this method returns.
+ @param duration        The duration of the animation in seconds.
+ @param delay           The delay before starting the animation in seconds.
+ @param easingFunction  An easing function used to apply a curve to the animation. If the easing function overshoots, the position
+                        continues in a straight line beyond the ends of the path.
+ @param options         A mask of options to apply to the animation. See the constants in INTUAnimationOptions.
+ @param animations      A block which is executed at each display frame with the current position on the path, and the angle of the tangent
+                        to the path at that position (in radians, suitable for rotating a view to face along the path).
+ @param completion      A block which is executed at the completion of the animation, with the finished parameter indicating whether the animation
+                        completed without interruption (or was canceled).
+ 
+ @return A unique INTUAnimationID for this animation. Can be used to cancel the animation at a later point in time.
+ */
++ (INTUAnimationID)animateAlongPath:(CGPathRef)path
+                           duration:(NSTimeInterval)duration
+                              delay:(NSTimeInterval)delay
+                             easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                            options:(INTUAnimationOptions)options
+                         animations:(__INTU_NULLABLE void (^)(CGPoint position, CGFloat angle))animations
+                         completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+/**
+ Executes a block of animations multiple times as a position coasts to a stop after being flung, passing in the current position each time.
+ The velocity decays exponentially (as in UIScrollView), so the motion is evaluated in closed form and its resting position is known up front.
+ If the position crosses the minimum or maximum position, the motion is seamlessly handed off to a spring that pulls it back to the boundary,
+ like the rubber banding of a scroll view. If the position starts out of bounds, it springs back immediately.
+ 
+ @param position          The position at the start of the animation, in any units (for example, a content offset in points).
+ @param velocity          The velocity at the start of the animation, in units per second (for example, the velocity of a pan gesture).
+ @param decelerationRate  The factor the velocity is multiplied by every millisecond. Must be greater than zero and less than one. Use
+                          kINTUDecelerationRateNormal or kINTUDecelerationRateFast to match UIScrollView.
+ @param minimumPosition   The lowest position the animation may come to rest at. Use -CGFLOAT_MAX for no boundary.
+ @param maximumPosition   The highest position the animation may come to rest at. Use CGFLOAT_MAX for no boundary.
+ @param animations        A block which is executed at each display frame with the current position.
+ @param completion        A block which is executed when the position comes to rest, with the finished parameter indicating whether the
+                          animation completed without interruption (or was canceled).
+ 
+ @return A unique INTUAnimationID for this animation. Can be used to cancel the animation at a later point in time.
+ */
++ (INTUAnimationID)animateDecayWithPosition:(CGFloat)position
+                                   velocity:(CGFloat)velocity
+                           decelerationRate:(CGFloat)decelerationRate
+                            minimumPosition:(CGFloat)minimumPosition
+                            maximumPosition:(CGFloat)maximumPosition
+                                 animations:(__INTU_NULLABLE void (^)(CGFloat position))animations
+                                 completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+/**
+ Returns the position that a decay with the given parameters would come to rest at, ignoring any boundaries. Useful to choose a target
+ (such as the nearest page) before starting an animation.
+ */
++ (CGFloat)projectedPositionForDecayWithPosition:(CGFloat)position velocity:(CGFloat)velocity decelerationRate:(CGFloat)decelerationRate;
+
+/**
+ Returns how long a decay with the given parameters would take to come to rest, ignoring any boundaries.
+ */
++ (NSTimeInterval)projectedDurationForDecayWithVelocity:(CGFloat)velocity decelerationRate:(CGFloat)decelerationRate;
+
+/**
+ Animates a set of values from their from values to their to values over a given duration, writing them into a slot in the engine's output
+ buffer each frame instead of executing an animations block. All of the bound animations are evaluated together in a single pass over the
+ buffer, and the output handler is executed once per frame with the range of values that changed.
+ 
+ @param duration        The duration of the animation in seconds.
+ @param delay           The delay before starting the animation in seconds.
+ @param easingFunction  An easing function used to apply a curve to the animation.
+ @param options         A mask of options to apply to the animation. See the constants in INTUAnimationOptions.
+ @param fromValues      An array of channelCount values to animate from. The values are copied.
+ @param toValues        An array of channelCount values to animate to. The values are copied.
+ @param channelCount    The number of values being animated. Must be greater than zero.
+ @param completion      A block which is executed at the completion of the animation, with the finished parameter indicating whether the animation
+                        completed without interruption (or was canceled).
+ 
+ @return A unique INTUAnimationID for this animation. Can be used to cancel or retarget the animation at a later point in time.
+ */
++ (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            fromValues:(const CGFloat *)fromValues
+                              toValues:(const CGFloat *)toValues
+                          channelCount:(NSUInteger)channelCount
+                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+/**
+ Animates a set of values from their from values to their to values using the physics of a spring, writing them into a slot in the engine's
+ output buffer each frame instead of executing an animations block.
+ 
+ @param damping         The amount of friction. Must be greater than or equal to zero. Typical range: 1.0 to 30.0
+ @param stiffness       The stiffness of the spring. Must be greater than zero. Typical range: 1.0 to 500.0
+ @param mass            The amount of mass being moved by the spring. Must be greater than zero. Typical range: 0.1 to 10.0
+ @param delay           The delay before starting the animation in seconds.
+ @param fromValues      An array of channelCount values to animate from. The values are copied.
+ @param toValues        An array of channelCount values to animate to. The values are copied.
+ @param channelCount    The number of values being animated. Must be greater than zero.
+ @param completion      A block which is executed at the completion of the animation, with the finished parameter indicating whether the animation
+                        completed without interruption (or was canceled).
+ 
+ @return A unique INTUAnimationID for this animation. Can be used to cancel or retarget the animation at a later point in time.
+ */
++ (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           fromValues:(const CGFloat *)fromValues
+                             toValues:(const CGFloat *)toValues
+                         channelCount:(NSUInteger)channelCount
+                           completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+/**
+ Restarts the currently active animation with the given animation ID from its current values towards new to values, without interrupting it
+ or executing its completion block. Only animations bound to the output buffer can be retargeted; the channel count must match the count the
+ animation was started with. If called from a thread other than the main thread, the animation will be retargeted at the start of the next frame.
+ */
++ (void)retargetAnimationWithID:(INTUAnimationID)animationID toValues:(const CGFloat *)toValues channelCount:(NSUInteger)channelCount;
+
+/**
+ Returns the offset of the slot in the output buffer for the currently active animation with the given animation ID, or NSNotFound if there
+ is no active animation bound to the output buffer with that ID. Must be called from the main thread.
+ */
++ (NSUInteger)outputOffsetForAnimationID:(INTUAnimationID)animationID;
+
+/**
+ Sets the output quantum of the currently active animation with the given animation ID: the minimum amount that its output must change by
+ for its animations block to be executed (and its output buffer values to be written) again. Frames where the output has changed by less
+ than the quantum since it was last delivered are skipped, which avoids redundant work such as layout while a spring settles by fractions
+ of a pixel. The final output of an animation that finishes is always delivered, and so is the last skipped output of an animation that is
+ canceled (to its animations block, before its completion block). The quantum is in the units of the value passed to the animations block:
+ progress for duration and spring animations (for example, 1 / (screen scale * distance in points) for an animation that moves a view),
+ position for decay animations, and points along the path for path animations. The default is 0.0, which never skips. If called from a
+ thread other than the main thread, the output quantum will be set at the start of the next frame.
+ */
++ (void)setOutputQuantum:(CGFloat)outputQuantum forAnimationWithID:(INTUAnimationID)animationID;
+
+/**
+ Returns the number of animations whose output was skipped during the last frame because it changed by less than their output quantum.
+ Must be called from the main thread.
+ */
++ (NSUInteger)elidedCallbackCount;
+
+/**
+ Sets the block that is executed once per frame when any values in the output buffer have changed. Must be called from the main thread.
+ */
++ (void)setOutputHandler:(__INTU_NULLABLE INTUAnimationOutputHandler)outputHandler;
+
+/**
+ Sets whether every animation added to the engine from now on uses the approximate version of its built-in easing function, as if it had
+ been started with INTUAnimationOptionApproximateEasing. The approximate easing functions are within 2e-6 of the exact curves, and several
+ times faster to evaluate. Animations that are already running are not affected. The default is NO. Must be called from the main thread.
+ */
++ (void)setUsesApproximateEasing:(BOOL)usesApproximateEasing;
+
+/**
+ Sets whether the engine evaluates every animation at the predicted time that each frame will be presented onscreen (the display link's
+ target timestamp), instead of the time the display link fires. A frame is presented at least one refresh after it is prepared, so by
+ default motion onscreen always lags one refresh behind the animation's timeline (by a varying amount on variable refresh rate displays);
+ targeting the presentation time removes that lag.
+ 
+ To guard against a stale or wrong prediction, a frame is never evaluated more than 50 ms ahead of the current time. Since springs can only
+ be advanced forwards, a frame is also never evaluated at an earlier time than the previous frame; if the presentation time of a frame is
+ earlier than the last prediction (or targeting is turned off), time is held until the clock catches up. The default is NO. Must be
+ called from the main thread.
+ */
++ (void)setTargetsPresentationTime:(BOOL)targetsPresentationTime;
+
+/**
+ Returns a summary of the presentation lag of the frames since the engine was created or the lag was last reset. The presentation lag of a
+ frame is its predicted presentation time (the display link's target timestamp), minus the time its animations were evaluated at: how far
+ the motion onscreen trails the animations' timeline, assuming the frame is presented when predicted. It does not measure when frames are
+ actually presented, so it does not include dropped frames. Without presentation time targeting, it is about one refresh interval. With
+ targeting, it is zero except where the 50 ms limit clamps a frame (positive) or time is held for a late frame (negative). Must be called
+ from the main thread.
+ */
++ (INTUAnimationLatencySummary)presentationLagSummary;
+
+/**
+ Discards the presentation lag recorded so far. Must be called from the main thread.
+ */
++ (void)resetPresentationLag;
+
 /**
  Cancels the currently active animation with the given animation ID.
  The completion block for the animation will be executed, with the finished parameter equal to NO.
  If there is no active animation for the given ID, this method will do nothing.
+ If called from a thread other than the main thread, the animation will be canceled at the start of the next frame.
  */
 + (void)cancelAnimationWithID:(INTUAnimationID)animationID;
 
+/**
+ Returns a compact binary snapshot of the complete state of every active animation: its timing, options, easing function, output values,
+ path, and spring solver state. Restoring the snapshot with +[INTUAnimationEngine restoreAnimationsFromSnapshot:handler:] continues each
+ animation along exactly the same trajectory from the point the snapshot was taken, for example after the app is suspended or a view
+ hierarchy is rebuilt. The snapshot can only be restored by the same build of the app. Must be called from the main thread.
+ 
+ @return The snapshot, or nil if there was not enough memory to create it.
+ */
++ (__INTU_NULLABLE NSData *)snapshotActiveAnimations;
+
+/**
+ Restores the animations in a snapshot, keeping their animation IDs. Any animation in the snapshot with the same ID as an active animation
+ is skipped. Must be called from the main thread.
+ 
+ @param snapshot    A snapshot from +[INTUAnimationEngine snapshotActiveAnimations].
+ @param handler     A block that is executed for each animation to set its animations and completion blocks, and returns whether to restore
+                    it. If nil, every animation is restored without blocks (which is useful for animations bound to the output buffer).
+ 
+ @return The number of animations restored, or NSNotFound if the snapshot is invalid (in which case no animations are restored).
+ */
++ (NSUInteger)restoreAnimationsFromSnapshot:(NSData *)snapshot handler:(__INTU_NULLABLE INTUAnimationRestoreHandler)handler;
+
+/**
+ Starts recording timestamped spans for each phase of every frame (reading the clock, checking delays, easing, spring integration,
+ animations blocks, completion blocks, and adding and removing animations) into a ring buffer. Once the buffer is full, the oldest
+ events are overwritten. Recording does not lock or allocate memory. Any previously recorded trace is discarded.
+ Must be called from the main thread.
+ 
+ @param capacity    The number of events the ring buffer holds (rounded up to a power of two). Each frame records a few events, plus a few
+                    events per active animation.
+ 
+ @return Whether the ring buffer could be allocated.
+ */
++ (BOOL)startFrameTraceWithCapacity:(NSUInteger)capacity;
+
+/**
+ Stops recording the frame trace. The events recorded so far are kept, and can still be exported. Must be called from the main thread.
+ */
++ (void)stopFrameTrace;
+
+/**
+ Returns the events in the frame trace as UTF-8 encoded Chrome trace event JSON, which can be opened in chrome://tracing or Perfetto,
+ or nil if no trace has been started. May be called from any thread, including while the trace is recording, but not at the same time
+ as +[INTUAnimationEngine startFrameTraceWithCapacity:].
+ */
++ (__INTU_NULLABLE NSData *)frameTraceJSON;
+
+#pragma mark Engine Instances
+
+/**
+ Returns the shared engine that the class methods act on, which is driven by a display link on the main thread.
+ */
++ (instancetype)sharedInstance;
+
+/**
+ Unavailable. The shared engine is the only engine driven by a display link, since the display link retains its engine for as long as it
+ runs. Use +sharedInstance, or create an independent engine with -initWithClock:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Creates an independent engine, with its own clock, animations, output buffer, output handler, frame trace and animation IDs. It shares no
+ mutable state with any other engine (including the shared engine), so engines on different threads run in parallel without contention.
+ 
+ The engine is not driven by a display link. Instead, the thread that creates it is the engine's thread, which advances it by calling -tick
+ (for example, once per frame of an offscreen render loop or background simulation). Animations may be started, canceled and retargeted
+ from any thread, as with the shared engine; when called from a thread other than the engine's thread, they take effect at the start of
+ the next tick. The animations, completion and output handler blocks are executed on the engine's thread, during -tick.
+ 
+ @param clock   A block that returns the current time of the engine, in seconds. It is read once per tick, and whenever an animation is
+                started or retargeted (on the thread that starts it, so it must be thread safe if animations are started from other threads).
+                Return a simulated time to advance faster or slower than real time. If nil, CACurrentMediaTime() is used.
+ */
+- (instancetype)initWithClock:(__INTU_NULLABLE INTUAnimationClock)clock;
+
+/**
+ Applies any commands submitted from other threads, then advances every active animation to the current time of the engine's clock,
+ executing their animations blocks, the output handler, and the completion blocks of any animations that finish. Must be called on the
+ engine's thread, and only for engines created with -initWithClock:.
+ */
+- (void)tick;
+
+/**
+ Equivalent to -tick, for a frame that will be presented at the given time (in the time base of the engine's clock), for example the
+ target timestamp of a display link that drives an offscreen renderer. The frame's presentation lag is recorded, and if the engine
+ targets the presentation time, the animations are evaluated at it (see +[INTUAnimationEngine setTargetsPresentationTime:]).
+ */
+- (void)tickWithPresentationTime:(CFTimeInterval)presentationTime;
+
+// The following methods are equivalent to the class methods of the same name, but act on this engine rather than the shared engine.
+// Animation IDs are only unique within one engine. Methods that must be called from the main thread for the shared engine must instead
+// be called from the engine's thread.
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                            animations:(__INTU_NULLABLE void (^)(CGFloat percentage))animations
+                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                            animations:(__INTU_NULLABLE void (^)(CGFloat progress))animations
+                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            animations:(__INTU_NULLABLE void (^)(CGFloat progress))animations
+                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           animations:(__INTU_NULLABLE void (^)(CGFloat progress))animations
+                           completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateAlongPath:(CGPathRef)path
+                           duration:(NSTimeInterval)duration
+                              delay:(NSTimeInterval)delay
+                             easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                            options:(INTUAnimationOptions)options
+                         animations:(__INTU_NULLABLE void (^)(CGPoint position, CGFloat angle))animations
+                         completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateDecayWithPosition:(CGFloat)position
+                                   velocity:(CGFloat)velocity
+                           decelerationRate:(CGFloat)decelerationRate
+                            minimumPosition:(CGFloat)minimumPosition
+                            maximumPosition:(CGFloat)maximumPosition
+                                 animations:(__INTU_NULLABLE void (^)(CGFloat position))animations
+                                 completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(__INTU_NULLABLE INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            fromValues:(const CGFloat *)fromValues
+                              toValues:(const CGFloat *)toValues
+                          channelCount:(NSUInteger)channelCount
+                            completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           fromValues:(const CGFloat *)fromValues
+                             toValues:(const CGFloat *)toValues
+                         channelCount:(NSUInteger)channelCount
+                           completion:(__INTU_NULLABLE void (^)(BOOL finished))completion;
+
+- (void)retargetAnimationWithID:(INTUAnimationID)animationID toValues:(const CGFloat *)toValues channelCount:(NSUInteger)channelCount;
+
+- (NSUInteger)outputOffsetForAnimationID:(INTUAnimationID)animationID;
+
+- (void)setOutputQuantum:(CGFloat)outputQuantum forAnimationWithID:(INTUAnimationID)animationID;
+
+- (NSUInteger)elidedCallbackCount;
+
+- (void)setOutputHandler:(__INTU_NULLABLE INTUAnimationOutputHandler)outputHandler;
+
+- (void)setUsesApproximateEasing:(BOOL)usesApproximateEasing;
+
+- (void)setTargetsPresentationTime:(BOOL)targetsPresentationTime;
+
+- (INTUAnimationLatencySummary)presentationLagSummary;
+
+- (void)resetPresentationLag;
+
+- (void)cancelAnimationWithID:(INTUAnimationID)animationID;
+
+- (__INTU_NULLABLE NSData *)snapshotActiveAnimations;
+
+- (NSUInteger)restoreAnimationsFromSnapshot:(NSData *)snapshot handler:(__INTU_NULLABLE INTUAnimationRestoreHandler)handler;
+
+- (BOOL)startFrameTraceWithCapacity:(NSUInteger)capacity;
+
+- (void)stopFrameTrace;
+
+- (__INTU_NULLABLE NSData *)frameTraceJSON;
+
 @end
 
 __INTU_ASSUME_NONNULL_END
@@ -26,7 +26,170 @@
 
 #import "INTUAnimationEngine.h"
 #import <QuartzCore/QuartzCore.h>
+#include <pthread.h>
 #include "INTUSpringSolver.h"
+#include "INTUDecaySolver.h"
+#include "INTUAnimationCommandQueue.h"
+#include "INTUAnimationOutputBuffer.h"
+#include "INTUAnimationTrace.h"
+#include "INTUPath.h"
+
+
+#pragma mark - Snapshot Format
+
+// A snapshot of the engine is a header followed by one record for each active animation. Each record starts with an
+// INTUAnimationSnapshotRecord, followed by the state specific to the kind of animation (written and read by each class in turn,
+// starting with INTUAnimation). Snapshots are stored in the native byte order and memory layout, since they are only meant to be
+// restored by the same build of the app (for example, after the app is suspended or a view hierarchy is rebuilt); the header records
+// the sizes that the layout depends on, so a snapshot from an incompatible build is rejected instead of being misread.
+
+static const uint32_t kINTUAnimationSnapshotMagic = 0x494E5441; // "INTA"
+static const uint16_t kINTUAnimationSnapshotVersion = 2;
+
+// The easing index stored for an easing function that is not one of the built-in easing functions.
+static const uint16_t kINTUAnimationSnapshotCustomEasing = UINT16_MAX;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t floatSize;      // sizeof(CGFloat)
+    uint8_t scalarSize;     // sizeof(INTUSpringScalar)
+    uint32_t dimensions;    // kINTUSpringSolverDimensions
+    uint32_t count;         // The number of records that follow.
+} INTUAnimationSnapshotHeader;
+
+typedef NS_ENUM(uint8_t, INTUAnimationSnapshotKind) {
+    INTUAnimationSnapshotKindTween,
+    INTUAnimationSnapshotKindSpring,
+    INTUAnimationSnapshotKindDecay,
+    INTUAnimationSnapshotKindPath
+};
+
+typedef struct {
+    int64_t animationID;
+    double duration;
+    double delay;
+    /** The time elapsed since the animation started (including its delay), as of the last frame. */
+    double elapsedTime;
+    double outputQuantum;
+    /** The size of the whole record, including the state that follows this struct. */
+    uint32_t size;
+    /** The number of output buffer channels. If not zero, the from and to values (each channelCount CGFloats) follow this struct. */
+    uint32_t channelCount;
+    /** The index of the easing function (see INTUEasingFunctionSnapshotIndex()). */
+    uint16_t easing;
+    /** An INTUAnimationSnapshotKind. */
+    uint8_t kind;
+    /** INTUAnimationOptions. */
+    uint8_t options;
+} INTUAnimationSnapshotRecord;
+
+typedef struct {
+    double damping;
+    double stiffness;
+    double mass;
+    /** Whether an INTUSpringSolverSnapshot follows this struct. */
+    uint64_t hasSolver;
+} INTUAnimationSnapshotSpring;
+
+typedef struct {
+    INTUDecay decay;
+    double decayDuration;
+    double handoffTime;
+    double handoffPosition;
+    double threshold;
+} INTUAnimationSnapshotDecay;
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} INTUAnimationSnapshotWriter;
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+} INTUAnimationSnapshotReader;
+
+/** Appends the given bytes to the snapshot, growing its buffer as needed. If allocation fails, the writer is marked as failed. */
+static void INTUAnimationSnapshotWrite(INTUAnimationSnapshotWriter *writer, const void *data, size_t size)
+{
+    if (writer->failed) {
+        return;
+    }
+    if (writer->length + size > writer->capacity) {
+        size_t newCapacity = writer->capacity ? writer->capacity : 1024;
+        while (newCapacity < writer->length + size) {
+            newCapacity *= 2;
+        }
+        uint8_t *newBytes = realloc(writer->bytes, newCapacity);
+        if (newBytes == NULL) {
+            writer->failed = true;
+            return;
+        }
+        writer->bytes = newBytes;
+        writer->capacity = newCapacity;
+    }
+    memcpy(writer->bytes + writer->length, data, size);
+    writer->length += size;
+}
+
+/** Reads the given number of bytes from the snapshot. Returns NO (without reading anything) if there are not enough bytes left. */
+static BOOL INTUAnimationSnapshotRead(INTUAnimationSnapshotReader *reader, void *data, size_t size)
+{
+    if (size > reader->length - reader->offset) {
+        return NO;
+    }
+    memcpy(data, reader->bytes + reader->offset, size);
+    reader->offset += size;
+    return YES;
+}
+
+/** The built-in easing functions, in the order they are identified by in snapshots (starting from 1; 0 means no easing function). New
+ easing functions are only ever appended, so that the indices in existing snapshots stay valid. */
+static INTUEasingFunction __strong *const kINTUSnapshotEasingFunctions[] = {
+    &INTULinear,
+    &INTUEaseInSine, &INTUEaseOutSine, &INTUEaseInOutSine,
+    &INTUEaseInQuadratic, &INTUEaseOutQuadratic, &INTUEaseInOutQuadratic,
+    &INTUEaseInCubic, &INTUEaseOutCubic, &INTUEaseInOutCubic,
+    &INTUEaseInQuartic, &INTUEaseOutQuartic, &INTUEaseInOutQuartic,
+    &INTUEaseInQuintic, &INTUEaseOutQuintic, &INTUEaseInOutQuintic,
+    &INTUEaseInExponential, &INTUEaseOutExponential, &INTUEaseInOutExponential,
+    &INTUEaseInCircular, &INTUEaseOutCircular, &INTUEaseInOutCircular,
+    &INTUEaseInBack, &INTUEaseOutBack, &INTUEaseInOutBack,
+    &INTUEaseInElastic, &INTUEaseOutElastic, &INTUEaseInOutElastic,
+    &INTUEaseInBounce, &INTUEaseOutBounce, &INTUEaseInOutBounce,
+    &INTUEaseInSineApproximate, &INTUEaseOutSineApproximate, &INTUEaseInOutSineApproximate,
+    &INTUEaseInExponentialApproximate, &INTUEaseOutExponentialApproximate, &INTUEaseInOutExponentialApproximate,
+    &INTUEaseInBackApproximate, &INTUEaseOutBackApproximate, &INTUEaseInOutBackApproximate,
+    &INTUEaseInElasticApproximate, &INTUEaseOutElasticApproximate, &INTUEaseInOutElasticApproximate
+};
+static const uint16_t kINTUSnapshotEasingFunctionCount = sizeof(kINTUSnapshotEasingFunctions) / sizeof(kINTUSnapshotEasingFunctions[0]);
+
+/** Returns the index that identifies the given easing function in a snapshot. */
+static uint16_t INTUEasingFunctionSnapshotIndex(INTUEasingFunction easingFunction)
+{
+    if (easingFunction == nil) {
+        return 0;
+    }
+    for (uint16_t i = 0; i < kINTUSnapshotEasingFunctionCount; i++) {
+        if (easingFunction == *kINTUSnapshotEasingFunctions[i]) {
+            return i + 1;
+        }
+    }
+    return kINTUAnimationSnapshotCustomEasing;
+}
+
+/** Returns the built-in easing function with the given index in a snapshot, or nil if there is none. */
+static INTUEasingFunction INTUEasingFunctionAtSnapshotIndex(uint16_t index)
+{
+    if (index == 0 || index > kINTUSnapshotEasingFunctionCount) {
+        return nil;
+    }
+    return *kINTUSnapshotEasingFunctions[index - 1];
+}
 
 
 #pragma mark - INTUAnimation
@@ -38,7 +201,8 @@ __INTU_ASSUME_NONNULL_BEGIN
  */
 @interface INTUAnimation : NSObject
 
-@property (nonatomic, readonly) INTUAnimationID animationID;
+/** Assigned by the engine when the animation is submitted, from that engine's ID space. */
+@property (nonatomic, assign) INTUAnimationID animationID;
 
 // These properties correspond directly to the parameters when creating a new animation with INTUAnimationEngine.
 @property (nonatomic, assign) NSTimeInterval duration;
@@ -50,6 +214,32 @@ __INTU_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL autoreverse; // INTUAnimationOptionAutoreverse
 
 @property (nonatomic, assign) CFTimeInterval startTime;
+/** The time of the current frame, set by the engine before each tick so that the clock is only read once per frame. */
+@property (nonatomic, assign) CFTimeInterval frameTime;
+/** The frame trace to record spans into, set by the engine before each tick, or NULL if tracing is disabled. Not retained. */
+@property (nonatomic, assign, __INTU_NULLABLE) INTUAnimationTrace *trace;
+
+// These properties are only used when the animation is bound to the engine's output buffer, instead of (or as well as) executing an
+// animations block. The from and to values are arrays of outputChannelCount CGFloats.
+@property (nonatomic, assign) NSUInteger outputChannelCount;
+@property (nonatomic, strong, __INTU_NULLABLE) NSData *fromValues;
+@property (nonatomic, strong, __INTU_NULLABLE) NSData *toValues;
+/** The output buffer that this animation writes its progress into, set by the engine when the animation is added. Not retained. */
+@property (nonatomic, assign, __INTU_NULLABLE) INTUAnimationOutputBuffer *outputBuffer;
+/** The offset of this animation's slot in the output buffer. */
+@property (nonatomic, assign) NSUInteger outputOffset;
+
+/**
+ The minimum change in the output value (see -outputValueForProgress:) for the output to be emitted again. Frames where the output has
+ changed by less than this are skipped: the animations block is not executed, and the output buffer is not written. Zero to never skip.
+ */
+@property (nonatomic, assign) CGFloat outputQuantum;
+/** The output value that was last emitted, or NAN if none has been emitted since the animation started (or was retargeted). */
+@property (nonatomic, assign) CGFloat lastOutputValue;
+/** Whether the most recent progress was not emitted because of the output quantum. */
+@property (nonatomic, assign) BOOL hasPendingOutput;
+/** The most recent progress, if it was not emitted. */
+@property (nonatomic, assign) CGFloat pendingProgress;
 
 /** Computed. Calculated based on animation start time, delay, and duration. */
 @property (nonatomic, readonly) CGFloat percentComplete;
@@ -57,8 +247,19 @@ __INTU_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) CGFloat progress;
 
 - (void)applyOptions:(INTUAnimationOptions)options;
-- (void)tick;
+- (NSTimeInterval)remainingDelay;
+- (BOOL)isDelayed;
+- (CGFloat)tracedProgress;
+- (CGFloat)outputValueForProgress:(CGFloat)progress;
+- (BOOL)tick;
+- (void)emitProgress:(CGFloat)progress;
+- (void)flushPendingOutput;
 - (void)complete:(BOOL)finished;
+- (BOOL)retargetToValues:(NSData *)toValues time:(CFTimeInterval)time;
+
++ (INTUAnimationSnapshotKind)snapshotKind;
+- (void)writeSnapshot:(INTUAnimationSnapshotWriter *)writer;
+- (BOOL)readSnapshot:(INTUAnimationSnapshotReader *)reader time:(CFTimeInterval)time;
 
 @end
 
@@ -66,23 +267,11 @@ __INTU_ASSUME_NONNULL_END
 
 @implementation INTUAnimation
 
-static INTUAnimationID _nextAnimationID = 0;
-
-/**
- Returns the next animation ID (unique within the lifetime of the application).
- */
-+ (INTUAnimationID)getNextAnimationID
-{
-    NSAssert([NSThread isMainThread], @"INTUAnimationEngine should only be called from the main thread.");
-    _nextAnimationID++;
-    return _nextAnimationID;
-}
-
 - (id)init
 {
     self = [super init];
     if (self) {
-        _animationID = [[self class] getNextAnimationID];
+        _lastOutputValue = NAN;
     }
     return self;
 }
@@ -94,6 +283,9 @@ static INTUAnimationID _nextAnimationID = 0;
 {
     self.repeat = options & INTUAnimationOptionRepeat;
     self.autoreverse = options & INTUAnimationOptionAutoreverse;
+    if (options & INTUAnimationOptionApproximateEasing) {
+        self.easingFunction = INTUApproximateEasingFunction(self.easingFunction);
+    }
 }
 
 /**
@@ -102,7 +294,18 @@ static INTUAnimationID _nextAnimationID = 0;
  */
 - (NSTimeInterval)remainingDelay
 {
-    return MAX(0.0, self.delay - (CACurrentMediaTime() - self.startTime));
+    return MAX(0.0, self.delay - (self.frameTime - self.startTime));
+}
+
+/**
+ Whether the animation is still waiting for its delay to elapse, recording the check in the frame trace.
+ */
+- (BOOL)isDelayed
+{
+    double traceStart = INTUAnimationTraceBegin(self.trace);
+    BOOL delayed = [self remainingDelay] > FLT_EPSILON;
+    INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseDelayCheck, self.animationID, traceStart, 0);
+    return delayed;
 }
 
 /**
@@ -111,7 +314,7 @@ static INTUAnimationID _nextAnimationID = 0;
  */
 - (CGFloat)percentComplete
 {
-    CGFloat percent = (CACurrentMediaTime() - self.startTime - self.delay) / self.duration;
+    CGFloat percent = (self.frameTime - self.startTime - self.delay) / self.duration;
     if (self.repeat) {
         NSUInteger repeatCount = (NSUInteger)percent;
         percent = percent - repeatCount;
@@ -136,16 +339,76 @@ static INTUAnimationID _nextAnimationID = 0;
 }
 
 /**
- Triggers one execution of the animations block, passing in the current progress.
+ The progress of this animation, recording the calculation (including any spring integration it triggers) in the frame trace.
  */
-- (void)tick
+- (CGFloat)tracedProgress
 {
-    if ([self remainingDelay] > FLT_EPSILON) {
-        return;
+    double traceStart = INTUAnimationTraceBegin(self.trace);
+    CGFloat progress = self.progress;
+    INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseEasing, self.animationID, traceStart, 0);
+    return progress;
+}
+
+/**
+ The value that the output quantum is compared against for the given progress, in the units of the value passed to the animations block.
+ */
+- (CGFloat)outputValueForProgress:(CGFloat)progress
+{
+    return progress;
+}
+
+/**
+ Emits the current progress, unless the output has changed by less than the output quantum since it was last emitted. Returns NO if the
+ output was skipped.
+ */
+- (BOOL)tick
+{
+    if ([self isDelayed]) {
+        return YES;
     }
     
+    CGFloat progress = [self tracedProgress];
+    if (self.outputQuantum > 0.0) {
+        CGFloat outputValue = [self outputValueForProgress:progress];
+        // If no output has been emitted yet, the last output value is NAN, so the comparison is false and the output is emitted.
+        if (fabs(outputValue - self.lastOutputValue) < self.outputQuantum) {
+            self.pendingProgress = progress;
+            self.hasPendingOutput = YES;
+            return NO;
+        }
+        self.lastOutputValue = outputValue;
+    }
+    self.hasPendingOutput = NO;
+    [self emitProgress:progress];
+    return YES;
+}
+
+/**
+ Triggers one execution of the animations block, passing in the given progress. If the animation is bound to an output buffer, the
+ progress is also stored in the output buffer.
+ */
+- (void)emitProgress:(CGFloat)progress
+{
     if (self.animations) {
-        self.animations(self.progress);
+        double traceStart = INTUAnimationTraceBegin(self.trace);
+        self.animations(progress);
+        INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseCallback, self.animationID, traceStart, 0);
+    }
+    if (self.outputBuffer) {
+        INTUAnimationOutputBufferSetProgress(self.outputBuffer, self.outputOffset, self.outputChannelCount, progress);
+    }
+}
+
+/**
+ Emits the most recent progress if it was skipped because of the output quantum, so that the final output of a finished or canceled
+ animation is exact.
+ */
+- (void)flushPendingOutput
+{
+    if (self.hasPendingOutput) {
+        self.hasPendingOutput = NO;
+        self.lastOutputValue = [self outputValueForProgress:self.pendingProgress];
+        [self emitProgress:self.pendingProgress];
     }
 }
 
@@ -159,6 +422,88 @@ static INTUAnimationID _nextAnimationID = 0;
     }
 }
 
+/**
+ Restarts this animation at the given time, from its current output values towards the new to values. Only valid for animations bound
+ to an output buffer. Returns whether the animation was retargeted.
+ */
+- (BOOL)retargetToValues:(NSData *)toValues time:(CFTimeInterval)time
+{
+    if (self.outputBuffer == NULL || [toValues length] != self.outputChannelCount * sizeof(CGFloat)) {
+        return NO;
+    }
+    self.fromValues = [NSData dataWithBytes:self.outputBuffer->values + self.outputOffset length:[toValues length]];
+    self.toValues = toValues;
+    INTUAnimationOutputBufferSetValues(self.outputBuffer, self.outputOffset, self.outputChannelCount, [self.fromValues bytes], [self.toValues bytes]);
+    self.startTime = time;
+    self.frameTime = time;
+    self.delay = 0.0;
+    self.lastOutputValue = NAN;
+    self.hasPendingOutput = NO;
+    return YES;
+}
+
+#pragma mark Snapshots
+
++ (INTUAnimationSnapshotKind)snapshotKind
+{
+    return INTUAnimationSnapshotKindTween;
+}
+
+/**
+ Appends this animation's state to the snapshot. Subclasses call super first, then append their own state.
+ */
+- (void)writeSnapshot:(INTUAnimationSnapshotWriter *)writer
+{
+    INTUAnimationSnapshotRecord record;
+    memset(&record, 0, sizeof(record));
+    record.animationID = self.animationID;
+    record.duration = self.duration;
+    record.delay = self.delay;
+    record.elapsedTime = self.frameTime - self.startTime;
+    record.outputQuantum = self.outputQuantum;
+    record.channelCount = (uint32_t)self.outputChannelCount;
+    record.easing = INTUEasingFunctionSnapshotIndex(self.easingFunction);
+    record.kind = [[self class] snapshotKind];
+    record.options = (self.repeat ? INTUAnimationOptionRepeat : 0) | (self.autoreverse ? INTUAnimationOptionAutoreverse : 0);
+    INTUAnimationSnapshotWrite(writer, &record, sizeof(record));
+    if (self.outputChannelCount > 0) {
+        INTUAnimationSnapshotWrite(writer, [self.fromValues bytes], [self.fromValues length]);
+        INTUAnimationSnapshotWrite(writer, [self.toValues bytes], [self.toValues length]);
+    }
+}
+
+/**
+ Restores this animation's state from the snapshot, so that it continues from the given time exactly as it would have continued from
+ the last frame before the snapshot was taken. Subclasses call super first, then read their own state. Returns whether the state was valid.
+ */
+- (BOOL)readSnapshot:(INTUAnimationSnapshotReader *)reader time:(CFTimeInterval)time
+{
+    INTUAnimationSnapshotRecord record;
+    if (!INTUAnimationSnapshotRead(reader, &record, sizeof(record)) || !(record.elapsedTime >= 0.0) || !(record.outputQuantum >= 0.0)) {
+        return NO;
+    }
+    _animationID = (INTUAnimationID)record.animationID;
+    self.duration = record.duration;
+    self.delay = record.delay;
+    self.outputQuantum = record.outputQuantum;
+    self.easingFunction = INTUEasingFunctionAtSnapshotIndex(record.easing);
+    [self applyOptions:record.options];
+    self.startTime = time - record.elapsedTime;
+    self.frameTime = time;
+    if (record.channelCount > 0) {
+        NSUInteger length = record.channelCount * sizeof(CGFloat);
+        NSMutableData *fromValues = [NSMutableData dataWithLength:length];
+        NSMutableData *toValues = [NSMutableData dataWithLength:length];
+        if (!INTUAnimationSnapshotRead(reader, [fromValues mutableBytes], length) || !INTUAnimationSnapshotRead(reader, [toValues mutableBytes], length)) {
+            return NO;
+        }
+        self.outputChannelCount = record.channelCount;
+        self.fromValues = fromValues;
+        self.toValues = toValues;
+    }
+    return YES;
+}
+
 @end
 
 
@@ -191,28 +536,70 @@ static INTUAnimationID _nextAnimationID = 0;
 - (CGFloat)progress
 {
     // Start the mass "pulled back" to -1.0 so that the spring pulls it towards the solver's resting state (the zero position)
-    const double initialPosition[kINTUSpringSolverDimensions] = {-1.0};
-    const double initialVelocity[kINTUSpringSolverDimensions] = {0.0};
+    const INTUSpringScalar initialPosition[kINTUSpringSolverDimensions] = {-1.0};
+    const INTUSpringScalar initialVelocity[kINTUSpringSolverDimensions] = {0.0};
     
     if (!self.context) {
         self.context = INTUSpringSolverContextCreate(self.stiffness, self.damping, self.mass, initialPosition, initialVelocity);
     }
     
-    double currentAnimationTime = CACurrentMediaTime() - self.startTime - self.delay;
+    double currentAnimationTime = self.frameTime - self.startTime - self.delay;
+    double traceStart = INTUAnimationTraceBegin(self.trace);
     INTUSpringState newState = INTUAdvanceSpringSolver(self.context, currentAnimationTime);
+    INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseSpringIntegration, self.animationID, traceStart, INTUSpringSolverGetLastStepCount(self.context));
     // Subtract the initial position from the spring's new position, as we're working inverted in the solver
     return newState.position[0] - initialPosition[0];
 }
 
-- (void)tick
+- (BOOL)retargetToValues:(NSData *)toValues time:(CFTimeInterval)time
 {
-    if ([self remainingDelay] > FLT_EPSILON) {
-        return;
+    if (![super retargetToValues:toValues time:time]) {
+        return NO;
     }
-    
-    if (self.animations) {
-        self.animations(self.progress);
+    // Restart the spring from its initial state.
+    INTUSpringSolverContextDestroy(_context);
+    _context = nil;
+    return YES;
+}
+
++ (INTUAnimationSnapshotKind)snapshotKind
+{
+    return INTUAnimationSnapshotKindSpring;
+}
+
+- (void)writeSnapshot:(INTUAnimationSnapshotWriter *)writer
+{
+    [super writeSnapshot:writer];
+    INTUAnimationSnapshotSpring spring = { self.damping, self.stiffness, self.mass, self.context != nil };
+    INTUAnimationSnapshotWrite(writer, &spring, sizeof(spring));
+    if (self.context) {
+        INTUSpringSolverSnapshot solver;
+        INTUSpringSolverContextGetSnapshot(self.context, &solver);
+        INTUAnimationSnapshotWrite(writer, &solver, sizeof(solver));
+    }
+}
+
+- (BOOL)readSnapshot:(INTUAnimationSnapshotReader *)reader time:(CFTimeInterval)time
+{
+    INTUAnimationSnapshotSpring spring;
+    if (![super readSnapshot:reader time:time] || !INTUAnimationSnapshotRead(reader, &spring, sizeof(spring))) {
+        return NO;
     }
+    self.damping = spring.damping;
+    self.stiffness = spring.stiffness;
+    self.mass = spring.mass;
+    if (spring.hasSolver) {
+        INTUSpringSolverSnapshot solver;
+        if (!INTUAnimationSnapshotRead(reader, &solver, sizeof(solver))) {
+            return NO;
+        }
+        INTUSpringSolverContextDestroy(_context);
+        _context = INTUSpringSolverContextCreateWithSnapshot(&solver);
+        if (_context == nil) {
+            return NO;
+        }
+    }
+    return YES;
 }
 
 - (void)dealloc
@@ -224,8 +611,276 @@ static INTUAnimationID _nextAnimationID = 0;
 @end
 
 
+#pragma mark - INTUDecayAnimation
+
+// The fraction of the total distance travelled that is considered close enough to be at rest. This matches the threshold factor used by
+// the spring solver.
+static const double kINTUDecayThresholdFactor = 0.0001;
+
+// The spring used to pull the position back to a boundary once a decay crosses it. Close to critically damped, so that it settles on the
+// boundary with at most a barely noticeable overshoot.
+static const CGFloat kINTUDecayBoundaryDamping = 26.0;
+static const CGFloat kINTUDecayBoundaryStiffness = 170.0;
+static const CGFloat kINTUDecayBoundaryMass = 1.0;
+
+/**
+ A decay (fling) animation. The position decays towards its resting position in closed form, and if it crosses the minimum or maximum
+ position, the motion is handed off to a spring (inherited from INTUSpringAnimation) that pulls it back to the boundary.
+ */
+@interface INTUDecayAnimation : INTUSpringAnimation
+
+@property (nonatomic, assign) INTUDecay decay;
+/** The duration of the decay, if it does not cross a boundary. */
+@property (nonatomic, assign) NSTimeInterval decayDuration;
+/** The time at which the motion is handed off to the spring, or INFINITY if the decay does not cross a boundary. */
+@property (nonatomic, assign) NSTimeInterval handoffTime;
+/** The boundary that the spring pulls the position back to. */
+@property (nonatomic, assign) CGFloat handoffPosition;
+/** The convergence threshold, relative to the total distance travelled. */
+@property (nonatomic, assign) double threshold;
+
+- (instancetype)initWithPosition:(CGFloat)position
+                        velocity:(CGFloat)velocity
+                decelerationRate:(CGFloat)decelerationRate
+                 minimumPosition:(CGFloat)minimumPosition
+                 maximumPosition:(CGFloat)maximumPosition;
+
+@end
+
+@implementation INTUDecayAnimation
+
+- (instancetype)initWithPosition:(CGFloat)position
+                        velocity:(CGFloat)velocity
+                decelerationRate:(CGFloat)decelerationRate
+                 minimumPosition:(CGFloat)minimumPosition
+                 maximumPosition:(CGFloat)maximumPosition
+{
+    self = [super init];
+    if (self) {
+        self.damping = kINTUDecayBoundaryDamping;
+        self.stiffness = kINTUDecayBoundaryStiffness;
+        self.mass = kINTUDecayBoundaryMass;
+        
+        _decay = INTUDecayMake(position, velocity, decelerationRate);
+        _handoffTime = INFINITY;
+        double restingPosition = INTUDecayRestingPosition(_decay);
+        if (position < minimumPosition || position > maximumPosition) {
+            // Already out of bounds (for example, after the user dragged past the edge): hand off to the spring immediately.
+            _handoffTime = 0.0;
+            _handoffPosition = (position < minimumPosition) ? minimumPosition : maximumPosition;
+        } else if (restingPosition < minimumPosition || restingPosition > maximumPosition) {
+            _handoffPosition = (restingPosition < minimumPosition) ? minimumPosition : maximumPosition;
+            _handoffTime = INTUDecayTimeToReachPosition(_decay, _handoffPosition);
+        }
+        
+        // The threshold scales with the distance the animation travels, which includes the distance to the boundary only if it is
+        // handed off to the spring. An unbounded decay therefore lasts exactly +projectedDurationForDecayWithVelocity:decelerationRate:.
+        double distance = fabs(restingPosition - position);
+        if (isfinite(_handoffTime)) {
+            distance = MAX(distance, fabs(_handoffPosition - position));
+        }
+        _threshold = distance * kINTUDecayThresholdFactor;
+        _decayDuration = INTUDecayDuration(_decay, _threshold);
+    }
+    return self;
+}
+
+- (BOOL)hasConverged
+{
+    if (isinf(self.handoffTime)) {
+        return self.frameTime - self.startTime - self.delay >= self.decayDuration;
+    }
+    return [super hasConverged];
+}
+
+- (CGFloat)progress
+{
+    double currentAnimationTime = MAX(0.0, self.frameTime - self.startTime - self.delay);
+    if (currentAnimationTime < self.handoffTime) {
+        return INTUDecayPositionAtTime(self.decay, currentAnimationTime);
+    }
+    
+    if (!self.context) {
+        // The spring works relative to the boundary, starting with the position and velocity of the decay at the moment it crossed it.
+        const INTUSpringScalar initialPosition[kINTUSpringSolverDimensions] = {INTUDecayPositionAtTime(self.decay, self.handoffTime) - self.handoffPosition};
+        const INTUSpringScalar initialVelocity[kINTUSpringSolverDimensions] = {INTUDecayVelocityAtTime(self.decay, self.handoffTime)};
+        self.context = INTUSpringSolverContextCreateWithThreshold(self.stiffness, self.damping, self.mass, initialPosition, initialVelocity, self.threshold);
+    }
+    double traceStart = INTUAnimationTraceBegin(self.trace);
+    INTUSpringState newState = INTUAdvanceSpringSolver(self.context, currentAnimationTime - self.handoffTime);
+    INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseSpringIntegration, self.animationID, traceStart, INTUSpringSolverGetLastStepCount(self.context));
+    return self.handoffPosition + newState.position[0];
+}
+
++ (INTUAnimationSnapshotKind)snapshotKind
+{
+    return INTUAnimationSnapshotKindDecay;
+}
+
+- (void)writeSnapshot:(INTUAnimationSnapshotWriter *)writer
+{
+    [super writeSnapshot:writer];
+    INTUAnimationSnapshotDecay decay = { self.decay, self.decayDuration, self.handoffTime, self.handoffPosition, self.threshold };
+    INTUAnimationSnapshotWrite(writer, &decay, sizeof(decay));
+}
+
+- (BOOL)readSnapshot:(INTUAnimationSnapshotReader *)reader time:(CFTimeInterval)time
+{
+    INTUAnimationSnapshotDecay decay;
+    if (![super readSnapshot:reader time:time] || !INTUAnimationSnapshotRead(reader, &decay, sizeof(decay))) {
+        return NO;
+    }
+    self.decay = decay.decay;
+    self.decayDuration = decay.decayDuration;
+    self.handoffTime = decay.handoffTime;
+    self.handoffPosition = decay.handoffPosition;
+    self.threshold = decay.threshold;
+    return YES;
+}
+
+@end
+
+
+#pragma mark - INTUPathAnimation
+
+/**
+ An animation that moves along a path at a constant speed, passing the position and tangent angle on the path to its animations block.
+ */
+@interface INTUPathAnimation : INTUAnimation
+
+@property (nonatomic, copy, __INTU_NULLABLE) void (^pathAnimations)(CGPoint, CGFloat);
+
+// Note: This path ref is not managed by ARC. It is destroyed in -[dealloc].
+@property (nonatomic, assign) INTUPathRef path;
+
+@end
+
+@implementation INTUPathAnimation
+
+/**
+ The distance along the path, so that the output quantum is in points.
+ */
+- (CGFloat)outputValueForProgress:(CGFloat)progress
+{
+    return progress * INTUPathGetLength(self.path);
+}
+
+/**
+ Triggers one execution of the path animations block, passing in the position and angle on the path at the given progress.
+ */
+- (void)emitProgress:(CGFloat)progress
+{
+    CGPoint position;
+    CGFloat angle;
+    double traceStart = INTUAnimationTraceBegin(self.trace);
+    INTUPathEvaluate(self.path, progress, &position, &angle);
+    INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseEasing, self.animationID, traceStart, 0);
+    if (self.pathAnimations) {
+        traceStart = INTUAnimationTraceBegin(self.trace);
+        self.pathAnimations(position, angle);
+        INTUAnimationTraceEnd(self.trace, INTUAnimationTracePhaseCallback, self.animationID, traceStart, 0);
+    }
+}
+
++ (INTUAnimationSnapshotKind)snapshotKind
+{
+    return INTUAnimationSnapshotKindPath;
+}
+
+- (void)writeSnapshot:(INTUAnimationSnapshotWriter *)writer
+{
+    [super writeSnapshot:writer];
+    uint64_t segmentCount = INTUPathGetSegmentCount(self.path);
+    INTUAnimationSnapshotWrite(writer, &segmentCount, sizeof(segmentCount));
+    for (size_t i = 0; i < segmentCount; i++) {
+        CGPoint points[4];
+        INTUPathGetSegment(self.path, i, points);
+        INTUAnimationSnapshotWrite(writer, points, sizeof(points));
+    }
+}
+
+- (BOOL)readSnapshot:(INTUAnimationSnapshotReader *)reader time:(CFTimeInterval)time
+{
+    uint64_t segmentCount;
+    if (![super readSnapshot:reader time:time] ||
+        !INTUAnimationSnapshotRead(reader, &segmentCount, sizeof(segmentCount)) ||
+        segmentCount > (reader->length - reader->offset) / (4 * sizeof(CGPoint))) {
+        return NO;
+    }
+    INTUPathRef path = INTUPathCreate();
+    if (path == NULL) {
+        return NO;
+    }
+    CGPoint endPoint = CGPointZero;
+    for (uint64_t i = 0; i < segmentCount; i++) {
+        CGPoint points[4];
+        INTUAnimationSnapshotRead(reader, points, sizeof(points));
+        if (i == 0 || !CGPointEqualToPoint(points[0], endPoint)) {
+            INTUPathMoveToPoint(path, points[0]);
+        }
+        INTUPathAddCurveToPoint(path, points[1], points[2], points[3]);
+        endPoint = points[3];
+    }
+    INTUPathGetLength(path);
+    INTUPathDestroy(_path);
+    _path = path;
+    return YES;
+}
+
+- (void)dealloc
+{
+    INTUPathDestroy(_path);
+    _path = nil;
+}
+
+@end
+
+/** Adds one element of a CGPath to an INTUPath. Used with CGPathApply(). */
+static void INTUPathAddCGPathElement(void *info, const CGPathElement *element)
+{
+    INTUPathRef path = info;
+    switch (element->type) {
+        case kCGPathElementMoveToPoint:
+            INTUPathMoveToPoint(path, element->points[0]);
+            break;
+        case kCGPathElementAddLineToPoint:
+            INTUPathAddLineToPoint(path, element->points[0]);
+            break;
+        case kCGPathElementAddQuadCurveToPoint:
+            INTUPathAddQuadCurveToPoint(path, element->points[0], element->points[1]);
+            break;
+        case kCGPathElementAddCurveToPoint:
+            INTUPathAddCurveToPoint(path, element->points[0], element->points[1], element->points[2]);
+            break;
+        case kCGPathElementCloseSubpath:
+            INTUPathCloseSubpath(path);
+            break;
+    }
+}
+
+
+#pragma mark - INTURestoredAnimation
+
+@interface INTURestoredAnimation ()
+
+@property (nonatomic, assign) INTUAnimationID animationID;
+@property (nonatomic, assign, getter=isBound) BOOL bound;
+@property (nonatomic, assign) BOOL hasCustomEasing;
+
+@end
+
+@implementation INTURestoredAnimation
+
+@end
+
+
 #pragma mark - INTUAnimationEngine
 
+// The furthest ahead of the current time that a frame is evaluated when targeting its presentation time. A longer lead means the predicted
+// presentation time is stale or wrong (for example, after a stall), and springs in particular would be pushed far into a future that a
+// retarget or cancel from the next input event may never let happen.
+static const CFTimeInterval kINTUMaximumPresentationLead = 0.05;
+
 @interface INTUAnimationEngine ()
 
 // A dictionary that associates animation IDs to active animations. It is in the format:
@@ -234,9 +889,45 @@ static INTUAnimationID _nextAnimationID = 0;
 
 @property (nonatomic, strong) CADisplayLink *displayLink;
 
+@property (nonatomic, copy, __INTU_NULLABLE) INTUAnimationOutputHandler outputHandler;
+
+- (instancetype)initWithDisplayLink;
+
 @end
 
 @implementation INTUAnimationEngine
+{
+    // The engine's clock, or nil to use CACurrentMediaTime().
+    INTUAnimationClock _clock;
+    // Whether the engine is driven by a display link on the main thread. Otherwise, it is ticked manually on the thread that created it.
+    bool _usesDisplayLink;
+    // The thread that created the engine, which is the engine's thread if it is not driven by a display link.
+    pthread_t _thread;
+    // The last animation ID that was assigned. Animation IDs are unique within an engine, but not across engines.
+    INTUAnimationID _nextAnimationID;
+    // Commands (to start or cancel animations) submitted from threads other than the engine's thread, waiting to be processed.
+    INTUAnimationCommandQueue _commandQueue;
+    // Whether a block to process the command queue has been dispatched to the main queue and has not run yet.
+    bool _drainScheduled;
+    // Whether the display link is paused. Read by enqueueCommandWithType:animationID:payload: from any thread, so accessed atomically.
+    bool _displayLinkPaused;
+    // The buffer that animations bound to output values write into.
+    INTUAnimationOutputBuffer _outputBuffer;
+    // The frame trace, which is only recorded into while _tracing is true. Its buffer is kept after tracing stops so it can be exported.
+    INTUAnimationTrace _trace;
+    bool _tracing;
+    // The number of animations whose output was skipped during the last frame because it changed by less than their output quantum.
+    NSUInteger _elidedCallbackCount;
+    // Whether built-in easing functions are replaced with their approximate versions when animations are added.
+    bool _usesApproximateEasing;
+    // Whether animations are evaluated at the predicted presentation time of each frame, instead of the current time.
+    bool _targetsPresentationTime;
+    // The time the last frame was evaluated at if that was ahead of the current time, otherwise -INFINITY. Frame times never go back
+    // before it.
+    CFTimeInterval _lastPredictedFrameTime;
+    // The presentation lag of each frame: its predicted presentation time, minus the time its animations were evaluated at.
+    INTUAnimationLatencyHistogram _presentationLag;
+}
 
 static id _sharedInstance;
 
@@ -244,7 +935,7 @@ static id _sharedInstance;
 {
     static dispatch_once_t _onceToken;
     dispatch_once(&_onceToken, ^{
-        _sharedInstance = [[self alloc] init];
+        _sharedInstance = [[self alloc] initWithDisplayLink];
     });
     return _sharedInstance;
 }
@@ -254,11 +945,10 @@ static id _sharedInstance;
                             animations:(void (^)(CGFloat percentage))animations
                             completion:(void (^)(BOOL finished))completion
 {
-    return [self animateWithDuration:duration
-                               delay:delay
-                              easing:nil
-                          animations:animations
-                          completion:completion];
+    return [[self sharedInstance] animateWithDuration:duration
+                                                delay:delay
+                                           animations:animations
+                                           completion:completion];
 }
 
 + (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
@@ -267,12 +957,11 @@ static id _sharedInstance;
                             animations:(void (^)(CGFloat progress))animations
                             completion:(void (^)(BOOL finished))completion
 {
-    return [self animateWithDuration:duration
-                               delay:delay
-                              easing:easingFunction
-                             options:INTUAnimationOptionNone
-                          animations:animations
-                          completion:completion];
+    return [[self sharedInstance] animateWithDuration:duration
+                                                delay:delay
+                                               easing:easingFunction
+                                           animations:animations
+                                           completion:completion];
 }
 
 + (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
@@ -282,15 +971,12 @@ static id _sharedInstance;
                             animations:(void (^)(CGFloat progress))animations
                             completion:(void (^)(BOOL finished))completion
 {
-    INTUAnimation *animation = [INTUAnimation new];
-    animation.duration = duration;
-    animation.delay = delay;
-    animation.easingFunction = easingFunction;
-    animation.animations = animations;
-    animation.completion = completion;
-    [animation applyOptions:options];
-    [[self sharedInstance] addAnimation:animation];
-    return animation.animationID;
+    return [[self sharedInstance] animateWithDuration:duration
+                                                delay:delay
+                                               easing:easingFunction
+                                              options:options
+                                           animations:animations
+                                           completion:completion];
 }
 
 + (INTUAnimationID)animateWithDamping:(CGFloat)damping
@@ -300,8 +986,338 @@ static id _sharedInstance;
                            animations:(void (^)(CGFloat progress))animations
                            completion:(void (^)(BOOL finished))completion
 {
-    if (damping < 0.0 || stiffness <= 0.0 || mass <= 0.0) {
-        NSAssert(damping >= 0.0, @"INTUAnimationEngine damping must be greater than or equal to zero.");
+    return [[self sharedInstance] animateWithDamping:damping
+                                           stiffness:stiffness
+                                                mass:mass
+                                               delay:delay
+                                          animations:animations
+                                          completion:completion];
+}
+
++ (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            fromValues:(const CGFloat *)fromValues
+                              toValues:(const CGFloat *)toValues
+                          channelCount:(NSUInteger)channelCount
+                            completion:(void (^)(BOOL finished))completion
+{
+    return [[self sharedInstance] animateWithDuration:duration
+                                                delay:delay
+                                               easing:easingFunction
+                                              options:options
+                                           fromValues:fromValues
+                                             toValues:toValues
+                                         channelCount:channelCount
+                                           completion:completion];
+}
+
++ (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           fromValues:(const CGFloat *)fromValues
+                             toValues:(const CGFloat *)toValues
+                         channelCount:(NSUInteger)channelCount
+                           completion:(void (^)(BOOL finished))completion
+{
+    return [[self sharedInstance] animateWithDamping:damping
+                                           stiffness:stiffness
+                                                mass:mass
+                                               delay:delay
+                                          fromValues:fromValues
+                                            toValues:toValues
+                                        channelCount:channelCount
+                                          completion:completion];
+}
+
++ (INTUAnimationID)animateDecayWithPosition:(CGFloat)position
+                                   velocity:(CGFloat)velocity
+                           decelerationRate:(CGFloat)decelerationRate
+                            minimumPosition:(CGFloat)minimumPosition
+                            maximumPosition:(CGFloat)maximumPosition
+                                 animations:(void (^)(CGFloat position))animations
+                                 completion:(void (^)(BOOL finished))completion
+{
+    return [[self sharedInstance] animateDecayWithPosition:position
+                                                  velocity:velocity
+                                          decelerationRate:decelerationRate
+                                           minimumPosition:minimumPosition
+                                           maximumPosition:maximumPosition
+                                                animations:animations
+                                                completion:completion];
+}
+
++ (CGFloat)projectedPositionForDecayWithPosition:(CGFloat)position velocity:(CGFloat)velocity decelerationRate:(CGFloat)decelerationRate
+{
+    return INTUDecayRestingPosition(INTUDecayMake(position, velocity, decelerationRate));
+}
+
++ (NSTimeInterval)projectedDurationForDecayWithVelocity:(CGFloat)velocity decelerationRate:(CGFloat)decelerationRate
+{
+    INTUDecay decay = INTUDecayMake(0.0, velocity, decelerationRate);
+    return INTUDecayDuration(decay, fabs(INTUDecayRestingPosition(decay)) * kINTUDecayThresholdFactor);
+}
+
++ (INTUAnimationID)animateAlongPath:(CGPathRef)path
+                           duration:(NSTimeInterval)duration
+                              delay:(NSTimeInterval)delay
+                             easing:(INTUEasingFunction)easingFunction
+                            options:(INTUAnimationOptions)options
+                         animations:(void (^)(CGPoint position, CGFloat angle))animations
+                         completion:(void (^)(BOOL finished))completion
+{
+    return [[self sharedInstance] animateAlongPath:path
+                                          duration:duration
+                                             delay:delay
+                                            easing:easingFunction
+                                           options:options
+                                        animations:animations
+                                        completion:completion];
+}
+
++ (void)retargetAnimationWithID:(INTUAnimationID)animationID toValues:(const CGFloat *)toValues channelCount:(NSUInteger)channelCount
+{
+    [[self sharedInstance] retargetAnimationWithID:animationID toValues:toValues channelCount:channelCount];
+}
+
++ (NSUInteger)outputOffsetForAnimationID:(INTUAnimationID)animationID
+{
+    return [[self sharedInstance] outputOffsetForAnimationID:animationID];
+}
+
++ (void)setOutputQuantum:(CGFloat)outputQuantum forAnimationWithID:(INTUAnimationID)animationID
+{
+    [[self sharedInstance] setOutputQuantum:outputQuantum forAnimationWithID:animationID];
+}
+
++ (NSUInteger)elidedCallbackCount
+{
+    return [[self sharedInstance] elidedCallbackCount];
+}
+
++ (void)setOutputHandler:(INTUAnimationOutputHandler)outputHandler
+{
+    [[self sharedInstance] setOutputHandler:outputHandler];
+}
+
++ (void)setUsesApproximateEasing:(BOOL)usesApproximateEasing
+{
+    [[self sharedInstance] setUsesApproximateEasing:usesApproximateEasing];
+}
+
++ (void)setTargetsPresentationTime:(BOOL)targetsPresentationTime
+{
+    [[self sharedInstance] setTargetsPresentationTime:targetsPresentationTime];
+}
+
++ (INTUAnimationLatencySummary)presentationLagSummary
+{
+    return [[self sharedInstance] presentationLagSummary];
+}
+
++ (void)resetPresentationLag
+{
+    [[self sharedInstance] resetPresentationLag];
+}
+
++ (BOOL)startFrameTraceWithCapacity:(NSUInteger)capacity
+{
+    return [[self sharedInstance] startFrameTraceWithCapacity:capacity];
+}
+
++ (void)stopFrameTrace
+{
+    [[self sharedInstance] stopFrameTrace];
+}
+
++ (NSData *)frameTraceJSON
+{
+    return [[self sharedInstance] frameTraceJSON];
+}
+
++ (NSData *)snapshotActiveAnimations
+{
+    return [[self sharedInstance] snapshotActiveAnimations];
+}
+
++ (NSUInteger)restoreAnimationsFromSnapshot:(NSData *)snapshot handler:(INTUAnimationRestoreHandler)handler
+{
+    return [[self sharedInstance] restoreAnimationsFromSnapshot:snapshot handler:handler];
+}
+
++ (void)cancelAnimationWithID:(INTUAnimationID)animationID
+{
+    [[self sharedInstance] cancelAnimationWithID:animationID];
+}
+
+#pragma mark Engine Instances
+
+/**
+ Creates an engine driven by a display link on the main thread. Only used for the shared engine: the display link retains the engine and
+ is never invalidated, so the engine lives for the rest of the process.
+ */
+- (instancetype)initWithDisplayLink
+{
+    self = [self initWithClock:nil];
+    if (self) {
+        _usesDisplayLink = true;
+        __atomic_store_n(&_displayLinkPaused, true, __ATOMIC_SEQ_CST);
+        void (^setUpDisplayLink)(void) = ^{
+            _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+            _displayLink.paused = YES;
+            [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes]; // NSRunLoopCommonModes will cause the display link to fire even during scroll view scrolling, etc
+        };
+        if ([NSThread isMainThread]) {
+            setUpDisplayLink();
+        } else {
+            // The main run loop must only be modified from the main thread. Any commands submitted before this block runs will be
+            // processed after it, since the main queue is serial.
+            dispatch_async(dispatch_get_main_queue(), setUpDisplayLink);
+        }
+    }
+    return self;
+}
+
+- (instancetype)initWithClock:(INTUAnimationClock)clock
+{
+    self = [super init];
+    if (self) {
+        _clock = [clock copy];
+        _thread = pthread_self();
+        _lastPredictedFrameTime = -INFINITY;
+        INTUAnimationLatencyHistogramReset(&_presentationLag);
+        INTUAnimationCommandQueueInit(&_commandQueue);
+        INTUAnimationOutputBufferInit(&_outputBuffer);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // Release the payloads of any commands that were never processed.
+    INTUAnimationCommand *command;
+    while ((command = INTUAnimationCommandQueueDequeue(&_commandQueue))) {
+        if (command->payload) {
+            (void)(__bridge_transfer id)command->payload;
+        }
+        INTUAnimationCommandDestroy(command);
+    }
+    for (INTUAnimation *animation in [_activeAnimations objectEnumerator]) {
+        animation.outputBuffer = NULL;
+    }
+    INTUAnimationOutputBufferDestroy(&_outputBuffer);
+    INTUAnimationTraceDestroy(&_trace);
+}
+
+- (void)tick
+{
+    NSAssert(!_usesDisplayLink, @"INTUAnimationEngine engines driven by a display link cannot be ticked manually.");
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine should only be ticked from the engine's thread.");
+    [self tickActiveAnimationsWithPresentationTime:NAN];
+}
+
+- (void)tickWithPresentationTime:(CFTimeInterval)presentationTime
+{
+    NSAssert(!_usesDisplayLink, @"INTUAnimationEngine engines driven by a display link cannot be ticked manually.");
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine should only be ticked from the engine's thread.");
+    [self tickActiveAnimationsWithPresentationTime:presentationTime];
+}
+
+/**
+ Whether the current thread is the engine's thread: the main thread if the engine is driven by a display link, otherwise the thread that
+ created the engine.
+ */
+- (BOOL)isOnEngineThread
+{
+    return _usesDisplayLink ? [NSThread isMainThread] : pthread_equal(pthread_self(), _thread) != 0;
+}
+
+/**
+ Returns the current time of the engine's clock. Called from any thread that submits animations.
+ */
+- (CFTimeInterval)currentTime
+{
+    return _clock ? _clock() : CACurrentMediaTime();
+}
+
+/**
+ Returns the next animation ID (unique within the lifetime of this engine). Safe to call from any thread.
+ */
+- (INTUAnimationID)nextAnimationID
+{
+    return __atomic_add_fetch(&_nextAnimationID, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ Ensures that animation IDs up to and including the given ID will not be returned by -nextAnimationID, for example because animations
+ with those IDs have been restored from a snapshot. Safe to call from any thread.
+ */
+- (void)reserveAnimationIDsThroughID:(INTUAnimationID)animationID
+{
+    INTUAnimationID currentID = __atomic_load_n(&_nextAnimationID, __ATOMIC_RELAXED);
+    while (currentID < animationID &&
+           !__atomic_compare_exchange_n(&_nextAnimationID, &currentID, animationID, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // currentID has been updated to the latest value; try again.
+    }
+}
+
+#pragma mark Animations
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                            animations:(void (^)(CGFloat percentage))animations
+                            completion:(void (^)(BOOL finished))completion
+{
+    return [self animateWithDuration:duration
+                               delay:delay
+                              easing:nil
+                          animations:animations
+                          completion:completion];
+}
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(INTUEasingFunction)easingFunction
+                            animations:(void (^)(CGFloat progress))animations
+                            completion:(void (^)(BOOL finished))completion
+{
+    return [self animateWithDuration:duration
+                               delay:delay
+                              easing:easingFunction
+                             options:INTUAnimationOptionNone
+                          animations:animations
+                          completion:completion];
+}
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            animations:(void (^)(CGFloat progress))animations
+                            completion:(void (^)(BOOL finished))completion
+{
+    INTUAnimation *animation = [INTUAnimation new];
+    animation.duration = duration;
+    animation.delay = delay;
+    animation.easingFunction = easingFunction;
+    animation.animations = animations;
+    animation.completion = completion;
+    [animation applyOptions:options];
+    [self submitAnimation:animation];
+    return animation.animationID;
+}
+
+- (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           animations:(void (^)(CGFloat progress))animations
+                           completion:(void (^)(BOOL finished))completion
+{
+    if (damping < 0.0 || stiffness <= 0.0 || mass <= 0.0) {
+        NSAssert(damping >= 0.0, @"INTUAnimationEngine damping must be greater than or equal to zero.");
         NSAssert(stiffness > 0.0, @"INTUAnimationEngine stiffness must be greater than zero.");
         NSAssert(mass > 0.0, @"INTUAnimationEngine mass must be greater than zero.");
         return NSNotFound;
@@ -313,69 +1329,709 @@ static id _sharedInstance;
     animation.delay = delay;
     animation.animations = animations;
     animation.completion = completion;
-    [[self sharedInstance] addAnimation:animation];
+    [self submitAnimation:animation];
+    return animation.animationID;
+}
+
+- (INTUAnimationID)animateWithDuration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                easing:(INTUEasingFunction)easingFunction
+                               options:(INTUAnimationOptions)options
+                            fromValues:(const CGFloat *)fromValues
+                              toValues:(const CGFloat *)toValues
+                          channelCount:(NSUInteger)channelCount
+                            completion:(void (^)(BOOL finished))completion
+{
+    if (channelCount == 0 || fromValues == NULL || toValues == NULL) {
+        NSAssert(channelCount > 0, @"INTUAnimationEngine channel count must be greater than zero.");
+        return NSNotFound;
+    }
+    INTUAnimation *animation = [INTUAnimation new];
+    animation.duration = duration;
+    animation.delay = delay;
+    animation.easingFunction = easingFunction;
+    animation.completion = completion;
+    [animation applyOptions:options];
+    [self bindAnimation:animation fromValues:fromValues toValues:toValues channelCount:channelCount];
+    [self submitAnimation:animation];
+    return animation.animationID;
+}
+
+- (INTUAnimationID)animateWithDamping:(CGFloat)damping
+                            stiffness:(CGFloat)stiffness
+                                 mass:(CGFloat)mass
+                                delay:(NSTimeInterval)delay
+                           fromValues:(const CGFloat *)fromValues
+                             toValues:(const CGFloat *)toValues
+                         channelCount:(NSUInteger)channelCount
+                           completion:(void (^)(BOOL finished))completion
+{
+    if (damping < 0.0 || stiffness <= 0.0 || mass <= 0.0 || channelCount == 0 || fromValues == NULL || toValues == NULL) {
+        NSAssert(damping >= 0.0, @"INTUAnimationEngine damping must be greater than or equal to zero.");
+        NSAssert(stiffness > 0.0, @"INTUAnimationEngine stiffness must be greater than zero.");
+        NSAssert(mass > 0.0, @"INTUAnimationEngine mass must be greater than zero.");
+        NSAssert(channelCount > 0, @"INTUAnimationEngine channel count must be greater than zero.");
+        return NSNotFound;
+    }
+    INTUSpringAnimation *animation = [INTUSpringAnimation new];
+    animation.damping = damping;
+    animation.stiffness = stiffness;
+    animation.mass = mass;
+    animation.delay = delay;
+    animation.completion = completion;
+    [self bindAnimation:animation fromValues:fromValues toValues:toValues channelCount:channelCount];
+    [self submitAnimation:animation];
+    return animation.animationID;
+}
+
+- (INTUAnimationID)animateDecayWithPosition:(CGFloat)position
+                                   velocity:(CGFloat)velocity
+                           decelerationRate:(CGFloat)decelerationRate
+                            minimumPosition:(CGFloat)minimumPosition
+                            maximumPosition:(CGFloat)maximumPosition
+                                 animations:(void (^)(CGFloat position))animations
+                                 completion:(void (^)(BOOL finished))completion
+{
+    if (decelerationRate <= 0.0 || decelerationRate >= 1.0 || minimumPosition > maximumPosition) {
+        NSAssert(decelerationRate > 0.0 && decelerationRate < 1.0, @"INTUAnimationEngine deceleration rate must be greater than zero and less than one.");
+        NSAssert(minimumPosition <= maximumPosition, @"INTUAnimationEngine minimum position must be less than or equal to the maximum position.");
+        return NSNotFound;
+    }
+    INTUDecayAnimation *animation = [[INTUDecayAnimation alloc] initWithPosition:position
+                                                                        velocity:velocity
+                                                                decelerationRate:decelerationRate
+                                                                 minimumPosition:minimumPosition
+                                                                 maximumPosition:maximumPosition];
+    animation.animations = animations;
+    animation.completion = completion;
+    [self submitAnimation:animation];
+    return animation.animationID;
+}
+
+- (INTUAnimationID)animateAlongPath:(CGPathRef)path
+                           duration:(NSTimeInterval)duration
+                              delay:(NSTimeInterval)delay
+                             easing:(INTUEasingFunction)easingFunction
+                            options:(INTUAnimationOptions)options
+                         animations:(void (^)(CGPoint position, CGFloat angle))animations
+                         completion:(void (^)(BOOL finished))completion
+{
+    INTUPathRef pathRef = path ? INTUPathCreate() : NULL;
+    if (pathRef == NULL) {
+        NSAssert(path, @"INTUAnimationEngine path must not be NULL.");
+        return NSNotFound;
+    }
+    CGPathApply(path, pathRef, INTUPathAddCGPathElement);
+    // Measure the path up front, so that the length table is not built during the first frame.
+    INTUPathGetLength(pathRef);
+    
+    INTUPathAnimation *animation = [INTUPathAnimation new];
+    animation.path = pathRef;
+    animation.duration = duration;
+    animation.delay = delay;
+    animation.easingFunction = easingFunction;
+    animation.pathAnimations = animations;
+    animation.completion = completion;
+    [animation applyOptions:options];
+    [self submitAnimation:animation];
     return animation.animationID;
 }
 
 /**
- Cancels the currently active animation with the given animation ID. The completion block for the animation will be executed, with the finished parameter equal to NO.
+ Copies the from and to values into the animation, so that it will be bound to a slot in the output buffer when it is added.
  */
-+ (void)cancelAnimationWithID:(INTUAnimationID)animationID
+- (void)bindAnimation:(INTUAnimation *)animation fromValues:(const CGFloat *)fromValues toValues:(const CGFloat *)toValues channelCount:(NSUInteger)channelCount
 {
-    NSAssert([NSThread isMainThread], @"INTUAnimationEngine should only be called from the main thread.");
-    [[self sharedInstance] removeAnimationWithID:animationID didFinish:NO];
+    animation.outputChannelCount = channelCount;
+    animation.fromValues = [NSData dataWithBytes:fromValues length:channelCount * sizeof(CGFloat)];
+    animation.toValues = [NSData dataWithBytes:toValues length:channelCount * sizeof(CGFloat)];
 }
 
-- (id)init
+- (void)retargetAnimationWithID:(INTUAnimationID)animationID toValues:(const CGFloat *)toValues channelCount:(NSUInteger)channelCount
 {
-    self = [super init];
-    if (self) {
-        _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(tickActiveAnimations)];
-        _displayLink.paused = YES;
-        [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes]; // NSRunLoopCommonModes will cause the display link to fire even during scroll view scrolling, etc
+    if (toValues == NULL) {
+        return;
+    }
+    NSData *values = [NSData dataWithBytes:toValues length:channelCount * sizeof(CGFloat)];
+    [self submitRetargetForAnimationID:animationID toValues:values];
+}
+
+- (NSUInteger)outputOffsetForAnimationID:(INTUAnimationID)animationID
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine output buffer should only be accessed from the engine's thread.");
+    INTUAnimation *animation = self.activeAnimations[@(animationID)];
+    if (animation.outputBuffer == NULL) {
+        return NSNotFound;
+    }
+    return animation.outputOffset;
+}
+
+- (void)setOutputQuantum:(CGFloat)outputQuantum forAnimationWithID:(INTUAnimationID)animationID
+{
+    [self submitOutputQuantum:outputQuantum forAnimationID:animationID];
+}
+
+- (void)cancelAnimationWithID:(INTUAnimationID)animationID
+{
+    [self submitCancelForAnimationID:animationID];
+}
+
+/**
+ Assigns the given animation an ID and starts it. If called from the engine's thread, the animation is added immediately; otherwise, it
+ is sent through the command queue and added at the start of the next frame.
+ */
+- (void)submitAnimation:(INTUAnimation *)animation
+{
+    animation.animationID = [self nextAnimationID];
+    animation.startTime = [self currentTime];
+    animation.frameTime = animation.startTime;
+    if ([self isOnEngineThread]) {
+        // Process any pending commands first, so that commands from all threads are applied in the order they were submitted.
+        [self drainCommandQueue];
+        [self addAnimation:animation];
+    } else {
+        [self enqueueCommandWithType:INTUAnimationCommandTypeStart animationID:animation.animationID payload:(__bridge_retained void *)animation];
+    }
+}
+
+/**
+ Cancels the animation with the given ID. If called from the engine's thread, the animation is canceled immediately; otherwise, the
+ cancel is sent through the command queue and applied at the start of the next frame.
+ */
+- (void)submitCancelForAnimationID:(INTUAnimationID)animationID
+{
+    if ([self isOnEngineThread]) {
+        [self drainCommandQueue];
+        [self removeAnimationWithID:animationID didFinish:NO];
+    } else {
+        [self enqueueCommandWithType:INTUAnimationCommandTypeCancel animationID:animationID payload:NULL];
+    }
+}
+
+/**
+ Retargets the animation with the given ID. If called from the engine's thread, the animation is retargeted immediately; otherwise, the
+ retarget is sent through the command queue and applied at the start of the next frame.
+ */
+- (void)submitRetargetForAnimationID:(INTUAnimationID)animationID toValues:(NSData *)toValues
+{
+    if ([self isOnEngineThread]) {
+        [self drainCommandQueue];
+        [self retargetAnimationWithID:animationID toValues:toValues];
+    } else {
+        [self enqueueCommandWithType:INTUAnimationCommandTypeRetarget animationID:animationID payload:(__bridge_retained void *)toValues];
+    }
+}
+
+/**
+ Sets the output quantum of the animation with the given ID. If called from the engine's thread, the output quantum is set immediately;
+ otherwise, it is sent through the command queue and set at the start of the next frame.
+ */
+- (void)submitOutputQuantum:(CGFloat)outputQuantum forAnimationID:(INTUAnimationID)animationID
+{
+    if ([self isOnEngineThread]) {
+        [self drainCommandQueue];
+        [self applyOutputQuantum:outputQuantum toAnimationWithID:animationID];
+    } else {
+        [self enqueueCommandWithType:INTUAnimationCommandTypeSetOutputQuantum animationID:animationID payload:(__bridge_retained void *)@(outputQuantum)];
     }
-    return self;
+}
+
+/**
+ Adds a command to the command queue. Safe to call from any thread. If the engine is driven by a display link and it is paused, nothing
+ would otherwise process the queue, so this also schedules a block on the main queue to do so. While the display link is running, the
+ queue is processed at the start of every frame, as it is at the start of every tick for other engines.
+ */
+- (void)enqueueCommandWithType:(INTUAnimationCommandType)type animationID:(INTUAnimationID)animationID payload:(void *)payload
+{
+    INTUAnimationCommand *command = INTUAnimationCommandCreate(type, animationID, payload);
+    if (command == NULL) {
+        if (payload) {
+            // Balance the retain of the payload, as the command will never be processed.
+            (void)(__bridge_transfer id)payload;
+        }
+        return;
+    }
+    INTUAnimationCommandQueueEnqueue(&_commandQueue, command);
+    
+    if (_usesDisplayLink) {
+        // Pairs with the store in setDisplayLinkPaused: so that either this thread sees the display link paused, or the drain scheduled
+        // after pausing it sees this command.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&_displayLinkPaused, __ATOMIC_SEQ_CST)) {
+            [self scheduleCommandQueueDrain];
+        }
+    }
+}
+
+/**
+ Dispatches a block to the main queue to process the command queue, unless one is already outstanding.
+ */
+- (void)scheduleCommandQueueDrain
+{
+    if (__atomic_exchange_n(&_drainScheduled, true, __ATOMIC_SEQ_CST) == false) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self drainCommandQueue];
+        });
+    }
+}
+
+/**
+ Pauses or resumes the display link, if the engine is driven by one. Must be called on the engine's thread.
+ */
+- (void)setDisplayLinkPaused:(BOOL)paused
+{
+    if (!_usesDisplayLink) {
+        return;
+    }
+    self.displayLink.paused = paused;
+    __atomic_store_n(&_displayLinkPaused, (bool)paused, __ATOMIC_SEQ_CST);
+    if (paused) {
+        // A command enqueued after the last frame processed the queue, but before the store above, saw the display link running and
+        // did not schedule a drain, so one is scheduled here instead.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        [self scheduleCommandQueueDrain];
+    }
+}
+
+/**
+ Processes all of the commands in the command queue. Must be called on the engine's thread.
+ */
+- (void)drainCommandQueue
+{
+    __atomic_store_n(&_drainScheduled, false, __ATOMIC_SEQ_CST);
+    // The store above must be visible before the queue is read, or a command enqueued in between could see a drain still scheduled
+    // while this drain had already found the queue empty, leaving the command stranded until the next one.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    
+    INTUAnimationCommand *command;
+    while ((command = INTUAnimationCommandQueueDequeue(&_commandQueue))) {
+        switch (command->type) {
+            case INTUAnimationCommandTypeStart:
+                [self addAnimation:(__bridge_transfer INTUAnimation *)command->payload];
+                break;
+            case INTUAnimationCommandTypeCancel:
+                [self removeAnimationWithID:command->animationID didFinish:NO];
+                break;
+            case INTUAnimationCommandTypeRetarget:
+                [self retargetAnimationWithID:command->animationID toValues:(__bridge_transfer NSData *)command->payload];
+                break;
+            case INTUAnimationCommandTypeSetOutputQuantum:
+                [self applyOutputQuantum:[(__bridge_transfer NSNumber *)command->payload doubleValue] toAnimationWithID:command->animationID];
+                break;
+        }
+        INTUAnimationCommandDestroy(command);
+    }
+}
+
+/**
+ Returns a snapshot of the state of every active animation (including any commands waiting in the command queue). Must be called on
+ the engine's thread.
+ */
+- (NSData *)snapshotActiveAnimations
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine snapshots should only be taken from the engine's thread.");
+    [self drainCommandQueue];
+    
+    __INTU_GENERICS(NSDictionary, NSNumber *, INTUAnimation *) *activeAnimations = self.activeAnimations;
+    INTUAnimationSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kINTUAnimationSnapshotMagic;
+    header.version = kINTUAnimationSnapshotVersion;
+    header.floatSize = sizeof(CGFloat);
+    header.scalarSize = sizeof(INTUSpringScalar);
+    header.dimensions = kINTUSpringSolverDimensions;
+    header.count = (uint32_t)[activeAnimations count];
+    
+    INTUAnimationSnapshotWriter writer = { NULL, 0, 0, false };
+    INTUAnimationSnapshotWrite(&writer, &header, sizeof(header));
+    for (INTUAnimation *animation in [activeAnimations objectEnumerator]) {
+        size_t recordStart = writer.length;
+        [animation writeSnapshot:&writer];
+        if (!writer.failed) {
+            // Fill in the size of the record now that its state has been written.
+            uint32_t size = (uint32_t)(writer.length - recordStart);
+            memcpy(writer.bytes + recordStart + offsetof(INTUAnimationSnapshotRecord, size), &size, sizeof(size));
+        }
+    }
+    if (writer.failed) {
+        free(writer.bytes);
+        return nil;
+    }
+    return [NSData dataWithBytesNoCopy:writer.bytes length:writer.length freeWhenDone:YES];
+}
+
+/**
+ Restores the animations in the snapshot, and returns the number of animations restored, or NSNotFound if the snapshot is invalid. Must
+ be called on the engine's thread.
+ */
+- (NSUInteger)restoreAnimationsFromSnapshot:(NSData *)snapshot handler:(INTUAnimationRestoreHandler)handler
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine snapshots should only be restored from the engine's thread.");
+    [self drainCommandQueue];
+    
+    INTUAnimationSnapshotReader reader = { [snapshot bytes], [snapshot length], 0 };
+    INTUAnimationSnapshotHeader header;
+    if (!INTUAnimationSnapshotRead(&reader, &header, sizeof(header)) ||
+        header.magic != kINTUAnimationSnapshotMagic ||
+        header.version != kINTUAnimationSnapshotVersion ||
+        header.floatSize != sizeof(CGFloat) ||
+        header.scalarSize != sizeof(INTUSpringScalar) ||
+        header.dimensions != kINTUSpringSolverDimensions) {
+        return NSNotFound;
+    }
+    
+    // Read every record before adding any animations, so that an invalid snapshot has no effect.
+    CFTimeInterval time = [self currentTime];
+    NSMutableArray *animations = [NSMutableArray arrayWithCapacity:header.count];
+    NSMutableIndexSet *customEasingIndexes = [NSMutableIndexSet indexSet];
+    for (uint32_t i = 0; i < header.count; i++) {
+        INTUAnimationSnapshotRecord record;
+        INTUAnimationSnapshotReader recordReader = reader;
+        if (!INTUAnimationSnapshotRead(&recordReader, &record, sizeof(record)) ||
+            record.size < sizeof(record) ||
+            record.size > reader.length - reader.offset) {
+            return NSNotFound;
+        }
+        Class animationClass = nil;
+        switch (record.kind) {
+            case INTUAnimationSnapshotKindTween:    animationClass = [INTUAnimation class];         break;
+            case INTUAnimationSnapshotKindSpring:   animationClass = [INTUSpringAnimation class];   break;
+            case INTUAnimationSnapshotKindDecay:    animationClass = [INTUDecayAnimation class];    break;
+            case INTUAnimationSnapshotKindPath:     animationClass = [INTUPathAnimation class];     break;
+        }
+        recordReader.bytes = reader.bytes + reader.offset;
+        recordReader.length = record.size;
+        recordReader.offset = 0;
+        INTUAnimation *animation = [animationClass new];
+        if (animation == nil || ![animation readSnapshot:&recordReader time:time]) {
+            return NSNotFound;
+        }
+        if (record.easing == kINTUAnimationSnapshotCustomEasing) {
+            [customEasingIndexes addIndex:i];
+        }
+        [animations addObject:animation];
+        reader.offset += record.size;
+    }
+    
+    // Add all of the animations at once, instead of copying the active animations dictionary for each one.
+    __INTU_GENERICS(NSMutableDictionary, NSNumber *, INTUAnimation *) *newActiveAnimations = [NSMutableDictionary dictionaryWithDictionary:self.activeAnimations];
+    INTUAnimationID maximumAnimationID = 0;
+    NSUInteger restoredCount = 0;
+    INTUAnimationTrace *trace = [self activeTrace];
+    double traceStart = INTUAnimationTraceBegin(trace);
+    for (NSUInteger i = 0; i < [animations count]; i++) {
+        INTUAnimation *animation = animations[i];
+        if (newActiveAnimations[@(animation.animationID)]) {
+            continue;
+        }
+        if (handler) {
+            INTURestoredAnimation *restoredAnimation = [INTURestoredAnimation new];
+            restoredAnimation.animationID = animation.animationID;
+            restoredAnimation.bound = animation.outputChannelCount > 0;
+            restoredAnimation.hasCustomEasing = [customEasingIndexes containsIndex:i];
+            restoredAnimation.easingFunction = animation.easingFunction;
+            if (!handler(restoredAnimation)) {
+                continue;
+            }
+            animation.easingFunction = restoredAnimation.easingFunction;
+            animation.animations = restoredAnimation.animations;
+            animation.completion = restoredAnimation.completion;
+            if ([animation isKindOfClass:[INTUPathAnimation class]]) {
+                ((INTUPathAnimation *)animation).pathAnimations = restoredAnimation.pathAnimations;
+            }
+        }
+        if (![self bindAnimationToOutputBuffer:animation]) {
+            continue;
+        }
+        newActiveAnimations[@(animation.animationID)] = animation;
+        maximumAnimationID = MAX(maximumAnimationID, animation.animationID);
+        restoredCount++;
+    }
+    [self reserveAnimationIDsThroughID:maximumAnimationID];
+    
+    if (restoredCount > 0) {
+        if ([self.activeAnimations count] == 0) {
+            [self setDisplayLinkPaused:NO];
+        }
+        self.activeAnimations = newActiveAnimations;
+    }
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseAdd, 0, traceStart, (int32_t)[self.activeAnimations count]);
+    return restoredCount;
+}
+
+/**
+ Starts recording a new frame trace into a ring buffer that holds the given number of events, discarding any previous trace. Must be
+ called on the engine's thread, and not while the trace is being exported.
+ */
+- (BOOL)startFrameTraceWithCapacity:(NSUInteger)capacity
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine frame trace should only be started from the engine's thread.");
+    _tracing = false;
+    INTUAnimationTraceDestroy(&_trace);
+    if (capacity == 0 || !INTUAnimationTraceInit(&_trace, capacity)) {
+        return NO;
+    }
+    _tracing = true;
+    return YES;
+}
+
+/**
+ Stops recording the frame trace. The events recorded so far are kept, so they can still be exported.
+ */
+- (void)stopFrameTrace
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine frame trace should only be stopped from the engine's thread.");
+    _tracing = false;
+}
+
+/**
+ Returns the events in the frame trace as Chrome trace event JSON, or nil if no trace has been started.
+ */
+- (NSData *)frameTraceJSON
+{
+    if (_trace.events == NULL) {
+        return nil;
+    }
+    size_t length;
+    char *json = INTUAnimationTraceCopyChromeJSON(&_trace, &length);
+    if (json == NULL) {
+        return nil;
+    }
+    return [NSData dataWithBytesNoCopy:json length:length freeWhenDone:YES];
+}
+
+/**
+ The frame trace to record into, or NULL if tracing is disabled.
+ */
+- (INTUAnimationTrace *)activeTrace
+{
+    return _tracing ? &_trace : NULL;
 }
 
 /**
  Callback when the CADisplayLink fires.
  */
-- (void)tickActiveAnimations
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
 {
+    CFTimeInterval presentationTime;
+    if ([displayLink respondsToSelector:@selector(targetTimestamp)]) {
+        presentationTime = displayLink.targetTimestamp;
+    } else {
+        // Before iOS 10, the frame being prepared is presented one refresh after the display link fires.
+        presentationTime = displayLink.timestamp + displayLink.duration;
+    }
+    [self tickActiveAnimationsWithPresentationTime:presentationTime];
+}
+
+/**
+ Returns the time to evaluate the animations in a frame at: the predicted presentation time of the frame if the engine targets it (and it
+ is known), otherwise the current time.
+ */
+- (CFTimeInterval)frameTimeForCurrentTime:(CFTimeInterval)currentTime presentationTime:(CFTimeInterval)presentationTime
+{
+    CFTimeInterval frameTime = currentTime;
+    if (_targetsPresentationTime && !isnan(presentationTime)) {
+        frameTime = currentTime + MIN(MAX(presentationTime - currentTime, 0.0), kINTUMaximumPresentationLead);
+    }
+    // Spring solvers only integrate forwards, and restart if they are advanced to an earlier time than the last. A prediction can be later
+    // than the current time of the next frame (if that frame comes early, or the engine stops targeting presentation time), so the frame
+    // time is held at the last prediction until the clock catches up.
+    frameTime = MAX(frameTime, _lastPredictedFrameTime);
+    _lastPredictedFrameTime = (frameTime > currentTime) ? frameTime : -INFINITY;
+    return frameTime;
+}
+
+/**
+ Called once per frame, when the CADisplayLink fires or when the engine is ticked manually. The presentation time is the predicted time
+ that the frame will be presented onscreen, or NAN if it is not known.
+ */
+- (void)tickActiveAnimationsWithPresentationTime:(CFTimeInterval)presentationTime
+{
+    INTUAnimationTrace *trace = [self activeTrace];
+    double frameTraceStart = INTUAnimationTraceBegin(trace);
+    
+    // Every animation is evaluated at the same time, so the clock only needs to be read once per frame.
+    CFTimeInterval frameTime = [self frameTimeForCurrentTime:[self currentTime] presentationTime:presentationTime];
+    if (!isnan(presentationTime)) {
+        INTUAnimationLatencyHistogramRecord(&_presentationLag, presentationTime - frameTime);
+    }
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseClockRead, 0, frameTraceStart, 0);
+    
+    double traceStart = INTUAnimationTraceBegin(trace);
+    [self drainCommandQueue];
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseCommandDrain, 0, traceStart, 0);
+    
+    // Finished animations are removed only after the output buffer has been updated, so that their final values are delivered to the
+    // output handler before their slots are freed.
+    NSMutableArray *finishedAnimationIDs = nil;
+    NSUInteger elidedCallbackCount = 0;
     for (INTUAnimation *animation in [self.activeAnimations objectEnumerator]) {
-        [animation tick];
+        animation.frameTime = frameTime;
+        animation.trace = trace;
+        BOOL emitted = [animation tick];
+        BOOL finished = NO;
         if ([animation isKindOfClass:[INTUSpringAnimation class]]) {
             INTUSpringAnimation *springAnimation = (INTUSpringAnimation *)animation;
-            if (springAnimation.hasConverged) {
-                [self removeAnimationWithID:animation.animationID didFinish:YES];
-            }
+            finished = springAnimation.hasConverged;
         }
         else if (animation.repeat == NO && animation.percentComplete >= 1.0) {
-            [self removeAnimationWithID:animation.animationID didFinish:YES];
+            finished = YES;
         }
+        if (!emitted) {
+            if (finished) {
+                // Always deliver the final output, even if it is within the output quantum of the last output.
+                [animation flushPendingOutput];
+            } else {
+                elidedCallbackCount++;
+            }
+        }
+        if (finished) {
+            if (!finishedAnimationIDs) {
+                finishedAnimationIDs = [NSMutableArray array];
+            }
+            [finishedAnimationIDs addObject:@(animation.animationID)];
+        }
+    }
+    
+    _elidedCallbackCount = elidedCallbackCount;
+    
+    size_t dirtyOffset, dirtyLength;
+    traceStart = INTUAnimationTraceBegin(trace);
+    BOOL updated = INTUAnimationOutputBufferUpdate(&_outputBuffer, &dirtyOffset, &dirtyLength);
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseOutputUpdate, 0, traceStart, updated ? (int32_t)dirtyLength : 0);
+    if (updated && self.outputHandler) {
+        traceStart = INTUAnimationTraceBegin(trace);
+        self.outputHandler(_outputBuffer.values, NSMakeRange(dirtyOffset, dirtyLength));
+        INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseOutputHandler, 0, traceStart, 0);
     }
+    
+    for (NSNumber *animationID in finishedAnimationIDs) {
+        [self removeAnimationWithID:[animationID integerValue] didFinish:YES];
+    }
+    
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseFrame, 0, frameTraceStart, (int32_t)[self.activeAnimations count]);
+}
+
+/**
+ Retargets the active animation with the given ID towards the new to values. Must be called on the engine's thread.
+ */
+- (void)retargetAnimationWithID:(INTUAnimationID)animationID toValues:(NSData *)toValues
+{
+    INTUAnimation *animation = [self.activeAnimations objectForKey:@(animationID)];
+    [animation retargetToValues:toValues time:[self currentTime]];
+}
+
+/**
+ Sets the output quantum of the active animation with the given ID. Must be called on the engine's thread.
+ */
+- (void)applyOutputQuantum:(CGFloat)outputQuantum toAnimationWithID:(INTUAnimationID)animationID
+{
+    INTUAnimation *animation = [self.activeAnimations objectForKey:@(animationID)];
+    animation.outputQuantum = MAX(0.0, outputQuantum);
+}
+
+/**
+ The number of animations whose output was skipped during the last frame because it changed by less than their output quantum.
+ */
+- (NSUInteger)elidedCallbackCount
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine elided callback count should only be read from the engine's thread.");
+    return _elidedCallbackCount;
+}
+
+- (void)setOutputHandler:(INTUAnimationOutputHandler)outputHandler
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine output handler should only be set from the engine's thread.");
+    _outputHandler = [outputHandler copy];
+}
+
+- (void)setUsesApproximateEasing:(BOOL)usesApproximateEasing
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine approximate easing should only be set from the engine's thread.");
+    _usesApproximateEasing = usesApproximateEasing;
+}
+
+- (void)setTargetsPresentationTime:(BOOL)targetsPresentationTime
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine presentation time targeting should only be set from the engine's thread.");
+    _targetsPresentationTime = targetsPresentationTime;
+}
+
+- (INTUAnimationLatencySummary)presentationLagSummary
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine presentation latency should only be read from the engine's thread.");
+    return INTUAnimationLatencyHistogramGetSummary(&_presentationLag);
+}
+
+- (void)resetPresentationLag
+{
+    NSAssert([self isOnEngineThread], @"INTUAnimationEngine presentation latency should only be reset from the engine's thread.");
+    INTUAnimationLatencyHistogramReset(&_presentationLag);
+}
+
+/**
+ Allocates a slot in the output buffer for the animation, if it has output values. Returns NO if the slot could not be allocated.
+ */
+- (BOOL)bindAnimationToOutputBuffer:(INTUAnimation *)animation
+{
+    if (animation.outputChannelCount > 0) {
+        size_t offset = INTUAnimationOutputBufferAllocate(&_outputBuffer, animation.outputChannelCount);
+        if (offset == SIZE_MAX) {
+            return NO;
+        }
+        INTUAnimationOutputBufferSetValues(&_outputBuffer, offset, animation.outputChannelCount, [animation.fromValues bytes], [animation.toValues bytes]);
+        animation.outputBuffer = &_outputBuffer;
+        animation.outputOffset = offset;
+    }
+    return YES;
 }
 
 - (void)addAnimation:(INTUAnimation *)animation
 {
+    if (_usesApproximateEasing) {
+        animation.easingFunction = INTUApproximateEasingFunction(animation.easingFunction);
+    }
+    if (![self bindAnimationToOutputBuffer:animation]) {
+        // Out of memory; the animation cannot be bound to the output buffer, so it is completed immediately.
+        [animation complete:NO];
+        return;
+    }
     if ([self.activeAnimations count] == 0) {
-        self.displayLink.paused = NO;
+        [self setDisplayLinkPaused:NO];
     }
-    animation.startTime = CACurrentMediaTime();
+    INTUAnimationTrace *trace = [self activeTrace];
+    double traceStart = INTUAnimationTraceBegin(trace);
     __INTU_GENERICS(NSMutableDictionary, NSNumber *, INTUAnimation *) *newActiveAnimations = [NSMutableDictionary dictionaryWithDictionary:self.activeAnimations];
     [newActiveAnimations setObject:animation forKey:@(animation.animationID)];
     self.activeAnimations = newActiveAnimations;
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseAdd, animation.animationID, traceStart, (int32_t)[newActiveAnimations count]);
 }
 
 - (void)removeAnimationWithID:(INTUAnimationID)animationID didFinish:(BOOL)finished
 {
     INTUAnimation *animation = [self.activeAnimations objectForKey:@(animationID)];
+    if (animation == nil) {
+        // The animation already finished or was canceled, or the ID belongs to another engine.
+        return;
+    }
+    if (animation.outputBuffer) {
+        INTUAnimationOutputBufferFree(&_outputBuffer, animation.outputOffset, animation.outputChannelCount);
+        animation.outputBuffer = NULL;
+    }
+    // A finished animation has already delivered its final output; a canceled one delivers the last progress skipped because of its output
+    // quantum (to its animations block only, since its slot in the output buffer has just been freed), so it stops exactly where it was.
+    [animation flushPendingOutput];
+    INTUAnimationTrace *trace = [self activeTrace];
+    double traceStart = INTUAnimationTraceBegin(trace);
     [animation complete:finished];
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseCompletion, animationID, traceStart, finished);
+    traceStart = INTUAnimationTraceBegin(trace);
     __INTU_GENERICS(NSMutableDictionary, NSNumber *, INTUAnimation *) *newActiveAnimations = [NSMutableDictionary dictionaryWithDictionary:self.activeAnimations];
     [newActiveAnimations removeObjectForKey:@(animationID)];
     self.activeAnimations = newActiveAnimations;
+    INTUAnimationTraceEnd(trace, INTUAnimationTracePhaseRemove, animationID, traceStart, (int32_t)[newActiveAnimations count]);
     if ([self.activeAnimations count] == 0) {
-        self.displayLink.paused = YES;
+        [self setDisplayLinkPaused:YES];
     }
 }
 
@@ -0,0 +1,99 @@
+//
+//  INTUAnimationLatencyHistogram.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUAnimationLatencyHistogram.h"
+#include <math.h>
+#include <string.h>
+
+void INTUAnimationLatencyHistogramReset(INTUAnimationLatencyHistogram *histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+void INTUAnimationLatencyHistogramRecord(INTUAnimationLatencyHistogram *histogram, double latency)
+{
+    if (isnan(latency)) {
+        return;
+    }
+    double bucket = floor(latency / kINTUAnimationLatencyHistogramBucketWidth);
+    if (bucket < 0.0) {
+        bucket = 0.0;
+    } else if (bucket > kINTUAnimationLatencyHistogramBucketCount - 1) {
+        bucket = kINTUAnimationLatencyHistogramBucketCount - 1;
+    }
+    histogram->buckets[(size_t)bucket]++;
+    if (histogram->count == 0 || latency < histogram->minimum) {
+        histogram->minimum = latency;
+    }
+    if (histogram->count == 0 || latency > histogram->maximum) {
+        histogram->maximum = latency;
+    }
+    histogram->count++;
+    histogram->sum += latency;
+}
+
+double INTUAnimationLatencyHistogramPercentile(const INTUAnimationLatencyHistogram *histogram, double fraction)
+{
+    if (histogram->count == 0) {
+        return 0.0;
+    }
+    // The rank of the latency, counting from 1, so that fraction 0.0 is the smallest latency and fraction 1.0 is the largest.
+    double rank = ceil(fmin(fmax(fraction, 0.0), 1.0) * histogram->count);
+    if (rank <= 1.0) {
+        return histogram->minimum;
+    }
+    if (rank >= histogram->count) {
+        return histogram->maximum;
+    }
+    uint64_t cumulativeCount = 0;
+    double latency = histogram->maximum;
+    // The last bucket has no upper edge, so a latency that falls in it is estimated as the maximum.
+    for (size_t i = 0; i < kINTUAnimationLatencyHistogramBucketCount - 1; i++) {
+        cumulativeCount += histogram->buckets[i];
+        if (cumulativeCount >= rank) {
+            latency = (i + 1) * kINTUAnimationLatencyHistogramBucketWidth;
+            break;
+        }
+    }
+    return fmin(fmax(latency, histogram->minimum), histogram->maximum);
+}
+
+INTUAnimationLatencySummary INTUAnimationLatencyHistogramGetSummary(const INTUAnimationLatencyHistogram *histogram)
+{
+    INTUAnimationLatencySummary summary;
+    memset(&summary, 0, sizeof(summary));
+    if (histogram->count == 0) {
+        return summary;
+    }
+    summary.count = histogram->count;
+    summary.mean = histogram->sum / histogram->count;
+    summary.minimum = histogram->minimum;
+    summary.maximum = histogram->maximum;
+    summary.median = INTUAnimationLatencyHistogramPercentile(histogram, 0.5);
+    summary.percentile90 = INTUAnimationLatencyHistogramPercentile(histogram, 0.9);
+    summary.percentile99 = INTUAnimationLatencyHistogramPercentile(histogram, 0.99);
+    return summary;
+}
@@ -0,0 +1,84 @@
+//
+//  INTUAnimationLatencyHistogram.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUAnimationLatencyHistogram_h
+#define INTUAnimationLatencyHistogram_h
+
+#include <stdint.h>
+
+// A latency histogram records the distribution of a per-frame latency; the animation engine uses it for the presentation lag of its frames:
+// the predicted time each frame is presented onscreen, minus the time its animations were evaluated at. Latencies are counted in fixed
+// width buckets, so recording a frame is a few arithmetic operations with no allocations, and the histogram can be kept for the whole
+// lifetime of an app.
+
+/** The width of each bucket in the histogram, in seconds. */
+#define kINTUAnimationLatencyHistogramBucketWidth   0.00025
+
+/** The number of buckets in the histogram. Latencies longer than the last bucket (50 ms) are counted in it. */
+#define kINTUAnimationLatencyHistogramBucketCount   200
+
+/** A histogram of latencies. Must be reset with INTUAnimationLatencyHistogramReset() before use. */
+typedef struct {
+    /** The number of latencies in each bucket. Bucket i counts latencies from i up to (i + 1) bucket widths, and bucket 0 also counts
+        negative latencies. */
+    uint64_t buckets[kINTUAnimationLatencyHistogramBucketCount];
+    /** The total number of latencies recorded. */
+    uint64_t count;
+    /** The sum, minimum and maximum of the exact latencies recorded, in seconds. */
+    double sum;
+    double minimum;
+    double maximum;
+} INTUAnimationLatencyHistogram;
+
+/** A summary of the latencies in a histogram, in seconds. All latencies are zero if none have been recorded. */
+typedef struct {
+    uint64_t count;
+    double mean;
+    double minimum;
+    double maximum;
+    /** The percentiles are accurate to within one bucket width. */
+    double median;
+    double percentile90;
+    double percentile99;
+} INTUAnimationLatencySummary;
+
+/** Removes all recorded latencies from the histogram. */
+void    INTUAnimationLatencyHistogramReset(INTUAnimationLatencyHistogram *histogram);
+
+/** Records one latency, in seconds. */
+void    INTUAnimationLatencyHistogramRecord(INTUAnimationLatencyHistogram *histogram, double latency);
+
+/**
+ Returns the latency below which the given fraction (from 0.0 to 1.0) of the recorded latencies fall, estimated as the upper edge of the
+ bucket that contains it and clamped to the exact minimum and maximum. The fractions 0.0 and 1.0 return the exact minimum and maximum.
+ Returns zero if no latencies have been recorded.
+ */
+double  INTUAnimationLatencyHistogramPercentile(const INTUAnimationLatencyHistogram *histogram, double fraction);
+
+/** Returns a summary of the latencies recorded in the histogram. */
+INTUAnimationLatencySummary INTUAnimationLatencyHistogramGetSummary(const INTUAnimationLatencyHistogram *histogram);
+
+#endif /* INTUAnimationLatencyHistogram_h */
@@ -0,0 +1,233 @@
+//
+//  INTUAnimationOutputBuffer.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUAnimationOutputBuffer.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool growBuffer(INTUAnimationOutputBuffer *buffer, size_t minimumCapacity);
+
+static bool insertFreeRange(INTUAnimationOutputBuffer *buffer, size_t index, size_t offset, size_t channelCount);
+
+static void removeFreeRange(INTUAnimationOutputBuffer *buffer, size_t index);
+
+static void markDirty(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount);
+
+void INTUAnimationOutputBufferInit(INTUAnimationOutputBuffer *buffer)
+{
+    memset(buffer, 0, sizeof(INTUAnimationOutputBuffer));
+    buffer->dirtyStart = SIZE_MAX;
+}
+
+void INTUAnimationOutputBufferDestroy(INTUAnimationOutputBuffer *buffer)
+{
+    free(buffer->values);
+    free(buffer->start);
+    free(buffer->delta);
+    free(buffer->progress);
+    free(buffer->freeRanges);
+    INTUAnimationOutputBufferInit(buffer);
+}
+
+size_t INTUAnimationOutputBufferAllocate(INTUAnimationOutputBuffer *buffer, size_t channelCount)
+{
+    if (channelCount == 0) {
+        return SIZE_MAX;
+    }
+    
+    // Reuse the first free range that is large enough, splitting off any remainder.
+    for (size_t i = 0; i < buffer->freeRangeCount; i++) {
+        size_t *range = buffer->freeRanges + 2 * i;
+        if (range[1] >= channelCount) {
+            size_t offset = range[0];
+            range[0] += channelCount;
+            range[1] -= channelCount;
+            if (range[1] == 0) {
+                removeFreeRange(buffer, i);
+            }
+            return offset;
+        }
+    }
+    
+    if (buffer->length + channelCount > buffer->capacity && !growBuffer(buffer, buffer->length + channelCount)) {
+        return SIZE_MAX;
+    }
+    size_t offset = buffer->length;
+    buffer->length += channelCount;
+    return offset;
+}
+
+void INTUAnimationOutputBufferFree(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount)
+{
+    if (channelCount == 0 || offset + channelCount > buffer->length) {
+        return;
+    }
+    
+    // The free ranges are sorted by offset and adjacent ranges are always merged, so the freed slot can only join the range just below
+    // it and the range just above it.
+    size_t index = 0;
+    while (index < buffer->freeRangeCount && buffer->freeRanges[2 * index] < offset) {
+        index++;
+    }
+    size_t *previous = index > 0 ? buffer->freeRanges + 2 * (index - 1) : NULL;
+    size_t *next = index < buffer->freeRangeCount ? buffer->freeRanges + 2 * index : NULL;
+    const bool mergesPrevious = previous && previous[0] + previous[1] == offset;
+    const bool mergesNext = next && offset + channelCount == next[0];
+    
+    if (mergesPrevious && mergesNext) {
+        previous[1] += channelCount + next[1];
+        removeFreeRange(buffer, index);
+    } else if (mergesPrevious) {
+        previous[1] += channelCount;
+    } else if (mergesNext) {
+        next[0] = offset;
+        next[1] += channelCount;
+    } else if (offset + channelCount == buffer->length) {
+        // The slot is at the end of the buffer, and no free range is below it, so just shrink the buffer.
+        buffer->length = offset;
+        return;
+    } else if (!insertFreeRange(buffer, index, offset, channelCount)) {
+        // The channels are leaked until the buffer shrinks past them, which is harmless.
+        return;
+    }
+    
+    // Only the last free range can reach the end of the buffer, in which case the buffer shrinks to the start of it.
+    if (buffer->freeRangeCount > 0) {
+        size_t *last = buffer->freeRanges + 2 * (buffer->freeRangeCount - 1);
+        if (last[0] + last[1] == buffer->length) {
+            buffer->length = last[0];
+            buffer->freeRangeCount--;
+        }
+    }
+}
+
+void INTUAnimationOutputBufferSetValues(INTUAnimationOutputBuffer *buffer,
+                                        size_t offset,
+                                        size_t channelCount,
+                                        const CGFloat *startValues,
+                                        const CGFloat *endValues)
+{
+    for (size_t i = 0; i < channelCount; i++) {
+        buffer->start[offset + i] = startValues[i];
+        buffer->delta[offset + i] = endValues[i] - startValues[i];
+        buffer->progress[offset + i] = 0.0;
+    }
+    markDirty(buffer, offset, channelCount);
+}
+
+void INTUAnimationOutputBufferSetProgress(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount, CGFloat progress)
+{
+    for (size_t i = 0; i < channelCount; i++) {
+        buffer->progress[offset + i] = progress;
+    }
+    markDirty(buffer, offset, channelCount);
+}
+
+bool INTUAnimationOutputBufferUpdate(INTUAnimationOutputBuffer *buffer, size_t *dirtyOffset, size_t *dirtyLength)
+{
+    if (buffer->dirtyStart == SIZE_MAX) {
+        return false;
+    }
+    
+    const size_t start = buffer->dirtyStart;
+    const size_t end = buffer->dirtyEnd;
+    CGFloat * restrict values = buffer->values;
+    const CGFloat * restrict startValues = buffer->start;
+    const CGFloat * restrict delta = buffer->delta;
+    const CGFloat * restrict progress = buffer->progress;
+    for (size_t i = start; i < end; i++) {
+        values[i] = startValues[i] + delta[i] * progress[i];
+    }
+    
+    buffer->dirtyStart = SIZE_MAX;
+    buffer->dirtyEnd = 0;
+    if (dirtyOffset) {
+        *dirtyOffset = start;
+    }
+    if (dirtyLength) {
+        *dirtyLength = end - start;
+    }
+    return true;
+}
+
+#pragma mark Internal Functions
+
+static bool growBuffer(INTUAnimationOutputBuffer *buffer, size_t minimumCapacity)
+{
+    size_t newCapacity = buffer->capacity ? buffer->capacity : 64;
+    while (newCapacity < minimumCapacity) {
+        newCapacity *= 2;
+    }
+    
+    CGFloat **arrays[] = { &buffer->values, &buffer->start, &buffer->delta, &buffer->progress };
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        CGFloat *newArray = realloc(*arrays[i], newCapacity * sizeof(CGFloat));
+        if (newArray == NULL) {
+            return false;
+        }
+        memset(newArray + buffer->capacity, 0, (newCapacity - buffer->capacity) * sizeof(CGFloat));
+        *arrays[i] = newArray;
+    }
+    buffer->capacity = newCapacity;
+    return true;
+}
+
+static bool insertFreeRange(INTUAnimationOutputBuffer *buffer, size_t index, size_t offset, size_t channelCount)
+{
+    if (buffer->freeRangeCount == buffer->freeRangeCapacity) {
+        size_t newCapacity = buffer->freeRangeCapacity ? buffer->freeRangeCapacity * 2 : 16;
+        size_t *newRanges = realloc(buffer->freeRanges, newCapacity * 2 * sizeof(size_t));
+        if (newRanges == NULL) {
+            return false;
+        }
+        buffer->freeRanges = newRanges;
+        buffer->freeRangeCapacity = newCapacity;
+    }
+    size_t *range = buffer->freeRanges + 2 * index;
+    memmove(range + 2, range, (buffer->freeRangeCount - index) * 2 * sizeof(size_t));
+    range[0] = offset;
+    range[1] = channelCount;
+    buffer->freeRangeCount++;
+    return true;
+}
+
+static void removeFreeRange(INTUAnimationOutputBuffer *buffer, size_t index)
+{
+    buffer->freeRangeCount--;
+    size_t *range = buffer->freeRanges + 2 * index;
+    memmove(range, range + 2, (buffer->freeRangeCount - index) * 2 * sizeof(size_t));
+}
+
+static void markDirty(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount)
+{
+    if (offset < buffer->dirtyStart) {
+        buffer->dirtyStart = offset;
+    }
+    if (offset + channelCount > buffer->dirtyEnd) {
+        buffer->dirtyEnd = offset + channelCount;
+    }
+}
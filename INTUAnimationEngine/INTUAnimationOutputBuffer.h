@@ -0,0 +1,99 @@
+//
+//  INTUAnimationOutputBuffer.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUAnimationOutputBuffer_h
+#define INTUAnimationOutputBuffer_h
+
+#include <CoreGraphics/CGBase.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// An output buffer is a contiguous array of values that animations write their results into, instead of executing a block each frame.
+// Each bound animation owns a slot of one or more channels (for example, 2 channels for a CGPoint). The start value and delta of every
+// channel are stored in arrays parallel to the output values, so that once each animation has stored its current progress, all of the
+// output values can be calculated in a single vectorizable pass:
+//
+//      values[i] = start[i] + delta[i] * progress[i]
+//
+// The buffer tracks the range of channels that were written each frame (the dirty range), so consumers only need to read that range.
+
+/** A contiguous buffer of animation output values. Must be initialized with INTUAnimationOutputBufferInit() before use. */
+typedef struct {
+    /** The current output value of each channel. */
+    CGFloat *values;
+    /** The start value of each channel. */
+    CGFloat *start;
+    /** The difference between the end value and the start value of each channel. */
+    CGFloat *delta;
+    /** The current progress of each channel (the same for every channel in a slot). */
+    CGFloat *progress;
+    /** The number of channels in use, including any free ranges below the last slot. */
+    size_t length;
+    /** The number of channels allocated. */
+    size_t capacity;
+    
+    /** Ranges of channels that have been freed and can be reused, stored as pairs of (offset, count) sorted by offset. Adjacent ranges
+        are merged, and a range that reaches the end of the buffer is released by shrinking length instead. */
+    size_t *freeRanges;
+    size_t freeRangeCount;
+    size_t freeRangeCapacity;
+    
+    /** The first channel written since the last update, or SIZE_MAX if none. */
+    size_t dirtyStart;
+    /** One past the last channel written since the last update. */
+    size_t dirtyEnd;
+} INTUAnimationOutputBuffer;
+
+/** Initializes an empty output buffer. */
+void    INTUAnimationOutputBufferInit(INTUAnimationOutputBuffer *buffer);
+
+/** Frees all memory used by the output buffer. */
+void    INTUAnimationOutputBufferDestroy(INTUAnimationOutputBuffer *buffer);
+
+/** Allocates a slot of channelCount contiguous channels and returns its offset, or SIZE_MAX if allocation fails. */
+size_t  INTUAnimationOutputBufferAllocate(INTUAnimationOutputBuffer *buffer, size_t channelCount);
+
+/** Returns a slot of channels to the buffer so that it can be reused. */
+void    INTUAnimationOutputBufferFree(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount);
+
+/** Sets the start and end values of a slot, and resets its progress (and output values) to the start values. */
+void    INTUAnimationOutputBufferSetValues(INTUAnimationOutputBuffer *buffer,
+                                           size_t offset,
+                                           size_t channelCount,
+                                           const CGFloat *startValues,
+                                           const CGFloat *endValues);
+
+/** Stores the current progress of a slot, and marks its channels as dirty. */
+void    INTUAnimationOutputBufferSetProgress(INTUAnimationOutputBuffer *buffer, size_t offset, size_t channelCount, CGFloat progress);
+
+/**
+ Calculates the output values of every dirty channel in a single pass, and resets the dirty range.
+ 
+ @return Whether any channels were dirty. If so, the range of channels that were updated is returned in dirtyOffset and dirtyLength.
+ */
+bool    INTUAnimationOutputBufferUpdate(INTUAnimationOutputBuffer *buffer, size_t *dirtyOffset, size_t *dirtyLength);
+
+#endif /* INTUAnimationOutputBuffer_h */
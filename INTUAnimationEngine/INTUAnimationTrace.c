@@ -0,0 +1,240 @@
+//
+//  INTUAnimationTrace.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUAnimationTrace.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __APPLE__
+#   include <mach/mach_time.h>
+#else
+#   include <time.h>
+#endif
+
+static const char *kPhaseNames[INTUAnimationTracePhaseCount] = {
+    "Frame",
+    "Clock Read",
+    "Command Drain",
+    "Delay Check",
+    "Easing",
+    "Spring Integration",
+    "Callback",
+    "Output Update",
+    "Output Handler",
+    "Completion",
+    "Add",
+    "Remove"
+};
+
+// The typical length of the JSON representation of a single event, used for the initial size of the export buffer. Events with large
+// timestamps or values are longer, in which case the buffer grows.
+static const size_t kEventJSONLength = 192;
+
+// The longest phase name that is formatted into the JSON.
+static const int kMaxNameLength = 32;
+
+static bool appendFormat(char **buffer, size_t *capacity, size_t *position, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+bool INTUAnimationTraceInit(INTUAnimationTrace *trace, size_t capacity)
+{
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+        roundedCapacity <<= 1;
+    }
+    trace->events = calloc(roundedCapacity, sizeof(INTUAnimationTraceEvent));
+    trace->sequences = calloc(roundedCapacity, sizeof(uint64_t));
+    if (!trace->events || !trace->sequences) {
+        INTUAnimationTraceDestroy(trace);
+        return false;
+    }
+    trace->capacity = roundedCapacity;
+    trace->head = 0;
+    return true;
+}
+
+void INTUAnimationTraceDestroy(INTUAnimationTrace *trace)
+{
+    free(trace->events);
+    free(trace->sequences);
+    trace->events = NULL;
+    trace->sequences = NULL;
+    trace->capacity = 0;
+    trace->head = 0;
+}
+
+double INTUAnimationTraceNow(void)
+{
+#ifdef __APPLE__
+    static double secondsPerTick = 0.0;
+    if (secondsPerTick == 0.0) {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        secondsPerTick = 1e-9 * timebase.numer / timebase.denom;
+    }
+    return mach_absolute_time() * secondsPerTick;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + 1e-9 * now.tv_nsec;
+#endif
+}
+
+void INTUAnimationTraceRecord(INTUAnimationTrace *trace, INTUAnimationTracePhase phase, intptr_t animationID, double start, int32_t argument)
+{
+    // Only the recording thread writes head, so a relaxed load is enough to read it. The slot is written under its sequence number (see
+    // INTUAnimationTraceCopyEvents()): it is marked odd before the fields are stored, and even with a release store after, and the
+    // release fence keeps the fields from being stored before the slot is marked odd.
+    uint64_t head = __atomic_load_n(&trace->head, __ATOMIC_RELAXED);
+    size_t slot = head & (trace->capacity - 1);
+    INTUAnimationTraceEvent *event = &trace->events[slot];
+    double duration = INTUAnimationTraceNow() - start;
+    int32_t phaseValue = phase;
+    __atomic_store_n(&trace->sequences[slot], 2 * head + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store(&event->start, &start, __ATOMIC_RELAXED);
+    __atomic_store(&event->duration, &duration, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->animationID, animationID, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->phase, phaseValue, __ATOMIC_RELAXED);
+    __atomic_store_n(&event->argument, argument, __ATOMIC_RELAXED);
+    __atomic_store_n(&trace->sequences[slot], 2 * head + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&trace->head, head + 1, __ATOMIC_RELEASE);
+}
+
+INTUAnimationTraceEvent *INTUAnimationTraceCopyEvents(const INTUAnimationTrace *trace, size_t *count)
+{
+    *count = 0;
+    uint64_t head = __atomic_load_n(&trace->head, __ATOMIC_ACQUIRE);
+    uint64_t first = head > trace->capacity ? head - trace->capacity : 0;
+    if (head == first) {
+        return NULL;
+    }
+    INTUAnimationTraceEvent *events = malloc(sizeof(INTUAnimationTraceEvent) * (size_t)(head - first));
+    if (!events) {
+        return NULL;
+    }
+    size_t copied = 0;
+    for (uint64_t i = first; i < head; i++) {
+        // Event i is only copied if its slot holds it, completely written, both before and after the fields are read. Otherwise the
+        // recording thread has overwritten the slot with a newer event (or is in the process of doing so), and the event is left out.
+        size_t slot = i & (trace->capacity - 1);
+        const INTUAnimationTraceEvent *source = &trace->events[slot];
+        INTUAnimationTraceEvent *event = &events[copied];
+        uint64_t sequence = __atomic_load_n(&trace->sequences[slot], __ATOMIC_ACQUIRE);
+        if (sequence != 2 * i + 2) {
+            continue;
+        }
+        __atomic_load(&source->start, &event->start, __ATOMIC_RELAXED);
+        __atomic_load(&source->duration, &event->duration, __ATOMIC_RELAXED);
+        event->animationID = __atomic_load_n(&source->animationID, __ATOMIC_RELAXED);
+        event->phase = __atomic_load_n(&source->phase, __ATOMIC_RELAXED);
+        event->argument = __atomic_load_n(&source->argument, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&trace->sequences[slot], __ATOMIC_RELAXED) != sequence) {
+            continue;
+        }
+        copied++;
+    }
+    if (copied == 0) {
+        free(events);
+        return NULL;
+    }
+    *count = copied;
+    return events;
+}
+
+char *INTUAnimationTraceCopyChromeJSON(const INTUAnimationTrace *trace, size_t *length)
+{
+    size_t count;
+    INTUAnimationTraceEvent *events = INTUAnimationTraceCopyEvents(trace, &count);
+    size_t capacity = 64 + count * kEventJSONLength;
+    char *json = malloc(capacity);
+    if (!json) {
+        free(events);
+        return NULL;
+    }
+    
+    // Timestamps are in microseconds. Every event is a complete ("X") event on a single thread; the viewer nests the spans of each frame
+    // by their times.
+    size_t position = 0;
+    bool succeeded = appendFormat(&json, &capacity, &position, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (size_t i = 0; i < count && succeeded; i++) {
+        const INTUAnimationTraceEvent *event = &events[i];
+        const char *name = (event->phase >= 0 && event->phase < INTUAnimationTracePhaseCount) ? kPhaseNames[event->phase] : "Unknown";
+        succeeded = appendFormat(&json, &capacity, &position,
+                                 "%s\n{\"name\":\"%.*s\",\"cat\":\"INTUAnimationEngine\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                                 "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"animationID\":%ld,\"argument\":%d}}",
+                                 i ? "," : "", kMaxNameLength, name, event->start * 1e6, event->duration * 1e6,
+                                 (long)event->animationID, (int)event->argument);
+    }
+    succeeded = succeeded && appendFormat(&json, &capacity, &position, "\n]}\n");
+    if (!succeeded) {
+        free(json);
+        free(events);
+        return NULL;
+    }
+    free(events);
+    
+    if (length) {
+        *length = position;
+    }
+    return json;
+}
+
+#pragma mark Internal Functions
+
+/**
+ Appends formatted text at the given position of a buffer allocated with malloc(), growing the buffer if the text does not fit, and
+ advances the position past it. Returns false (leaving the buffer and position unchanged) if the text could not be formatted or the
+ buffer could not grow.
+ */
+static bool appendFormat(char **buffer, size_t *capacity, size_t *position, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(*buffer + *position, *capacity - *position, format, arguments);
+    va_end(arguments);
+    if (length < 0) {
+        return false;
+    }
+    if ((size_t)length >= *capacity - *position) {
+        size_t newCapacity = *capacity * 2;
+        if (newCapacity < *position + (size_t)length + 1) {
+            newCapacity = *position + (size_t)length + 1;
+        }
+        char *newBuffer = realloc(*buffer, newCapacity);
+        if (!newBuffer) {
+            return false;
+        }
+        *buffer = newBuffer;
+        *capacity = newCapacity;
+        va_start(arguments, format);
+        vsnprintf(*buffer + *position, *capacity - *position, format, arguments);
+        va_end(arguments);
+    }
+    *position += (size_t)length;
+    return true;
+}
@@ -0,0 +1,149 @@
+//
+//  INTUAnimationTrace.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUAnimationTrace_h
+#define INTUAnimationTrace_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A trace records timestamped spans for each phase of each frame of the animation engine into a fixed size ring buffer, so that a single
+// slow frame can be inspected after the fact. The buffer is allocated when the trace is initialized; recording an event is a handful of
+// stores and one atomic increment, with no locks or allocations, and once the buffer is full the oldest events are overwritten.
+//
+// Events are recorded by a single thread (the thread that ticks the engine). The events can be exported as Chrome trace event JSON
+// (which can be opened in chrome://tracing, Perfetto, or Instruments) from any thread, including while recording continues.
+
+/** The phases of a frame that are recorded in a trace. */
+typedef enum {
+    /** One whole frame (tick) of the engine. All other phases of the frame are nested within this span. */
+    INTUAnimationTracePhaseFrame,
+    /** Reading the current time at the start of the frame. */
+    INTUAnimationTracePhaseClockRead,
+    /** Processing commands submitted from other threads. */
+    INTUAnimationTracePhaseCommandDrain,
+    /** Checking whether an animation's delay has elapsed. */
+    INTUAnimationTracePhaseDelayCheck,
+    /** Calculating the progress of an animation, including its easing function (or the decay or path it follows). */
+    INTUAnimationTracePhaseEasing,
+    /** Advancing a spring solver. The event's argument is the number of integration steps. */
+    INTUAnimationTracePhaseSpringIntegration,
+    /** Executing an animation's animations block. */
+    INTUAnimationTracePhaseCallback,
+    /** Calculating the values in the output buffer. The event's argument is the number of channels updated. */
+    INTUAnimationTracePhaseOutputUpdate,
+    /** Executing the output handler block. */
+    INTUAnimationTracePhaseOutputHandler,
+    /** Executing an animation's completion block. The event's argument is 1 if the animation finished, or 0 if it was canceled. */
+    INTUAnimationTracePhaseCompletion,
+    /** Adding an animation to the active animations. The event's argument is the number of active animations afterwards. */
+    INTUAnimationTracePhaseAdd,
+    /** Removing an animation from the active animations. The event's argument is the number of active animations afterwards. */
+    INTUAnimationTracePhaseRemove,
+    INTUAnimationTracePhaseCount
+} INTUAnimationTracePhase;
+
+/** One span recorded in a trace. */
+typedef struct {
+    /** The time the span started, in seconds (from INTUAnimationTraceNow()). */
+    double start;
+    /** The duration of the span, in seconds. */
+    double duration;
+    /** The ID of the animation the span applies to, or zero if it applies to the whole engine. */
+    intptr_t animationID;
+    /** The phase of the frame. */
+    int32_t phase;
+    /** An additional value that depends on the phase, such as a count of integration steps. */
+    int32_t argument;
+} INTUAnimationTraceEvent;
+
+/** A ring buffer of trace events. Must be initialized with INTUAnimationTraceInit() before use. */
+typedef struct {
+    INTUAnimationTraceEvent *events;
+    /**
+     A sequence number for each slot of the ring buffer, so that an event can be copied while the slot is being overwritten and the torn
+     copy detected. While event i is being written to its slot, the slot's sequence number is 2 * i + 1; once it is written, 2 * i + 2.
+     */
+    uint64_t *sequences;
+    /** The number of events the ring buffer holds. Always a power of two. */
+    size_t capacity;
+    /** The total number of events ever recorded. Event i is stored at index (i & (capacity - 1)). */
+    uint64_t head;
+} INTUAnimationTrace;
+
+/**
+ Initializes an empty trace that holds the given number of events, rounded up to a power of two.
+ 
+ @return Whether the buffer could be allocated.
+ */
+bool    INTUAnimationTraceInit(INTUAnimationTrace *trace, size_t capacity);
+
+/** Frees the memory used by the trace. */
+void    INTUAnimationTraceDestroy(INTUAnimationTrace *trace);
+
+/** Returns the current time in seconds, from the same monotonic clock as CACurrentMediaTime(). */
+double  INTUAnimationTraceNow(void);
+
+/** Records one span that started at the given time and ends now. Must only be called from one thread at a time. */
+void    INTUAnimationTraceRecord(INTUAnimationTrace *trace, INTUAnimationTracePhase phase, intptr_t animationID, double start, int32_t argument);
+
+/**
+ Copies the events currently in the trace, oldest first, into a newly allocated array. Safe to call from any thread while events are
+ being recorded; events that are overwritten during the copy are left out.
+ 
+ @param trace   The trace.
+ @param count   On return, the number of events in the array.
+ 
+ @return An array of events that the caller must free(), or NULL if there are no events (or allocation failed).
+ */
+INTUAnimationTraceEvent *INTUAnimationTraceCopyEvents(const INTUAnimationTrace *trace, size_t *count);
+
+/**
+ Formats the events currently in the trace as Chrome trace event JSON.
+ 
+ @param trace   The trace.
+ @param length  On return, the length of the string, excluding the null terminator.
+ 
+ @return A null terminated string that the caller must free(), or NULL if allocation failed.
+ */
+char *  INTUAnimationTraceCopyChromeJSON(const INTUAnimationTrace *trace, size_t *length);
+
+/** Returns the time to pass as the start of a span, or zero if trace is NULL (tracing is disabled). */
+static inline double INTUAnimationTraceBegin(INTUAnimationTrace *trace)
+{
+    return trace ? INTUAnimationTraceNow() : 0.0;
+}
+
+/** Records a span that started at the given time and ends now, if trace is not NULL (tracing is enabled). */
+static inline void INTUAnimationTraceEnd(INTUAnimationTrace *trace, INTUAnimationTracePhase phase, intptr_t animationID, double start, int32_t argument)
+{
+    if (trace) {
+        INTUAnimationTraceRecord(trace, phase, animationID, start, argument);
+    }
+}
+
+#endif /* INTUAnimationTrace_h */
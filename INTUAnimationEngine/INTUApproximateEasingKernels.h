@@ -0,0 +1,275 @@
+//
+//  INTUApproximateEasingKernels.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUApproximateEasingKernels_h
+#define INTUApproximateEasingKernels_h
+
+#include <stdint.h>
+#include <string.h>
+#include "INTUEasingKernels.h"
+
+// The approximate easing kernels are faster versions of the kernels for the curves built on transcendental functions (sine, exponential,
+// back and elastic). Instead of calling sin, cos and pow, they evaluate minimax polynomials after a cheap range reduction, so they are
+// branch-light, inline completely, and contain no library calls, which allows the compiler to vectorize batch loops over them (such as
+// INTUApplyEasingKernelf). They have the same names as the exact kernels, with "Approximate" inserted before "Kernel".
+//
+// Over the domain 0.0 <= p <= 1.0, every approximate kernel (double or float) is within 2e-6 (absolute error) of the exact double kernel,
+// and returns exactly 0.0 and 1.0 at the ends of the curve. The circular curves have no approximate kernels: sqrt is a single hardware
+// instruction on every supported architecture, and is already faster than a polynomial could be.
+
+#pragma mark - Approximate Functions
+
+/**
+ Returns an approximation of sin(PI * x). The argument is reduced to -0.5 <= r <= 0.5 around the nearest integer, then sin(PI * r) is
+ evaluated by a degree 7 odd minimax polynomial, with the constraint that sin(PI / 2) is exactly 1. Maximum absolute error is 7e-7.
+ */
+static inline double INTUApproximateSinPi(double x)
+{
+    double k = floor(x + 0.5);
+    double r = x - k;
+    double r2 = r * r;
+    double s = r * (3.141580651790798 + r2 * (-5.1670887243745005 + r2 * (2.541387271881249 + r2 * -0.5532912121440631)));
+    // sin(PI * (r + k)) = (-1)^k * sin(PI * r). The parity of k is found without converting it to an integer, which does not vectorize.
+    return (floor(0.5 * k) != 0.5 * k) ? -s : s;
+}
+
+static inline float INTUApproximateSinPif(float x)
+{
+    float k = floorf(x + 0.5f);
+    float r = x - k;
+    float r2 = r * r;
+    float s = r * (3.14158065f + r2 * (-5.16708872f + r2 * (2.54138727f + r2 * -0.553291212f)));
+    return (floorf(0.5f * k) != 0.5f * k) ? -s : s;
+}
+
+/**
+ Returns an approximation of 2^x. The argument is split into its integer part n and fractional part 0.0 <= f < 1.0; 2^f is evaluated by a
+ degree 5 minimax polynomial, with the constraint that 2^0 is exactly 1, and 2^n is applied by building its exponent bits directly.
+ Maximum relative error is 1.2e-7. Arguments are clamped to the range of normal numbers.
+ */
+static inline double INTUApproximateExp2(double x)
+{
+    x = (x < -1022.0) ? -1022.0 : ((x > 1023.0) ? 1023.0 : x);
+    double n = floor(x);
+    double f = x - n;
+    double p = 1.0 + f * (0.6931524714703895 + f * (0.24015280759274116 + f * (0.055835926867902806 + f * (0.008973378654129982 + f * 0.0018852974167727968))));
+    uint64_t bits = (uint64_t)((int32_t)n + 1023) << 52;
+    double scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+static inline float INTUApproximateExp2f(float x)
+{
+    x = (x < -126.0f) ? -126.0f : ((x > 127.0f) ? 127.0f : x);
+    float n = floorf(x);
+    float f = x - n;
+    float p = 1.0f + f * (0.693152471f + f * (0.240152808f + f * (0.0558359269f + f * (0.00897337865f + f * 0.00188529742f))));
+    uint32_t bits = (uint32_t)((int32_t)n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+
+#pragma mark - Sine
+
+// sin((p - 1) * PI/2) + 1
+static inline double INTUEaseInSineApproximateKernel(double p)
+{
+    return INTUApproximateSinPi(0.5 * (p - 1)) + 1;
+}
+
+static inline float INTUEaseInSineApproximateKernelf(float p)
+{
+    return INTUApproximateSinPif(0.5f * (p - 1)) + 1;
+}
+
+// sin(p * PI/2)
+static inline double INTUEaseOutSineApproximateKernel(double p)
+{
+    return INTUApproximateSinPi(0.5 * p);
+}
+
+static inline float INTUEaseOutSineApproximateKernelf(float p)
+{
+    return INTUApproximateSinPif(0.5f * p);
+}
+
+// (1/2)(1 - cos(p * PI)), where cos(p * PI) = sin((p + 1/2) * PI)
+static inline double INTUEaseInOutSineApproximateKernel(double p)
+{
+    return 0.5 * (1 - INTUApproximateSinPi(p + 0.5));
+}
+
+static inline float INTUEaseInOutSineApproximateKernelf(float p)
+{
+    return 0.5f * (1 - INTUApproximateSinPif(p + 0.5f));
+}
+
+
+#pragma mark - Exponential
+
+// pow(2, 10 * (p - 1))
+static inline double INTUEaseInExponentialApproximateKernel(double p)
+{
+    return (p == 0.0) ? p : INTUApproximateExp2(10 * (p - 1));
+}
+
+static inline float INTUEaseInExponentialApproximateKernelf(float p)
+{
+    return (p == 0.0f) ? p : INTUApproximateExp2f(10 * (p - 1));
+}
+
+// 1 - pow(2, -10 * p)
+static inline double INTUEaseOutExponentialApproximateKernel(double p)
+{
+    return (p == 1.0) ? p : 1 - INTUApproximateExp2(-10 * p);
+}
+
+static inline float INTUEaseOutExponentialApproximateKernelf(float p)
+{
+    return (p == 1.0f) ? p : 1 - INTUApproximateExp2f(-10 * p);
+}
+
+// (1/2)2^(10(2p - 1)) on [0, 0.5), -(1/2)*2^(-10(2p - 1)) + 1 on [0.5, 1]
+static inline double INTUEaseInOutExponentialApproximateKernel(double p)
+{
+    if (p == 0.0 || p == 1.0) return p;
+
+    if (p < 0.5) {
+        return 0.5 * INTUApproximateExp2((20 * p) - 10);
+    } else {
+        return -0.5 * INTUApproximateExp2((-20 * p) + 10) + 1;
+    }
+}
+
+static inline float INTUEaseInOutExponentialApproximateKernelf(float p)
+{
+    if (p == 0.0f || p == 1.0f) return p;
+
+    if (p < 0.5f) {
+        return 0.5f * INTUApproximateExp2f((20 * p) - 10);
+    } else {
+        return -0.5f * INTUApproximateExp2f((-20 * p) + 10) + 1;
+    }
+}
+
+
+#pragma mark - Back
+
+// p^3 - p*sin(p*pi)
+static inline double INTUEaseInBackApproximateKernel(double p)
+{
+    return p * p * p - p * INTUApproximateSinPi(p);
+}
+
+static inline float INTUEaseInBackApproximateKernelf(float p)
+{
+    return p * p * p - p * INTUApproximateSinPif(p);
+}
+
+// 1 - ((1 - p)^3 - (1 - p)*sin((1 - p)*pi))
+static inline double INTUEaseOutBackApproximateKernel(double p)
+{
+    double f = (1 - p);
+    return 1 - (f * f * f - f * INTUApproximateSinPi(f));
+}
+
+static inline float INTUEaseOutBackApproximateKernelf(float p)
+{
+    float f = (1 - p);
+    return 1 - (f * f * f - f * INTUApproximateSinPif(f));
+}
+
+// The in curve on [0, 0.5), the out curve on [0.5, 1], each scaled by 1/2
+static inline double INTUEaseInOutBackApproximateKernel(double p)
+{
+    if (p < 0.5) {
+        double f = 2 * p;
+        return 0.5 * (f * f * f - f * INTUApproximateSinPi(f));
+    } else {
+        double f = (1 - (2*p - 1));
+        return 0.5 * (1 - (f * f * f - f * INTUApproximateSinPi(f))) + 0.5;
+    }
+}
+
+static inline float INTUEaseInOutBackApproximateKernelf(float p)
+{
+    if (p < 0.5f) {
+        float f = 2 * p;
+        return 0.5f * (f * f * f - f * INTUApproximateSinPif(f));
+    } else {
+        float f = (1 - (2*p - 1));
+        return 0.5f * (1 - (f * f * f - f * INTUApproximateSinPif(f))) + 0.5f;
+    }
+}
+
+
+#pragma mark - Elastic
+
+// sin(13pi/2*p)*pow(2, 10 * (p - 1))
+static inline double INTUEaseInElasticApproximateKernel(double p)
+{
+    return INTUApproximateSinPi(6.5 * p) * INTUApproximateExp2(10 * (p - 1));
+}
+
+static inline float INTUEaseInElasticApproximateKernelf(float p)
+{
+    return INTUApproximateSinPif(6.5f * p) * INTUApproximateExp2f(10 * (p - 1));
+}
+
+// sin(-13pi/2*(p + 1))*pow(2, -10p) + 1
+static inline double INTUEaseOutElasticApproximateKernel(double p)
+{
+    return INTUApproximateSinPi(-6.5 * (p + 1)) * INTUApproximateExp2(-10 * p) + 1;
+}
+
+static inline float INTUEaseOutElasticApproximateKernelf(float p)
+{
+    return INTUApproximateSinPif(-6.5f * (p + 1)) * INTUApproximateExp2f(-10 * p) + 1;
+}
+
+// The in curve on [0, 0.5), the out curve on [0.5, 1], each scaled by 1/2
+static inline double INTUEaseInOutElasticApproximateKernel(double p)
+{
+    if (p < 0.5) {
+        return 0.5 * INTUApproximateSinPi(6.5 * (2 * p)) * INTUApproximateExp2(10 * ((2 * p) - 1));
+    } else {
+        return 0.5 * (INTUApproximateSinPi(-6.5 * ((2 * p - 1) + 1)) * INTUApproximateExp2(-10 * (2 * p - 1)) + 2);
+    }
+}
+
+static inline float INTUEaseInOutElasticApproximateKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 0.5f * INTUApproximateSinPif(6.5f * (2 * p)) * INTUApproximateExp2f(10 * ((2 * p) - 1));
+    } else {
+        return 0.5f * (INTUApproximateSinPif(-6.5f * ((2 * p - 1) + 1)) * INTUApproximateExp2f(-10 * (2 * p - 1)) + 2);
+    }
+}
+
+#endif /* INTUApproximateEasingKernels_h */
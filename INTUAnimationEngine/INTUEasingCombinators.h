@@ -0,0 +1,271 @@
+//
+//  INTUEasingCombinators.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUEasingCombinators_h
+#define INTUEasingCombinators_h
+
+// This header is C++ only. It is safe to include (or to be included by an umbrella header) from C or Objective-C, where it is empty.
+#ifdef __cplusplus
+
+#include "INTUEasingKernels.h"
+#include "INTUApproximateEasingKernels.h"
+
+#ifdef __OBJC__
+#import "INTUEasingFunctions.h"
+#endif /* __OBJC__ */
+
+// The easing combinators build new easing curves out of existing ones at compile time. Each of the curves in INTUEasingFunctions.h is
+// available as a stateless functor (for example, INTUEasing::EaseOutBack), and each combinator is a class template that holds the
+// curves it combines by value. Since the full type of a composed curve is known to the compiler, calling it compiles down to a single
+// inlined kernel, instead of one indirect block invocation per layer.
+//
+// Every curve and combinator has a constexpr constructor, so composed curves can be declared as constants:
+//
+//     constexpr auto kBounceBack = INTUEasing::mirror(INTUEasing::clamp(INTUEasing::EaseOutBack()));
+//
+// Curves are called with either a double or a float; the float overload uses the single precision kernels. A constant curve can be
+// exported as a plain INTUEasingKernel function pointer (or a batch kernel) using the INTU_EASING_KERNEL macros at the bottom of this
+// header, and from Objective-C++ any curve can be wrapped into an INTUEasingFunction block for use with INTUAnimationEngine.
+
+namespace INTUEasing {
+
+#pragma mark - Curves
+
+#define INTU_EASING_CURVE(name)                                                                 \
+    struct name {                                                                               \
+        constexpr name() {}                                                                     \
+        double operator()(double p) const { return INTU##name##Kernel(p); }                     \
+        float operator()(float p) const { return INTU##name##Kernelf(p); }                      \
+    };
+
+INTU_EASING_CURVE(Linear)
+INTU_EASING_CURVE(EaseInSine)
+INTU_EASING_CURVE(EaseOutSine)
+INTU_EASING_CURVE(EaseInOutSine)
+INTU_EASING_CURVE(EaseInQuadratic)
+INTU_EASING_CURVE(EaseOutQuadratic)
+INTU_EASING_CURVE(EaseInOutQuadratic)
+INTU_EASING_CURVE(EaseInCubic)
+INTU_EASING_CURVE(EaseOutCubic)
+INTU_EASING_CURVE(EaseInOutCubic)
+INTU_EASING_CURVE(EaseInQuartic)
+INTU_EASING_CURVE(EaseOutQuartic)
+INTU_EASING_CURVE(EaseInOutQuartic)
+INTU_EASING_CURVE(EaseInQuintic)
+INTU_EASING_CURVE(EaseOutQuintic)
+INTU_EASING_CURVE(EaseInOutQuintic)
+INTU_EASING_CURVE(EaseInExponential)
+INTU_EASING_CURVE(EaseOutExponential)
+INTU_EASING_CURVE(EaseInOutExponential)
+INTU_EASING_CURVE(EaseInCircular)
+INTU_EASING_CURVE(EaseOutCircular)
+INTU_EASING_CURVE(EaseInOutCircular)
+INTU_EASING_CURVE(EaseInBack)
+INTU_EASING_CURVE(EaseOutBack)
+INTU_EASING_CURVE(EaseInOutBack)
+INTU_EASING_CURVE(EaseInElastic)
+INTU_EASING_CURVE(EaseOutElastic)
+INTU_EASING_CURVE(EaseInOutElastic)
+INTU_EASING_CURVE(EaseInBounce)
+INTU_EASING_CURVE(EaseOutBounce)
+INTU_EASING_CURVE(EaseInOutBounce)
+INTU_EASING_CURVE(EaseInSineApproximate)
+INTU_EASING_CURVE(EaseOutSineApproximate)
+INTU_EASING_CURVE(EaseInOutSineApproximate)
+INTU_EASING_CURVE(EaseInExponentialApproximate)
+INTU_EASING_CURVE(EaseOutExponentialApproximate)
+INTU_EASING_CURVE(EaseInOutExponentialApproximate)
+INTU_EASING_CURVE(EaseInBackApproximate)
+INTU_EASING_CURVE(EaseOutBackApproximate)
+INTU_EASING_CURVE(EaseInOutBackApproximate)
+INTU_EASING_CURVE(EaseInElasticApproximate)
+INTU_EASING_CURVE(EaseOutElasticApproximate)
+INTU_EASING_CURVE(EaseInOutElasticApproximate)
+
+#undef INTU_EASING_CURVE
+
+/** A curve that always returns the same value. Mostly useful as the weight of a crossfade. */
+struct Constant {
+    constexpr Constant(double value) : value(value) {}
+    double operator()(double) const { return value; }
+    float operator()(float) const { return (float)value; }
+    double value;
+};
+
+
+#pragma mark - Combinators
+
+/**
+ The curve played backwards in time, and flipped so that it still runs from 0.0 to 1.0: 1 - f(1 - p).
+ Turns an ease in curve into the matching ease out curve, and vice versa.
+ */
+template <typename F>
+struct Reverse {
+    constexpr Reverse(F f) : f(f) {}
+    template <typename T> T operator()(T p) const { return 1 - f(1 - p); }
+    F f;
+};
+
+/**
+ The curve played forwards over the first half of the animation, and backwards over the second half, so that it ends where it started.
+ */
+template <typename F>
+struct Mirror {
+    constexpr Mirror(F f) : f(f) {}
+    template <typename T> T operator()(T p) const { return p < T(0.5) ? f(2 * p) : f(2 * (1 - p)); }
+    F f;
+};
+
+/**
+ Plays the first curve followed by the second. The first curve runs until split (0.0 < split < 1.0), and both its time and its output are
+ scaled to [0, split]; the second covers [split, 1]. If both curves run from 0.0 to 1.0, the sequence is continuous at the split.
+ */
+template <typename A, typename B>
+struct Sequence {
+    constexpr Sequence(A a, B b, double split) : a(a), b(b), split(split) {}
+    template <typename T> T operator()(T p) const
+    {
+        const T s = (T)split;
+        return p < s ? s * a(p / s) : s + (1 - s) * b((p - s) / (1 - s));
+    }
+    A a;
+    B b;
+    double split;
+};
+
+/**
+ Blends between two curves: (1 - w(p)) * a(p) + w(p) * b(p), where the weight w is itself a curve. Use a Constant weight for a fixed blend,
+ or Linear to fade from the first curve to the second over the course of the animation.
+ */
+template <typename A, typename B, typename W>
+struct Crossfade {
+    constexpr Crossfade(A a, B b, W w) : a(a), b(b), w(w) {}
+    template <typename T> T operator()(T p) const
+    {
+        const T weight = w(p);
+        return (1 - weight) * a(p) + weight * b(p);
+    }
+    A a;
+    B b;
+    W w;
+};
+
+/** Clamps the output of the curve to [minimum, maximum], for example to remove the overshoot of the back or elastic curves. */
+template <typename F>
+struct Clamp {
+    constexpr Clamp(F f, double minimum, double maximum) : f(f), minimum(minimum), maximum(maximum) {}
+    template <typename T> T operator()(T p) const
+    {
+        const T value = f(p);
+        return value < (T)minimum ? (T)minimum : (value > (T)maximum ? (T)maximum : value);
+    }
+    F f;
+    double minimum;
+    double maximum;
+};
+
+/** Maps the output of the curve from [0, 1] to [start, end]. */
+template <typename F>
+struct Scale {
+    constexpr Scale(F f, double start, double end) : f(f), start(start), end(end) {}
+    template <typename T> T operator()(T p) const { return (T)start + (T)(end - start) * f(p); }
+    F f;
+    double start;
+    double end;
+};
+
+template <typename F>
+constexpr Reverse<F> reverse(F f) { return Reverse<F>(f); }
+
+template <typename F>
+constexpr Mirror<F> mirror(F f) { return Mirror<F>(f); }
+
+template <typename A, typename B>
+constexpr Sequence<A, B> sequence(A a, B b, double split = 0.5) { return Sequence<A, B>(a, b, split); }
+
+template <typename A, typename B>
+constexpr Crossfade<A, B, Constant> crossfade(A a, B b, double weight) { return Crossfade<A, B, Constant>(a, b, Constant(weight)); }
+
+template <typename A, typename B, typename W>
+constexpr Crossfade<A, B, W> crossfade(A a, B b, W weight) { return Crossfade<A, B, W>(a, b, weight); }
+
+template <typename F>
+constexpr Clamp<F> clamp(F f, double minimum = 0.0, double maximum = 1.0) { return Clamp<F>(f, minimum, maximum); }
+
+template <typename F>
+constexpr Scale<F> scale(F f, double start, double end) { return Scale<F>(f, start, end); }
+
+
+#pragma mark - Evaluation
+
+/** Evaluates the curve for each of the count values in input, writing the results to output. The curve is inlined into the loop. */
+template <typename F, typename T>
+inline void apply(const F &f, const T *input, T *output, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        output[i] = f(input[i]);
+    }
+}
+
+// Implementation details of the INTU_EASING_KERNEL macros. Each instantiation is a distinct plain function for one constant curve.
+template <typename F, F &curve> double exportedKernel(double p) { return curve(p); }
+template <typename F, F &curve> float exportedKernelf(float p) { return curve(p); }
+template <typename F, F &curve> void exportedBatchKernel(const double *input, double *output, size_t count) { apply(curve, input, output, count); }
+template <typename F, F &curve> void exportedBatchKernelf(const float *input, float *output, size_t count) { apply(curve, input, output, count); }
+
+#ifdef __OBJC__
+/** Wraps the curve in an easing function block, for use with the INTUAnimationEngine API. The block holds a copy of the curve. */
+template <typename F>
+inline INTUEasingFunction easingFunction(F f)
+{
+    return ^CGFloat(CGFloat p) {
+        return f(p);
+    };
+}
+#endif /* __OBJC__ */
+
+} // namespace INTUEasing
+
+/** A pointer to a function that evaluates a double precision easing kernel for count values. */
+typedef void (*INTUEasingBatchKernel)(const double *input, double *output, size_t count);
+
+/** A pointer to a function that evaluates a single precision easing kernel for count values. */
+typedef void (*INTUEasingBatchKernelf)(const float *input, float *output, size_t count);
+
+// These macros export a curve declared as a constant (constexpr at namespace scope, or a static constexpr member) as a plain function
+// pointer: INTU_EASING_KERNEL returns an INTUEasingKernel, INTU_EASING_KERNELF an INTUEasingKernelf, and the batch variants an
+// INTUEasingBatchKernel or INTUEasingBatchKernelf. For example:
+//
+//     static constexpr auto kSoftBack = INTUEasing::crossfade(INTUEasing::EaseOutBack(), INTUEasing::EaseOutCubic(), 0.5);
+//     INTUEasingKernel kernel = INTU_EASING_KERNEL(kSoftBack);
+#define INTU_EASING_KERNEL(curve)         (&INTUEasing::exportedKernel<decltype(curve), curve>)
+#define INTU_EASING_KERNELF(curve)        (&INTUEasing::exportedKernelf<decltype(curve), curve>)
+#define INTU_EASING_BATCH_KERNEL(curve)   (&INTUEasing::exportedBatchKernel<decltype(curve), curve>)
+#define INTU_EASING_BATCH_KERNELF(curve)  (&INTUEasing::exportedBatchKernelf<decltype(curve), curve>)
+
+#endif /* __cplusplus */
+
+#endif /* INTUEasingCombinators_h */
@@ -25,6 +25,7 @@
 //
 
 #import <CoreGraphics/CGBase.h>
+#include "INTUEasingTable.h"
 
 /**
  A block that takes 1 argument (completion percentage) of type CGFloat (in range 0.0 <= p <= 1.0) and returns a CGFloat.
@@ -34,6 +35,9 @@
  */
 typedef CGFloat (^INTUEasingFunction)(CGFloat);
 
+// Plain C implementations of each of the easing functions below (including single precision variants for batch evaluation) are
+// available in INTUEasingKernels.h, and approximate kernels for the transcendental curves in INTUApproximateEasingKernels.h.
+
 // Linear interpolation (no easing)
 extern INTUEasingFunction INTULinear;
 
@@ -86,3 +90,39 @@ extern INTUEasingFunction INTUEaseInOutElastic;
 extern INTUEasingFunction INTUEaseInBounce;
 extern INTUEasingFunction INTUEaseOutBounce;
 extern INTUEasingFunction INTUEaseInOutBounce;
+
+// Approximate versions of the curves above that are built on sin, cos and pow, which evaluate the polynomial kernels in
+// INTUApproximateEasingKernels.h instead. Each is within 2e-6 of the exact curve for 0.0 <= p <= 1.0, and several times faster.
+extern INTUEasingFunction INTUEaseInSineApproximate;
+extern INTUEasingFunction INTUEaseOutSineApproximate;
+extern INTUEasingFunction INTUEaseInOutSineApproximate;
+extern INTUEasingFunction INTUEaseInExponentialApproximate;
+extern INTUEasingFunction INTUEaseOutExponentialApproximate;
+extern INTUEasingFunction INTUEaseInOutExponentialApproximate;
+extern INTUEasingFunction INTUEaseInBackApproximate;
+extern INTUEasingFunction INTUEaseOutBackApproximate;
+extern INTUEasingFunction INTUEaseInOutBackApproximate;
+extern INTUEasingFunction INTUEaseInElasticApproximate;
+extern INTUEasingFunction INTUEaseOutElasticApproximate;
+extern INTUEasingFunction INTUEaseInOutElasticApproximate;
+
+/**
+ Returns the approximate version of the given built-in easing function, or the easing function itself if it has none (including custom
+ easing functions, nil, and the built-in curves that are already cheap to evaluate).
+ */
+extern INTUEasingFunction INTUApproximateEasingFunction(INTUEasingFunction easingFunction);
+
+// Baked easing functions evaluate a lookup table (see INTUEasingTable.h) instead of a formula, which makes expensive or composite curves
+// as cheap to evaluate as the simplest built-in ones.
+
+/**
+ Returns an easing function that evaluates the given easing table. The easing function takes ownership of the table, and destroys it when
+ the easing function is deallocated.
+ */
+extern INTUEasingFunction INTUEasingFunctionWithTable(INTUEasingTableRef table);
+
+/**
+ Bakes the given easing function into an easing table with the given number of segments, and returns an easing function that evaluates the
+ table. Returns nil if the segment count is invalid. If error is not NULL, on return it reports how closely the table matches the curve.
+ */
+extern INTUEasingFunction INTUBakeEasingFunction(INTUEasingFunction easingFunction, size_t segmentCount, INTUEasingTableError *error);
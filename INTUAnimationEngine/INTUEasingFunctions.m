@@ -24,262 +24,262 @@
 //  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //
 
+#import <Foundation/Foundation.h>
 #import "INTUEasingFunctions.h"
-#include <math.h>
+#include "INTUEasingKernels.h"
+#include "INTUApproximateEasingKernels.h"
+
+// Each easing function is implemented by the double precision kernel of the same name in INTUEasingKernels.h.
 
-// Modeled after the line y = x
 INTUEasingFunction INTULinear = ^CGFloat (CGFloat p) {
-    return p;
+    return INTULinearKernel(p);
 };
 
-// Modeled after quarter-cycle of sine wave
 INTUEasingFunction INTUEaseInSine = ^CGFloat (CGFloat p) {
-    return sin((p - 1) * M_PI_2) + 1;
+    return INTUEaseInSineKernel(p);
 };
 
-// Modeled after quarter-cycle of sine wave (different phase)
 INTUEasingFunction INTUEaseOutSine = ^CGFloat (CGFloat p) {
-    return sin(p * M_PI_2);
+    return INTUEaseOutSineKernel(p);
 };
 
-// Modeled after half sine wave
 INTUEasingFunction INTUEaseInOutSine = ^CGFloat (CGFloat p) {
-    return 0.5 * (1 - cos(p * M_PI));
+    return INTUEaseInOutSineKernel(p);
 };
 
-// Modeled after the parabola y = x^2
 INTUEasingFunction INTUEaseInQuadratic = ^CGFloat (CGFloat p) {
-    return p * p;
+    return INTUEaseInQuadraticKernel(p);
 };
 
-// Modeled after the parabola y = -x^2 + 2x
 INTUEasingFunction INTUEaseOutQuadratic = ^CGFloat (CGFloat p) {
-    return -(p * (p - 2));
+    return INTUEaseOutQuadraticKernel(p);
 };
 
-// Modeled after the piecewise quadratic
-// y = (1/2)((2x)^2)             ; [0, 0.5)
-// y = -(1/2)((2x-1)*(2x-3) - 1) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutQuadratic = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 2 * p * p;
-    }
-    else
-    {
-        return (-2 * p * p) + (4 * p) - 1;
-    }
+    return INTUEaseInOutQuadraticKernel(p);
 };
 
-// Modeled after the cubic y = x^3
 INTUEasingFunction INTUEaseInCubic = ^CGFloat (CGFloat p) {
-    return p * p * p;
+    return INTUEaseInCubicKernel(p);
 };
 
-// Modeled after the cubic y = (x - 1)^3 + 1
 INTUEasingFunction INTUEaseOutCubic = ^CGFloat (CGFloat p) {
-    CGFloat f = (p - 1);
-    return f * f * f + 1;
+    return INTUEaseOutCubicKernel(p);
 };
 
-// Modeled after the piecewise cubic
-// y = (1/2)((2x)^3)       ; [0, 0.5)
-// y = (1/2)((2x-2)^3 + 2) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutCubic = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 4 * p * p * p;
-    }
-    else
-    {
-        CGFloat f = ((2 * p) - 2);
-        return 0.5 * f * f * f + 1;
-    }
+    return INTUEaseInOutCubicKernel(p);
 };
 
-// Modeled after the quartic x^4
 INTUEasingFunction INTUEaseInQuartic = ^CGFloat (CGFloat p) {
-    return p * p * p * p;
+    return INTUEaseInQuarticKernel(p);
 };
 
-// Modeled after the quartic y = 1 - (x - 1)^4
 INTUEasingFunction INTUEaseOutQuartic = ^CGFloat (CGFloat p) {
-    CGFloat f = (p - 1);
-    return f * f * f * (1 - p) + 1;
+    return INTUEaseOutQuarticKernel(p);
 };
 
-// Modeled after the piecewise quartic
-// y = (1/2)((2x)^4)        ; [0, 0.5)
-// y = -(1/2)((2x-2)^4 - 2) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutQuartic = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 8 * p * p * p * p;
-    }
-    else
-    {
-        CGFloat f = (p - 1);
-        return -8 * f * f * f * f + 1;
-    }
+    return INTUEaseInOutQuarticKernel(p);
 };
 
-// Modeled after the quintic y = x^5
 INTUEasingFunction INTUEaseInQuintic = ^CGFloat (CGFloat p) {
-    return p * p * p * p * p;
+    return INTUEaseInQuinticKernel(p);
 };
 
-// Modeled after the quintic y = (x - 1)^5 + 1
 INTUEasingFunction INTUEaseOutQuintic = ^CGFloat (CGFloat p) {
-    CGFloat f = (p - 1);
-    return f * f * f * f * f + 1;
+    return INTUEaseOutQuinticKernel(p);
 };
 
-// Modeled after the piecewise quintic
-// y = (1/2)((2x)^5)       ; [0, 0.5)
-// y = (1/2)((2x-2)^5 + 2) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutQuintic = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 16 * p * p * p * p * p;
-    }
-    else
-    {
-        CGFloat f = ((2 * p) - 2);
-        return  0.5 * f * f * f * f * f + 1;
-    }
+    return INTUEaseInOutQuinticKernel(p);
 };
 
-// Modeled after the exponential function y = 2^(10(x - 1))
 INTUEasingFunction INTUEaseInExponential = ^CGFloat (CGFloat p) {
-    return (p == 0.0) ? p : pow(2, 10 * (p - 1));
+    return INTUEaseInExponentialKernel(p);
 };
 
-// Modeled after the exponential function y = -2^(-10x) + 1
 INTUEasingFunction INTUEaseOutExponential = ^CGFloat (CGFloat p) {
-    return (p == 1.0) ? p : 1 - pow(2, -10 * p);
+    return INTUEaseOutExponentialKernel(p);
 };
 
-// Modeled after the piecewise exponential
-// y = (1/2)2^(10(2x - 1))         ; [0,0.5)
-// y = -(1/2)*2^(-10(2x - 1))) + 1 ; [0.5,1]
 INTUEasingFunction INTUEaseInOutExponential = ^CGFloat (CGFloat p) {
-    if(p == 0.0 || p == 1.0) return p;
-    
-    if(p < 0.5)
-    {
-        return 0.5 * pow(2, (20 * p) - 10);
-    }
-    else
-    {
-        return -0.5 * pow(2, (-20 * p) + 10) + 1;
-    }
+    return INTUEaseInOutExponentialKernel(p);
 };
 
-// Modeled after shifted quadrant IV of unit circle
 INTUEasingFunction INTUEaseInCircular = ^CGFloat (CGFloat p) {
-    return 1 - sqrt(1 - (p * p));
+    return INTUEaseInCircularKernel(p);
 };
 
-// Modeled after shifted quadrant II of unit circle
 INTUEasingFunction INTUEaseOutCircular = ^CGFloat (CGFloat p) {
-    return sqrt((2 - p) * p);
+    return INTUEaseOutCircularKernel(p);
 };
 
-// Modeled after the piecewise circular function
-// y = (1/2)(1 - sqrt(1 - 4x^2))           ; [0, 0.5)
-// y = (1/2)(sqrt(-(2x - 3)*(2x - 1)) + 1) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutCircular = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 0.5 * (1 - sqrt(1 - 4 * (p * p)));
-    }
-    else
-    {
-        return 0.5 * (sqrt(-((2 * p) - 3) * ((2 * p) - 1)) + 1);
-    }
+    return INTUEaseInOutCircularKernel(p);
 };
 
-// Modeled after the overshooting cubic y = x^3-x*sin(x*pi)
 INTUEasingFunction INTUEaseInBack = ^CGFloat (CGFloat p) {
-    return p * p * p - p * sin(p * M_PI);
+    return INTUEaseInBackKernel(p);
 };
 
-// Modeled after overshooting cubic y = 1-((1-x)^3-(1-x)*sin((1-x)*pi))
 INTUEasingFunction INTUEaseOutBack = ^CGFloat (CGFloat p) {
-    CGFloat f = (1 - p);
-    return 1 - (f * f * f - f * sin(f * M_PI));
+    return INTUEaseOutBackKernel(p);
 };
 
-// Modeled after the piecewise overshooting cubic function:
-// y = (1/2)*((2x)^3-(2x)*sin(2*x*pi))           ; [0, 0.5)
-// y = (1/2)*(1-((1-x)^3-(1-x)*sin((1-x)*pi))+1) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutBack = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        CGFloat f = 2 * p;
-        return 0.5 * (f * f * f - f * sin(f * M_PI));
-    }
-    else
-    {
-        CGFloat f = (1 - (2*p - 1));
-        return 0.5 * (1 - (f * f * f - f * sin(f * M_PI))) + 0.5;
-    }
+    return INTUEaseInOutBackKernel(p);
 };
 
-// Modeled after the damped sine wave y = sin(13pi/2*x)*pow(2, 10 * (x - 1))
 INTUEasingFunction INTUEaseInElastic = ^CGFloat (CGFloat p) {
-    return sin(13 * M_PI_2 * p) * pow(2, 10 * (p - 1));
+    return INTUEaseInElasticKernel(p);
 };
 
-// Modeled after the damped sine wave y = sin(-13pi/2*(x + 1))*pow(2, -10x) + 1
 INTUEasingFunction INTUEaseOutElastic = ^CGFloat (CGFloat p) {
-    return sin(-13 * M_PI_2 * (p + 1)) * pow(2, -10 * p) + 1;
+    return INTUEaseOutElasticKernel(p);
 };
 
-// Modeled after the piecewise exponentially-damped sine wave:
-// y = (1/2)*sin(13pi/2*(2*x))*pow(2, 10 * ((2*x) - 1))      ; [0,0.5)
-// y = (1/2)*(sin(-13pi/2*((2x-1)+1))*pow(2,-10(2*x-1)) + 2) ; [0.5, 1]
 INTUEasingFunction INTUEaseInOutElastic = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 0.5 * sin(13 * M_PI_2 * (2 * p)) * pow(2, 10 * ((2 * p) - 1));
-    }
-    else
-    {
-        return 0.5 * (sin(-13 * M_PI_2 * ((2 * p - 1) + 1)) * pow(2, -10 * (2 * p - 1)) + 2);
-    }
+    return INTUEaseInOutElasticKernel(p);
 };
 
 INTUEasingFunction INTUEaseInBounce = ^CGFloat (CGFloat p) {
-    return 1 - INTUEaseOutBounce(1 - p);
+    return INTUEaseInBounceKernel(p);
 };
 
 INTUEasingFunction INTUEaseOutBounce = ^CGFloat (CGFloat p) {
-    if(p < 4/11.0)
-    {
-        return (121 * p * p)/16.0;
-    }
-    else if(p < 8/11.0)
-    {
-        return (363/40.0 * p * p) - (99/10.0 * p) + 17/5.0;
-    }
-    else if(p < 9/10.0)
-    {
-        return (4356/361.0 * p * p) - (35442/1805.0 * p) + 16061/1805.0;
-    }
-    else
-    {
-        return (54/5.0 * p * p) - (513/25.0 * p) + 268/25.0;
-    }
+    return INTUEaseOutBounceKernel(p);
 };
 
 INTUEasingFunction INTUEaseInOutBounce = ^CGFloat (CGFloat p) {
-    if(p < 0.5)
-    {
-        return 0.5 * INTUEaseInBounce(p*2);
+    return INTUEaseInOutBounceKernel(p);
+};
+
+
+#pragma mark - Approximate Easing Functions
+
+// Each approximate easing function is implemented by the approximate kernel of the same name in INTUApproximateEasingKernels.h.
+
+INTUEasingFunction INTUEaseInSineApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInSineApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseOutSineApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseOutSineApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInOutSineApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInOutSineApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInExponentialApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInExponentialApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseOutExponentialApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseOutExponentialApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInOutExponentialApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInOutExponentialApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInBackApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInBackApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseOutBackApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseOutBackApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInOutBackApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInOutBackApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInElasticApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInElasticApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseOutElasticApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseOutElasticApproximateKernel(p);
+};
+
+INTUEasingFunction INTUEaseInOutElasticApproximate = ^CGFloat (CGFloat p) {
+    return INTUEaseInOutElasticApproximateKernel(p);
+};
+
+INTUEasingFunction INTUApproximateEasingFunction(INTUEasingFunction easingFunction)
+{
+    if (easingFunction == nil) {
+        return nil;
     }
-    else
-    {
-        return 0.5 * INTUEaseOutBounce(p * 2 - 1) + 0.5;
+    // Compare against the block pointers of the exact curves, in the same order as the approximate curves.
+    INTUEasingFunction exactFunctions[] = {
+        INTUEaseInSine, INTUEaseOutSine, INTUEaseInOutSine,
+        INTUEaseInExponential, INTUEaseOutExponential, INTUEaseInOutExponential,
+        INTUEaseInBack, INTUEaseOutBack, INTUEaseInOutBack,
+        INTUEaseInElastic, INTUEaseOutElastic, INTUEaseInOutElastic
+    };
+    INTUEasingFunction approximateFunctions[] = {
+        INTUEaseInSineApproximate, INTUEaseOutSineApproximate, INTUEaseInOutSineApproximate,
+        INTUEaseInExponentialApproximate, INTUEaseOutExponentialApproximate, INTUEaseInOutExponentialApproximate,
+        INTUEaseInBackApproximate, INTUEaseOutBackApproximate, INTUEaseInOutBackApproximate,
+        INTUEaseInElasticApproximate, INTUEaseOutElasticApproximate, INTUEaseInOutElasticApproximate
+    };
+    for (size_t i = 0; i < sizeof(exactFunctions) / sizeof(exactFunctions[0]); i++) {
+        if (easingFunction == exactFunctions[i]) {
+            return approximateFunctions[i];
+        }
     }
-};
+    return easingFunction;
+}
+
+
+#pragma mark - Baked Easing Functions
+
+/**
+ Owns an easing table, destroying it when deallocated, so that the table lives as long as the easing function block that captures it.
+ */
+@interface INTUEasingTableOwner : NSObject
+
+@property (nonatomic, assign) INTUEasingTableRef table;
+
+@end
+
+@implementation INTUEasingTableOwner
+
+- (void)dealloc
+{
+    INTUEasingTableDestroy(_table);
+    _table = NULL;
+}
+
+@end
+
+/** Evaluates the easing function block passed as the context. Used to bake easing functions with INTUEasingTableCreateWithFunction(). */
+static double INTUEvaluateEasingFunction(double p, void *context)
+{
+    INTUEasingFunction easingFunction = (__bridge INTUEasingFunction)context;
+    return easingFunction(p);
+}
+
+INTUEasingFunction INTUEasingFunctionWithTable(INTUEasingTableRef table)
+{
+    if (table == NULL) {
+        return nil;
+    }
+    INTUEasingTableOwner *owner = [INTUEasingTableOwner new];
+    owner.table = table;
+    return ^CGFloat (CGFloat p) {
+        return INTUEasingTableEvaluate(owner.table, p);
+    };
+}
+
+INTUEasingFunction INTUBakeEasingFunction(INTUEasingFunction easingFunction, size_t segmentCount, INTUEasingTableError *error)
+{
+    if (easingFunction == nil) {
+        return nil;
+    }
+    INTUEasingTableRef table = INTUEasingTableCreateWithFunction(INTUEvaluateEasingFunction, (__bridge void *)easingFunction, segmentCount, error);
+    return INTUEasingFunctionWithTable(table);
+}
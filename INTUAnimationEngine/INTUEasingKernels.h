@@ -0,0 +1,565 @@
+//
+//  INTUEasingKernels.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUEasingKernels_h
+#define INTUEasingKernels_h
+
+#include <math.h>
+#include <stddef.h>
+
+// The easing kernels are plain C implementations of the curves in INTUEasingFunctions.h. The easing function blocks are implemented
+// on top of the double precision kernels, so both always produce identical results.
+//
+// Each curve also has a single precision (float) kernel, suffixed with "f". These are intended for batch code that evaluates many
+// animations at once: a float kernel fits twice as many lanes in a SIMD register and halves the memory bandwidth of the inputs and
+// outputs. Over the domain 0.0 <= p <= 1.0, every float kernel is within 2e-6 (absolute error) of the corresponding double kernel for
+// the same input, which is far below the precision needed to position anything onscreen.
+
+/** A pointer to a double precision easing kernel. */
+typedef double (*INTUEasingKernel)(double p);
+
+/** A pointer to a single precision easing kernel. */
+typedef float (*INTUEasingKernelf)(float p);
+
+/** Evaluates the easing kernel for each of the count values in input, writing the results to output. */
+static inline void INTUApplyEasingKernel(INTUEasingKernel kernel, const double *input, double *output, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        output[i] = kernel(input[i]);
+    }
+}
+
+/** Evaluates the single precision easing kernel for each of the count values in input, writing the results to output. */
+static inline void INTUApplyEasingKernelf(INTUEasingKernelf kernel, const float *input, float *output, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        output[i] = kernel(input[i]);
+    }
+}
+
+
+#pragma mark - Linear
+
+// Modeled after the line y = x
+static inline double INTULinearKernel(double p)
+{
+    return p;
+}
+
+static inline float INTULinearKernelf(float p)
+{
+    return p;
+}
+
+
+#pragma mark - Sine
+
+// Modeled after quarter-cycle of sine wave
+static inline double INTUEaseInSineKernel(double p)
+{
+    return sin((p - 1) * M_PI_2) + 1;
+}
+
+static inline float INTUEaseInSineKernelf(float p)
+{
+    return sinf((p - 1) * (float)M_PI_2) + 1;
+}
+
+// Modeled after quarter-cycle of sine wave (different phase)
+static inline double INTUEaseOutSineKernel(double p)
+{
+    return sin(p * M_PI_2);
+}
+
+static inline float INTUEaseOutSineKernelf(float p)
+{
+    return sinf(p * (float)M_PI_2);
+}
+
+// Modeled after half sine wave
+static inline double INTUEaseInOutSineKernel(double p)
+{
+    return 0.5 * (1 - cos(p * M_PI));
+}
+
+static inline float INTUEaseInOutSineKernelf(float p)
+{
+    return 0.5f * (1 - cosf(p * (float)M_PI));
+}
+
+
+#pragma mark - Quadratic
+
+// Modeled after the parabola y = x^2
+static inline double INTUEaseInQuadraticKernel(double p)
+{
+    return p * p;
+}
+
+static inline float INTUEaseInQuadraticKernelf(float p)
+{
+    return p * p;
+}
+
+// Modeled after the parabola y = -x^2 + 2x
+static inline double INTUEaseOutQuadraticKernel(double p)
+{
+    return -(p * (p - 2));
+}
+
+static inline float INTUEaseOutQuadraticKernelf(float p)
+{
+    return -(p * (p - 2));
+}
+
+// Modeled after the piecewise quadratic
+// y = (1/2)((2x)^2)             ; [0, 0.5)
+// y = -(1/2)((2x-1)*(2x-3) - 1) ; [0.5, 1]
+static inline double INTUEaseInOutQuadraticKernel(double p)
+{
+    if (p < 0.5) {
+        return 2 * p * p;
+    } else {
+        return (-2 * p * p) + (4 * p) - 1;
+    }
+}
+
+static inline float INTUEaseInOutQuadraticKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 2 * p * p;
+    } else {
+        return (-2 * p * p) + (4 * p) - 1;
+    }
+}
+
+
+#pragma mark - Cubic
+
+// Modeled after the cubic y = x^3
+static inline double INTUEaseInCubicKernel(double p)
+{
+    return p * p * p;
+}
+
+static inline float INTUEaseInCubicKernelf(float p)
+{
+    return p * p * p;
+}
+
+// Modeled after the cubic y = (x - 1)^3 + 1
+static inline double INTUEaseOutCubicKernel(double p)
+{
+    double f = (p - 1);
+    return f * f * f + 1;
+}
+
+static inline float INTUEaseOutCubicKernelf(float p)
+{
+    float f = (p - 1);
+    return f * f * f + 1;
+}
+
+// Modeled after the piecewise cubic
+// y = (1/2)((2x)^3)       ; [0, 0.5)
+// y = (1/2)((2x-2)^3 + 2) ; [0.5, 1]
+static inline double INTUEaseInOutCubicKernel(double p)
+{
+    if (p < 0.5) {
+        return 4 * p * p * p;
+    } else {
+        double f = ((2 * p) - 2);
+        return 0.5 * f * f * f + 1;
+    }
+}
+
+static inline float INTUEaseInOutCubicKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 4 * p * p * p;
+    } else {
+        float f = ((2 * p) - 2);
+        return 0.5f * f * f * f + 1;
+    }
+}
+
+
+#pragma mark - Quartic
+
+// Modeled after the quartic x^4
+static inline double INTUEaseInQuarticKernel(double p)
+{
+    return p * p * p * p;
+}
+
+static inline float INTUEaseInQuarticKernelf(float p)
+{
+    return p * p * p * p;
+}
+
+// Modeled after the quartic y = 1 - (x - 1)^4
+static inline double INTUEaseOutQuarticKernel(double p)
+{
+    double f = (p - 1);
+    return f * f * f * (1 - p) + 1;
+}
+
+static inline float INTUEaseOutQuarticKernelf(float p)
+{
+    float f = (p - 1);
+    return f * f * f * (1 - p) + 1;
+}
+
+// Modeled after the piecewise quartic
+// y = (1/2)((2x)^4)        ; [0, 0.5)
+// y = -(1/2)((2x-2)^4 - 2) ; [0.5, 1]
+static inline double INTUEaseInOutQuarticKernel(double p)
+{
+    if (p < 0.5) {
+        return 8 * p * p * p * p;
+    } else {
+        double f = (p - 1);
+        return -8 * f * f * f * f + 1;
+    }
+}
+
+static inline float INTUEaseInOutQuarticKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 8 * p * p * p * p;
+    } else {
+        float f = (p - 1);
+        return -8 * f * f * f * f + 1;
+    }
+}
+
+
+#pragma mark - Quintic
+
+// Modeled after the quintic y = x^5
+static inline double INTUEaseInQuinticKernel(double p)
+{
+    return p * p * p * p * p;
+}
+
+static inline float INTUEaseInQuinticKernelf(float p)
+{
+    return p * p * p * p * p;
+}
+
+// Modeled after the quintic y = (x - 1)^5 + 1
+static inline double INTUEaseOutQuinticKernel(double p)
+{
+    double f = (p - 1);
+    return f * f * f * f * f + 1;
+}
+
+static inline float INTUEaseOutQuinticKernelf(float p)
+{
+    float f = (p - 1);
+    return f * f * f * f * f + 1;
+}
+
+// Modeled after the piecewise quintic
+// y = (1/2)((2x)^5)       ; [0, 0.5)
+// y = (1/2)((2x-2)^5 + 2) ; [0.5, 1]
+static inline double INTUEaseInOutQuinticKernel(double p)
+{
+    if (p < 0.5) {
+        return 16 * p * p * p * p * p;
+    } else {
+        double f = ((2 * p) - 2);
+        return 0.5 * f * f * f * f * f + 1;
+    }
+}
+
+static inline float INTUEaseInOutQuinticKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 16 * p * p * p * p * p;
+    } else {
+        float f = ((2 * p) - 2);
+        return 0.5f * f * f * f * f * f + 1;
+    }
+}
+
+
+#pragma mark - Exponential
+
+// Modeled after the exponential function y = 2^(10(x - 1))
+static inline double INTUEaseInExponentialKernel(double p)
+{
+    return (p == 0.0) ? p : pow(2, 10 * (p - 1));
+}
+
+static inline float INTUEaseInExponentialKernelf(float p)
+{
+    return (p == 0.0f) ? p : exp2f(10 * (p - 1));
+}
+
+// Modeled after the exponential function y = -2^(-10x) + 1
+static inline double INTUEaseOutExponentialKernel(double p)
+{
+    return (p == 1.0) ? p : 1 - pow(2, -10 * p);
+}
+
+static inline float INTUEaseOutExponentialKernelf(float p)
+{
+    return (p == 1.0f) ? p : 1 - exp2f(-10 * p);
+}
+
+// Modeled after the piecewise exponential
+// y = (1/2)2^(10(2x - 1))         ; [0,0.5)
+// y = -(1/2)*2^(-10(2x - 1))) + 1 ; [0.5,1]
+static inline double INTUEaseInOutExponentialKernel(double p)
+{
+    if (p == 0.0 || p == 1.0) return p;
+
+    if (p < 0.5) {
+        return 0.5 * pow(2, (20 * p) - 10);
+    } else {
+        return -0.5 * pow(2, (-20 * p) + 10) + 1;
+    }
+}
+
+static inline float INTUEaseInOutExponentialKernelf(float p)
+{
+    if (p == 0.0f || p == 1.0f) return p;
+
+    if (p < 0.5f) {
+        return 0.5f * exp2f((20 * p) - 10);
+    } else {
+        return -0.5f * exp2f((-20 * p) + 10) + 1;
+    }
+}
+
+
+#pragma mark - Circular
+
+// Modeled after shifted quadrant IV of unit circle
+static inline double INTUEaseInCircularKernel(double p)
+{
+    return 1 - sqrt(1 - (p * p));
+}
+
+static inline float INTUEaseInCircularKernelf(float p)
+{
+    return 1 - sqrtf(1 - (p * p));
+}
+
+// Modeled after shifted quadrant II of unit circle
+static inline double INTUEaseOutCircularKernel(double p)
+{
+    return sqrt((2 - p) * p);
+}
+
+static inline float INTUEaseOutCircularKernelf(float p)
+{
+    return sqrtf((2 - p) * p);
+}
+
+// Modeled after the piecewise circular function
+// y = (1/2)(1 - sqrt(1 - 4x^2))           ; [0, 0.5)
+// y = (1/2)(sqrt(-(2x - 3)*(2x - 1)) + 1) ; [0.5, 1]
+static inline double INTUEaseInOutCircularKernel(double p)
+{
+    if (p < 0.5) {
+        return 0.5 * (1 - sqrt(1 - 4 * (p * p)));
+    } else {
+        return 0.5 * (sqrt(-((2 * p) - 3) * ((2 * p) - 1)) + 1);
+    }
+}
+
+static inline float INTUEaseInOutCircularKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 0.5f * (1 - sqrtf(1 - 4 * (p * p)));
+    } else {
+        return 0.5f * (sqrtf(-((2 * p) - 3) * ((2 * p) - 1)) + 1);
+    }
+}
+
+
+#pragma mark - Back
+
+// Modeled after the overshooting cubic y = x^3-x*sin(x*pi)
+static inline double INTUEaseInBackKernel(double p)
+{
+    return p * p * p - p * sin(p * M_PI);
+}
+
+static inline float INTUEaseInBackKernelf(float p)
+{
+    return p * p * p - p * sinf(p * (float)M_PI);
+}
+
+// Modeled after overshooting cubic y = 1-((1-x)^3-(1-x)*sin((1-x)*pi))
+static inline double INTUEaseOutBackKernel(double p)
+{
+    double f = (1 - p);
+    return 1 - (f * f * f - f * sin(f * M_PI));
+}
+
+static inline float INTUEaseOutBackKernelf(float p)
+{
+    float f = (1 - p);
+    return 1 - (f * f * f - f * sinf(f * (float)M_PI));
+}
+
+// Modeled after the piecewise overshooting cubic function:
+// y = (1/2)*((2x)^3-(2x)*sin(2*x*pi))           ; [0, 0.5)
+// y = (1/2)*(1-((1-x)^3-(1-x)*sin((1-x)*pi))+1) ; [0.5, 1]
+static inline double INTUEaseInOutBackKernel(double p)
+{
+    if (p < 0.5) {
+        double f = 2 * p;
+        return 0.5 * (f * f * f - f * sin(f * M_PI));
+    } else {
+        double f = (1 - (2*p - 1));
+        return 0.5 * (1 - (f * f * f - f * sin(f * M_PI))) + 0.5;
+    }
+}
+
+static inline float INTUEaseInOutBackKernelf(float p)
+{
+    if (p < 0.5f) {
+        float f = 2 * p;
+        return 0.5f * (f * f * f - f * sinf(f * (float)M_PI));
+    } else {
+        float f = (1 - (2*p - 1));
+        return 0.5f * (1 - (f * f * f - f * sinf(f * (float)M_PI))) + 0.5f;
+    }
+}
+
+
+#pragma mark - Elastic
+
+// Modeled after the damped sine wave y = sin(13pi/2*x)*pow(2, 10 * (x - 1))
+static inline double INTUEaseInElasticKernel(double p)
+{
+    return sin(13 * M_PI_2 * p) * pow(2, 10 * (p - 1));
+}
+
+static inline float INTUEaseInElasticKernelf(float p)
+{
+    return sinf(13 * (float)M_PI_2 * p) * exp2f(10 * (p - 1));
+}
+
+// Modeled after the damped sine wave y = sin(-13pi/2*(x + 1))*pow(2, -10x) + 1
+static inline double INTUEaseOutElasticKernel(double p)
+{
+    return sin(-13 * M_PI_2 * (p + 1)) * pow(2, -10 * p) + 1;
+}
+
+static inline float INTUEaseOutElasticKernelf(float p)
+{
+    return sinf(-13 * (float)M_PI_2 * (p + 1)) * exp2f(-10 * p) + 1;
+}
+
+// Modeled after the piecewise exponentially-damped sine wave:
+// y = (1/2)*sin(13pi/2*(2*x))*pow(2, 10 * ((2*x) - 1))      ; [0,0.5)
+// y = (1/2)*(sin(-13pi/2*((2x-1)+1))*pow(2,-10(2*x-1)) + 2) ; [0.5, 1]
+static inline double INTUEaseInOutElasticKernel(double p)
+{
+    if (p < 0.5) {
+        return 0.5 * sin(13 * M_PI_2 * (2 * p)) * pow(2, 10 * ((2 * p) - 1));
+    } else {
+        return 0.5 * (sin(-13 * M_PI_2 * ((2 * p - 1) + 1)) * pow(2, -10 * (2 * p - 1)) + 2);
+    }
+}
+
+static inline float INTUEaseInOutElasticKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 0.5f * sinf(13 * (float)M_PI_2 * (2 * p)) * exp2f(10 * ((2 * p) - 1));
+    } else {
+        return 0.5f * (sinf(-13 * (float)M_PI_2 * ((2 * p - 1) + 1)) * exp2f(-10 * (2 * p - 1)) + 2);
+    }
+}
+
+
+#pragma mark - Bounce
+
+static inline double INTUEaseOutBounceKernel(double p)
+{
+    if (p < 4/11.0) {
+        return (121 * p * p)/16.0;
+    } else if (p < 8/11.0) {
+        return (363/40.0 * p * p) - (99/10.0 * p) + 17/5.0;
+    } else if (p < 9/10.0) {
+        return (4356/361.0 * p * p) - (35442/1805.0 * p) + 16061/1805.0;
+    } else {
+        return (54/5.0 * p * p) - (513/25.0 * p) + 268/25.0;
+    }
+}
+
+// The same parabolas as the double precision kernel, written around their vertices: in single precision, the expanded form loses several
+// digits to cancellation between its large terms.
+static inline float INTUEaseOutBounceKernelf(float p)
+{
+    if (p < 4/11.0f) {
+        return (121 * p * p)/16.0f;
+    } else if (p < 8/11.0f) {
+        float f = p - 6/11.0f;
+        return (363/40.0f * f * f) + 7/10.0f;
+    } else if (p < 9/10.0f) {
+        float f = p - 179/220.0f;
+        return (4356/361.0f * f * f) + 91/100.0f;
+    } else {
+        float f = p - 19/20.0f;
+        return (54/5.0f * f * f) + 973/1000.0f;
+    }
+}
+
+static inline double INTUEaseInBounceKernel(double p)
+{
+    return 1 - INTUEaseOutBounceKernel(1 - p);
+}
+
+static inline float INTUEaseInBounceKernelf(float p)
+{
+    return 1 - INTUEaseOutBounceKernelf(1 - p);
+}
+
+static inline double INTUEaseInOutBounceKernel(double p)
+{
+    if (p < 0.5) {
+        return 0.5 * INTUEaseInBounceKernel(p*2);
+    } else {
+        return 0.5 * INTUEaseOutBounceKernel(p * 2 - 1) + 0.5;
+    }
+}
+
+static inline float INTUEaseInOutBounceKernelf(float p)
+{
+    if (p < 0.5f) {
+        return 0.5f * INTUEaseInBounceKernelf(p*2);
+    } else {
+        return 0.5f * INTUEaseOutBounceKernelf(p * 2 - 1) + 0.5f;
+    }
+}
+
+#endif /* INTUEasingKernels_h */
@@ -0,0 +1,410 @@
+//
+//  INTUEasingTable.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUEasingTable.h"
+#include <math.h>
+#include <stdlib.h>
+
+// The number of evenly spaced points in each segment at which the table is compared against the curve for the error report.
+static const size_t kINTUEasingTableErrorSamplesPerSegment = 64;
+
+// The number of extra points in the first and last segments, approaching each end of the table geometrically (at 1/2, 1/4, 1/8... of a
+// segment away), where curves such as the exponential ones jump or are steepest and evenly spaced points miss the largest error.
+static const int kINTUEasingTableErrorEndSampleCount = 52;
+
+// The step used to estimate the derivative of a curve defined by a function.
+static const double kINTUEasingTableDerivativeStep = 1e-6;
+
+struct INTUEasingTable {
+    size_t segmentCount;
+    /** The segment count as a float (so that evaluation needs no conversions of the count). */
+    float segmentCountf;
+    /**
+     The coefficients of the cubic in each segment, in terms of t (0.0 <= t < 1.0 across the segment), highest degree first. An extra
+     constant segment holding the value at p = 1.0 follows the last segment, so that every segment boundary (including both ends of the
+     table) evaluates to the stored value of the curve at that point with t = 0.0, instead of a sum of rounded coefficients.
+     */
+    float coefficients[][4];
+};
+typedef struct INTUEasingTable INTUEasingTable;
+
+/** A curve to bake, defined by its value and derivative at any progress. */
+typedef struct {
+    double (*value)(double p, const void *curve);
+    double (*derivative)(double p, const void *curve);
+} INTUEasingTableCurve;
+
+/** A curve defined by a function, with a derivative estimated by finite differences. */
+typedef struct {
+    INTUEasingTableCurve curve;
+    INTUEasingTableFunction function;
+    void *context;
+} INTUEasingTableFunctionCurve;
+
+/** A curve defined by a monotone cubic Hermite spline through a set of samples. */
+typedef struct {
+    INTUEasingTableCurve curve;
+    const double *progress;
+    const double *values;
+    /** The derivative of the spline at each sample. */
+    double *tangents;
+    size_t sampleCount;
+} INTUEasingTableSplineCurve;
+
+/** The context passed to kernelFunction(). */
+typedef struct {
+    INTUEasingKernel kernel;
+} INTUEasingTableKernelContext;
+
+static INTUEasingTableRef createTable(const INTUEasingTableCurve *curve, size_t segmentCount, INTUEasingTableError *error);
+
+static void limitTangents(const double *x, const double *y, double *m, size_t count);
+
+static double hermite(double y0, double y1, double m0, double m1, double h, double t);
+
+static double hermiteDerivative(double y0, double y1, double m0, double m1, double h, double t);
+
+static double functionValue(double p, const void *curve);
+
+static double functionDerivative(double p, const void *curve);
+
+static double kernelFunction(double p, void *context);
+
+static double measureError(INTUEasingTableRef table, const INTUEasingTableCurve *curve, double p, INTUEasingTableError *error);
+
+static size_t splineInterval(const INTUEasingTableSplineCurve *spline, double p, double *t);
+
+static double splineValue(double p, const void *curve);
+
+static double splineDerivative(double p, const void *curve);
+
+INTUEasingTableRef INTUEasingTableCreateWithFunction(INTUEasingTableFunction function, void *context, size_t segmentCount, INTUEasingTableError *error)
+{
+    if (function == NULL) {
+        return NULL;
+    }
+    INTUEasingTableFunctionCurve curve = { { functionValue, functionDerivative }, function, context };
+    return createTable(&curve.curve, segmentCount, error);
+}
+
+INTUEasingTableRef INTUEasingTableCreateWithKernel(INTUEasingKernel kernel, size_t segmentCount, INTUEasingTableError *error)
+{
+    if (kernel == NULL) {
+        return NULL;
+    }
+    INTUEasingTableKernelContext context = { kernel };
+    return INTUEasingTableCreateWithFunction(kernelFunction, &context, segmentCount, error);
+}
+
+INTUEasingTableRef INTUEasingTableCreateWithSamples(const double *progress,
+                                                    const double *values,
+                                                    size_t sampleCount,
+                                                    size_t segmentCount,
+                                                    INTUEasingTableError *error)
+{
+    if (progress == NULL || values == NULL || sampleCount < 2) {
+        return NULL;
+    }
+    for (size_t i = 0; i < sampleCount; i++) {
+        if (!isfinite(progress[i]) || !isfinite(values[i]) || (i > 0 && !(progress[i] > progress[i - 1]))) {
+            return NULL;
+        }
+    }
+    
+    double *tangents = malloc(sizeof(double) * sampleCount);
+    if (tangents == NULL) {
+        return NULL;
+    }
+    // Start from the average of the slopes on either side of each sample (or zero at a local extremum), then limit the tangents so that
+    // the spline is monotone between each pair of samples.
+    for (size_t i = 0; i < sampleCount; i++) {
+        double slopeBefore = (i > 0) ? (values[i] - values[i - 1]) / (progress[i] - progress[i - 1]) : NAN;
+        double slopeAfter = (i + 1 < sampleCount) ? (values[i + 1] - values[i]) / (progress[i + 1] - progress[i]) : NAN;
+        if (i == 0) {
+            tangents[i] = slopeAfter;
+        } else if (i + 1 == sampleCount) {
+            tangents[i] = slopeBefore;
+        } else if (slopeBefore * slopeAfter <= 0.0) {
+            tangents[i] = 0.0;
+        } else {
+            tangents[i] = 0.5 * (slopeBefore + slopeAfter);
+        }
+    }
+    limitTangents(progress, values, tangents, sampleCount);
+    
+    INTUEasingTableSplineCurve curve = { { splineValue, splineDerivative }, progress, values, tangents, sampleCount };
+    INTUEasingTableRef table = createTable(&curve.curve, segmentCount, error);
+    free(tangents);
+    return table;
+}
+
+void INTUEasingTableDestroy(INTUEasingTableRef table)
+{
+    free(table);
+}
+
+size_t INTUEasingTableGetSegmentCount(INTUEasingTableRef table)
+{
+    return table->segmentCount;
+}
+
+double INTUEasingTableEvaluate(INTUEasingTableRef table, double p)
+{
+    // fmax() and fmin() return the other argument when one is NaN, so NaN input evaluates the first segment instead of indexing out of bounds.
+    double x = fmin(fmax(p * table->segmentCountf, 0.0), table->segmentCountf);
+    double segment = floor(x);
+    double t = x - segment;
+    const float *c = table->coefficients[(size_t)segment];
+    return ((c[0] * t + c[1]) * t + c[2]) * t + c[3];
+}
+
+float INTUEasingTableEvaluatef(INTUEasingTableRef table, float p)
+{
+    float x = fminf(fmaxf(p * table->segmentCountf, 0.0f), table->segmentCountf);
+    float segment = floorf(x);
+    float t = x - segment;
+    const float *c = table->coefficients[(size_t)segment];
+    return ((c[0] * t + c[1]) * t + c[2]) * t + c[3];
+}
+
+void INTUEasingTableEvaluateBatch(INTUEasingTableRef table, const double *input, double *output, size_t count)
+{
+    const double segmentCount = table->segmentCountf;
+    const float (*coefficients)[4] = (const float (*)[4])table->coefficients;
+    for (size_t i = 0; i < count; i++) {
+        double x = fmin(fmax(input[i] * segmentCount, 0.0), segmentCount);
+        double segment = floor(x);
+        double t = x - segment;
+        const float *c = coefficients[(size_t)segment];
+        output[i] = ((c[0] * t + c[1]) * t + c[2]) * t + c[3];
+    }
+}
+
+void INTUEasingTableEvaluateBatchf(INTUEasingTableRef table, const float *input, float *output, size_t count)
+{
+    const float segmentCount = table->segmentCountf;
+    const float (*coefficients)[4] = (const float (*)[4])table->coefficients;
+    for (size_t i = 0; i < count; i++) {
+        float x = fminf(fmaxf(input[i] * segmentCount, 0.0f), segmentCount);
+        float segment = floorf(x);
+        float t = x - segment;
+        const float *c = coefficients[(size_t)segment];
+        output[i] = ((c[0] * t + c[1]) * t + c[2]) * t + c[3];
+    }
+}
+
+#pragma mark Internal Functions
+
+/**
+ Samples the curve at the boundaries of each segment, limits the tangents so that each segment is monotone wherever the curve is, converts
+ each segment to the coefficients of a cubic, and measures the error of the result against the curve.
+ */
+static INTUEasingTableRef createTable(const INTUEasingTableCurve *curve, size_t segmentCount, INTUEasingTableError *error)
+{
+    // Limit the segment count so that every segment index is exactly representable as a float.
+    if (segmentCount == 0 || segmentCount > (1 << 20)) {
+        return NULL;
+    }
+    INTUEasingTable *table = malloc(sizeof(INTUEasingTable) + sizeof(float[4]) * (segmentCount + 1));
+    double *knots = malloc(sizeof(double) * 3 * (segmentCount + 1));
+    if (table == NULL || knots == NULL) {
+        free(table);
+        free(knots);
+        return NULL;
+    }
+    double *x = knots;
+    double *y = knots + segmentCount + 1;
+    double *m = knots + 2 * (segmentCount + 1);
+    for (size_t i = 0; i <= segmentCount; i++) {
+        x[i] = (double)i / segmentCount;
+        y[i] = curve->value(x[i], curve);
+        m[i] = curve->derivative(x[i], curve);
+    }
+    limitTangents(x, y, m, segmentCount + 1);
+    
+    table->segmentCount = segmentCount;
+    table->segmentCountf = (float)segmentCount;
+    const double h = 1.0 / segmentCount;
+    for (size_t i = 0; i < segmentCount; i++) {
+        table->coefficients[i][0] = (float)(2.0 * (y[i] - y[i + 1]) + h * (m[i] + m[i + 1]));
+        table->coefficients[i][1] = (float)(3.0 * (y[i + 1] - y[i]) - h * (2.0 * m[i] + m[i + 1]));
+        table->coefficients[i][2] = (float)(h * m[i]);
+        table->coefficients[i][3] = (float)y[i];
+    }
+    table->coefficients[segmentCount][0] = 0.0f;
+    table->coefficients[segmentCount][1] = 0.0f;
+    table->coefficients[segmentCount][2] = 0.0f;
+    table->coefficients[segmentCount][3] = (float)y[segmentCount];
+    free(knots);
+    
+    if (error) {
+        const size_t sampleCount = segmentCount * kINTUEasingTableErrorSamplesPerSegment;
+        double sumOfSquares = 0.0;
+        error->maximumError = 0.0;
+        error->maximumErrorProgress = 0.0;
+        for (size_t i = 0; i <= sampleCount; i++) {
+            double difference = measureError(table, curve, (double)i / sampleCount, error);
+            sumOfSquares += difference * difference;
+        }
+        for (int i = 1; i <= kINTUEasingTableErrorEndSampleCount; i++) {
+            double distance = ldexp(h, -i);
+            measureError(table, curve, distance, error);
+            measureError(table, curve, 1.0 - distance, error);
+        }
+        error->rmsError = sqrt(sumOfSquares / (sampleCount + 1));
+    }
+    return table;
+}
+
+/**
+ Limits the tangents m at each of the count points (x, y) so that the cubic Hermite spline through them is monotone between every pair of
+ points (Fritsch-Carlson): a tangent that points against the slope between two points is set to zero, and the pair of tangents on each
+ interval is scaled down if it is steep enough to overshoot.
+ */
+static void limitTangents(const double *x, const double *y, double *m, size_t count)
+{
+    for (size_t i = 0; i + 1 < count; i++) {
+        double slope = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+        if (slope == 0.0) {
+            m[i] = 0.0;
+            m[i + 1] = 0.0;
+            continue;
+        }
+        double alpha = m[i] / slope;
+        double beta = m[i + 1] / slope;
+        if (alpha < 0.0) {
+            m[i] = 0.0;
+            alpha = 0.0;
+        }
+        if (beta < 0.0) {
+            m[i + 1] = 0.0;
+            beta = 0.0;
+        }
+        double magnitude = alpha * alpha + beta * beta;
+        if (magnitude > 9.0) {
+            double tau = 3.0 / sqrt(magnitude);
+            m[i] = tau * alpha * slope;
+            m[i + 1] = tau * beta * slope;
+        }
+    }
+}
+
+/** Evaluates the cubic Hermite curve between (0, y0) and (h, y1) with tangents m0 and m1, at the fraction t of the interval. */
+static double hermite(double y0, double y1, double m0, double m1, double h, double t)
+{
+    double t2 = t * t, t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * y0 + (t3 - 2.0 * t2 + t) * h * m0 + (-2.0 * t3 + 3.0 * t2) * y1 + (t3 - t2) * h * m1;
+}
+
+/** Evaluates the derivative (with respect to x) of the cubic Hermite curve, at the fraction t of the interval. */
+static double hermiteDerivative(double y0, double y1, double m0, double m1, double h, double t)
+{
+    double t2 = t * t;
+    return ((6.0 * t2 - 6.0 * t) * (y0 - y1)) / h + (3.0 * t2 - 4.0 * t + 1.0) * m0 + (3.0 * t2 - 2.0 * t) * m1;
+}
+
+static double functionValue(double p, const void *curve)
+{
+    const INTUEasingTableFunctionCurve *functionCurve = curve;
+    return functionCurve->function(p, functionCurve->context);
+}
+
+static double functionDerivative(double p, const void *curve)
+{
+    // The function is only defined over 0.0 <= p <= 1.0, so use one-sided second order differences at the ends.
+    const double h = kINTUEasingTableDerivativeStep;
+    if (p - h < 0.0) {
+        return (-3.0 * functionValue(p, curve) + 4.0 * functionValue(p + h, curve) - functionValue(p + 2.0 * h, curve)) / (2.0 * h);
+    }
+    if (p + h > 1.0) {
+        return (3.0 * functionValue(p, curve) - 4.0 * functionValue(p - h, curve) + functionValue(p - 2.0 * h, curve)) / (2.0 * h);
+    }
+    return (functionValue(p + h, curve) - functionValue(p - h, curve)) / (2.0 * h);
+}
+
+/** Returns the difference between the table and the curve at p, and updates the maximum error in the report if it is larger. */
+static double measureError(INTUEasingTableRef table, const INTUEasingTableCurve *curve, double p, INTUEasingTableError *error)
+{
+    double difference = fabs(INTUEasingTableEvaluate(table, p) - curve->value(p, curve));
+    if (difference > error->maximumError) {
+        error->maximumError = difference;
+        error->maximumErrorProgress = p;
+    }
+    return difference;
+}
+
+static double kernelFunction(double p, void *context)
+{
+    const INTUEasingTableKernelContext *kernelContext = context;
+    return kernelContext->kernel(p);
+}
+
+/** Finds the interval of the spline containing p (clamped to the samples), returning its index and the fraction t of the way across it. */
+static size_t splineInterval(const INTUEasingTableSplineCurve *spline, double p, double *t)
+{
+    const double *x = spline->progress;
+    size_t low = 0, high = spline->sampleCount - 1;
+    if (p <= x[low]) {
+        *t = 0.0;
+        return low;
+    }
+    if (p >= x[high]) {
+        *t = 1.0;
+        return high - 1;
+    }
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (x[middle] <= p) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    *t = (p - x[low]) / (x[low + 1] - x[low]);
+    return low;
+}
+
+static double splineValue(double p, const void *curve)
+{
+    const INTUEasingTableSplineCurve *spline = curve;
+    double t;
+    size_t i = splineInterval(spline, p, &t);
+    double h = spline->progress[i + 1] - spline->progress[i];
+    return hermite(spline->values[i], spline->values[i + 1], spline->tangents[i], spline->tangents[i + 1], h, t);
+}
+
+static double splineDerivative(double p, const void *curve)
+{
+    const INTUEasingTableSplineCurve *spline = curve;
+    if (p < spline->progress[0] || p > spline->progress[spline->sampleCount - 1]) {
+        // The curve holds the value of the nearest sample outside of the samples.
+        return 0.0;
+    }
+    double t;
+    size_t i = splineInterval(spline, p, &t);
+    double h = spline->progress[i + 1] - spline->progress[i];
+    return hermiteDerivative(spline->values[i], spline->values[i + 1], spline->tangents[i], spline->tangents[i + 1], h, t);
+}
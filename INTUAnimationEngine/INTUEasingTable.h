@@ -0,0 +1,131 @@
+//
+//  INTUEasingTable.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUEasingTable_h
+#define INTUEasingTable_h
+
+#include "INTUEasingKernels.h"
+#include <stddef.h>
+
+// An easing table bakes an arbitrary curve (an expensive formula, a composite of other curves, or a set of samples such as a motion
+// curve exported from an animation tool) into a fixed size lookup table, so that evaluating it costs the same small, constant amount no
+// matter how the curve was defined.
+//
+// The curve is fit with a monotone cubic Hermite spline (Fritsch-Carlson): wherever the curve is increasing or decreasing between two
+// table entries, the fitted curve is too, so the fit never introduces wiggles or overshoot that are not in the original curve. The table
+// divides the range 0.0 <= p <= 1.0 into segments of equal width and stores the four coefficients of each segment's cubic together, so
+// that evaluation is a multiply to find the segment, one load, and three multiply-adds, with no branches. Input outside the range is
+// clamped to it. At every segment boundary, including p = 0.0 and p = 1.0, the table returns the value of the curve exactly (rounded to
+// single precision), so a curve that starts at 0.0 and ends at 1.0 does too.
+
+/** A reference to a baked easing table. */
+typedef struct INTUEasingTable *INTUEasingTableRef;
+
+/**
+ A report of how closely an easing table matches the curve it was baked from. The table is compared against the curve at 64 evenly spaced
+ points in every segment, and at points approaching each end of the table geometrically, where curves such as the exponential ones jump.
+ The report is therefore an estimate: the true maximum error of a curve with a sharp corner (such as bounce) can fall between the points
+ and be slightly larger than reported.
+ */
+typedef struct {
+    /** The maximum absolute difference between the table and the curve, at the points compared. */
+    double maximumError;
+    /** The progress at which the maximum error occurs. */
+    double maximumErrorProgress;
+    /** The root mean square of the difference between the table and the curve, at the evenly spaced points. */
+    double rmsError;
+} INTUEasingTableError;
+
+/** A function that returns the value of a curve to bake at the given progress. The context is passed through unchanged. */
+typedef double (*INTUEasingTableFunction)(double p, void *context);
+
+/**
+ A default number of segments. With this many segments, the polynomial and sine easing functions are baked to within 1e-7, and the back
+ and elastic easing functions to within 4e-4. Curves with sharp corners (bounce) or infinite slopes (circular) have larger errors near those
+ points, which the error report measures.
+ */
+#define kINTUEasingTableDefaultSegmentCount     256
+
+/**
+ Bakes a curve defined by a function into a new easing table.
+ 
+ @param function        The function that defines the curve. It is only called for 0.0 <= p <= 1.0.
+ @param context         A value that is passed to the function.
+ @param segmentCount    The number of segments in the table (the table takes 16 bytes per segment, plus 16 bytes). Must be greater than
+                        zero.
+ @param error           On return, how closely the table matches the curve. May be NULL.
+ 
+ @return A reference to the new easing table, or NULL if the segment count is invalid or allocation failed. The table must be destroyed
+         with INTUEasingTableDestroy().
+ */
+INTUEasingTableRef  INTUEasingTableCreateWithFunction(INTUEasingTableFunction function, void *context, size_t segmentCount, INTUEasingTableError *error);
+
+/** Bakes an easing kernel (from INTUEasingKernels.h) into a new easing table. See INTUEasingTableCreateWithFunction(). */
+INTUEasingTableRef  INTUEasingTableCreateWithKernel(INTUEasingKernel kernel, size_t segmentCount, INTUEasingTableError *error);
+
+/**
+ Bakes a curve defined by a set of samples into a new easing table. The samples are joined by a monotone cubic Hermite spline, which is
+ then baked like any other curve: the table matches the spline at the segment boundaries and is within the reported error between them,
+ so it only passes through the samples that fall on a segment boundary. Before the first sample and after the last sample, the curve
+ holds the value of the nearest sample.
+ 
+ @param progress        An array of sampleCount progress values, in strictly increasing order.
+ @param values          An array of sampleCount values of the curve at each of the progress values.
+ @param sampleCount     The number of samples. Must be at least 2.
+ @param segmentCount    The number of segments in the table. Must be greater than zero.
+ @param error           On return, how closely the table matches the spline through the samples. May be NULL.
+ 
+ @return A reference to the new easing table, or NULL if the samples or segment count are invalid or allocation failed. The table must be
+         destroyed with INTUEasingTableDestroy().
+ */
+INTUEasingTableRef  INTUEasingTableCreateWithSamples(const double *progress,
+                                                     const double *values,
+                                                     size_t sampleCount,
+                                                     size_t segmentCount,
+                                                     INTUEasingTableError *error);
+
+/** Destroys (deallocates) the easing table. */
+void                INTUEasingTableDestroy(INTUEasingTableRef table);
+
+/** Returns the number of segments in the easing table. */
+size_t              INTUEasingTableGetSegmentCount(INTUEasingTableRef table);
+
+/** Evaluates the easing table at the given progress. */
+double              INTUEasingTableEvaluate(INTUEasingTableRef table, double p);
+
+/** Evaluates the easing table at the given progress, in single precision. */
+float               INTUEasingTableEvaluatef(INTUEasingTableRef table, float p);
+
+/**
+ Evaluates the easing table for each of the count values in input, writing the results to output. This is a plain scalar loop; it has no
+ branches, so the compiler may auto-vectorize the arithmetic (with the table loads done one lane at a time), but nothing here depends on it.
+ */
+void                INTUEasingTableEvaluateBatch(INTUEasingTableRef table, const double *input, double *output, size_t count);
+
+/** Evaluates the easing table for each of the count values in input, in single precision. See INTUEasingTableEvaluateBatch(). */
+void                INTUEasingTableEvaluateBatchf(INTUEasingTableRef table, const float *input, float *output, size_t count);
+
+#endif /* INTUEasingTable_h */
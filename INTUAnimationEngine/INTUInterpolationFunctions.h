@@ -27,6 +27,7 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 #import "INTUAnimationEngineDefines.h"
+#import "INTUTransformInterpolation.h"
 
 __INTU_ASSUME_NONNULL_BEGIN
 
@@ -68,6 +69,21 @@ UIColor * INTUInterpolateUIColor(UIColor *start, UIColor *end, CGFloat progress)
 /** Interpolates linearly between a start CGColorRef (progress = 0.0) and an end CGColorRef (progress = 1.0), based on the progress value. */
 CGColorRef INTUInterpolateCGColor(CGColorRef start, CGColorRef end, CGFloat progress);
 
+
+#pragma mark - Transform Interpolation Functions
+
+/** Interpolates between a start CGAffineTransform (progress = 0.0) and an end CGAffineTransform (progress = 1.0), based on the progress value.
+    The transforms are decomposed into translation, scale, rotation and skew, which are interpolated separately (rotating in the shortest
+    direction). To animate a transform, initialize an INTUAffineTransformInterpolator once instead, which avoids decomposing both transforms
+    every frame. */
+CGAffineTransform INTUInterpolateCGAffineTransform(CGAffineTransform start, CGAffineTransform end, CGFloat progress);
+
+/** Interpolates between a start CATransform3D (progress = 0.0) and an end CATransform3D (progress = 1.0), based on the progress value.
+    The transforms are decomposed into translation, scale, skew, perspective and rotation (as a quaternion), which are interpolated separately.
+    To animate a transform, initialize an INTUTransform3DInterpolator once instead, which avoids decomposing both transforms every frame. */
+CATransform3D INTUInterpolateCATransform3D(CATransform3D start, CATransform3D end, CGFloat progress);
+
+
 /** Interpolates between a start value (progress = 0.0) and an end value (progress = 1.0), based on the progress value.
     If both values are of the same type and linear interpolation is supported for that type, linear interpolation will
     be used. Otherwise, proximal interpolation will be used. */
@@ -133,6 +133,20 @@ CGColorRef INTUInterpolateCGColor(CGColorRef start, CGColorRef end, CGFloat prog
     return [INTUInterpolateUIColor([UIColor colorWithCGColor:start], [UIColor colorWithCGColor:end], progress) CGColor];
 }
 
+CGAffineTransform INTUInterpolateCGAffineTransform(CGAffineTransform start, CGAffineTransform end, CGFloat progress)
+{
+    INTUAffineTransformInterpolator interpolator;
+    INTUAffineTransformInterpolatorInit(&interpolator, start, end);
+    return INTUAffineTransformInterpolatorEvaluate(&interpolator, progress);
+}
+
+CATransform3D INTUInterpolateCATransform3D(CATransform3D start, CATransform3D end, CGFloat progress)
+{
+    INTUTransform3DInterpolator interpolator;
+    INTUTransform3DInterpolatorInit(&interpolator, start, end);
+    return INTUTransform3DInterpolatorEvaluate(&interpolator, progress);
+}
+
 id INTUInterpolate(id start, id end, CGFloat progress)
 {
     // NSNumber (CGFloat)
@@ -170,6 +184,16 @@ id INTUInterpolate(id start, id end, CGFloat progress)
         if (strcmp([start objCType], @encode(UIEdgeInsets)) == 0 && strcmp([end objCType], @encode(UIEdgeInsets)) == 0) {
             return [NSValue valueWithUIEdgeInsets:INTUInterpolateUIEdgeInsets([start UIEdgeInsetsValue], [end UIEdgeInsetsValue], progress)];
         }
+        
+        // CGAffineTransform
+        if (strcmp([start objCType], @encode(CGAffineTransform)) == 0 && strcmp([end objCType], @encode(CGAffineTransform)) == 0) {
+            return [NSValue valueWithCGAffineTransform:INTUInterpolateCGAffineTransform([start CGAffineTransformValue], [end CGAffineTransformValue], progress)];
+        }
+        
+        // CATransform3D
+        if (strcmp([start objCType], @encode(CATransform3D)) == 0 && strcmp([end objCType], @encode(CATransform3D)) == 0) {
+            return [NSValue valueWithCATransform3D:INTUInterpolateCATransform3D([start CATransform3DValue], [end CATransform3DValue], progress)];
+        }
     }
     
     // UIColor
@@ -0,0 +1,376 @@
+//
+//  INTUPath.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUPath.h"
+#include <math.h>
+#include <stdlib.h>
+
+/** The number of intervals of the bezier parameter that each segment is divided into in the length table. */
+static const int kINTUPathSamplesPerSegment = 32;
+
+/** How close the current point must be to the start of the subpath for closing it to need no segment. */
+static const CGFloat kINTUPathCloseTolerance = 1e-6;
+
+// Abscissae and weights for 5 point Gauss-Legendre quadrature over [-1, 1], used to measure the length of each interval.
+static const double kGaussAbscissae[5] = { 0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640 };
+static const double kGaussWeights[5] = { 0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891 };
+
+/** Every segment is stored as a cubic bezier; lines and quadratic curves are converted to exactly equivalent cubics. */
+typedef struct {
+    CGPoint p0, p1, p2, p3;
+} INTUPathSegment;
+
+struct INTUPath {
+    INTUPathSegment *segments;
+    int segmentCount;
+    int segmentCapacity;
+    
+    /** The point that the next segment starts at. */
+    CGPoint currentPoint;
+    /** The point that the current subpath started at. */
+    CGPoint subpathStart;
+    
+    /** The distance along the path at each sample, segmentCount * kINTUPathSamplesPerSegment + 1 values. NULL if not built. */
+    CGFloat *lengths;
+    /**
+     The speed (the derivative of the distance with respect to the bezier parameter) at the end of each interval nearest the start of the
+     path, and at the start of the next. Stored as pairs, 2 * segmentCount * kINTUPathSamplesPerSegment values. Allocated with lengths.
+     */
+    CGFloat *speeds;
+    /**
+     The first and last segments that have a nonzero length, whose tangents are used beyond the ends of the path (a zero length segment,
+     such as a redundant close, has no direction). Set when the length table is built.
+     */
+    int firstSegmentWithLength;
+    int lastSegmentWithLength;
+};
+/** A private struct that stores a path and its arc length table. */
+typedef struct INTUPath INTUPath;
+
+
+static bool addSegment(INTUPathRef path, CGPoint p1, CGPoint p2, CGPoint p3);
+
+static bool buildLengthTable(INTUPathRef path);
+
+static CGPoint segmentPosition(const INTUPathSegment *segment, double t);
+
+static CGPoint segmentDerivative(const INTUPathSegment *segment, double t);
+
+static CGFloat segmentAngle(const INTUPathSegment *segment, double t);
+
+static void evaluateDistance(INTUPathRef path, CGFloat distance, int *sampleHint, CGPoint *position, CGFloat *angle);
+
+
+#pragma mark Public API
+
+INTUPathRef INTUPathCreate(void)
+{
+    return calloc(1, sizeof(INTUPath));
+}
+
+void INTUPathDestroy(INTUPathRef path)
+{
+    if (path) {
+        free(path->segments);
+        free(path->lengths);
+        free(path);
+    }
+}
+
+void INTUPathMoveToPoint(INTUPathRef path, CGPoint point)
+{
+    path->currentPoint = point;
+    path->subpathStart = point;
+}
+
+bool INTUPathCloseSubpath(INTUPathRef path)
+{
+    if (fabs(path->currentPoint.x - path->subpathStart.x) <= kINTUPathCloseTolerance &&
+        fabs(path->currentPoint.y - path->subpathStart.y) <= kINTUPathCloseTolerance) {
+        // The subpath already ends where it started (as ellipses and rounded rects do), so a closing line would have no length.
+        path->currentPoint = path->subpathStart;
+        return true;
+    }
+    return INTUPathAddLineToPoint(path, path->subpathStart);
+}
+
+bool INTUPathAddLineToPoint(INTUPathRef path, CGPoint point)
+{
+    CGPoint p0 = path->currentPoint;
+    CGPoint p1 = { p0.x + (point.x - p0.x) / 3.0, p0.y + (point.y - p0.y) / 3.0 };
+    CGPoint p2 = { p0.x + 2.0 * (point.x - p0.x) / 3.0, p0.y + 2.0 * (point.y - p0.y) / 3.0 };
+    return addSegment(path, p1, p2, point);
+}
+
+bool INTUPathAddQuadCurveToPoint(INTUPathRef path, CGPoint controlPoint, CGPoint point)
+{
+    // Degree elevation: the cubic control points are 2/3 of the way from each end point to the quadratic control point.
+    CGPoint p0 = path->currentPoint;
+    CGPoint p1 = { p0.x + 2.0 * (controlPoint.x - p0.x) / 3.0, p0.y + 2.0 * (controlPoint.y - p0.y) / 3.0 };
+    CGPoint p2 = { point.x + 2.0 * (controlPoint.x - point.x) / 3.0, point.y + 2.0 * (controlPoint.y - point.y) / 3.0 };
+    return addSegment(path, p1, p2, point);
+}
+
+bool INTUPathAddCurveToPoint(INTUPathRef path, CGPoint controlPoint1, CGPoint controlPoint2, CGPoint point)
+{
+    return addSegment(path, controlPoint1, controlPoint2, point);
+}
+
+size_t INTUPathGetSegmentCount(INTUPathRef path)
+{
+    return (size_t)path->segmentCount;
+}
+
+void INTUPathGetSegment(INTUPathRef path, size_t index, CGPoint points[4])
+{
+    const INTUPathSegment *segment = &path->segments[index];
+    points[0] = segment->p0;
+    points[1] = segment->p1;
+    points[2] = segment->p2;
+    points[3] = segment->p3;
+}
+
+CGFloat INTUPathGetLength(INTUPathRef path)
+{
+    if (!buildLengthTable(path)) {
+        return 0.0;
+    }
+    return path->lengths[path->segmentCount * kINTUPathSamplesPerSegment];
+}
+
+void INTUPathEvaluate(INTUPathRef path, CGFloat progress, CGPoint *position, CGFloat *angle)
+{
+    INTUPathEvaluateBatch(path, &progress, position, angle, 1);
+}
+
+void INTUPathEvaluateBatch(INTUPathRef path, const CGFloat *progress, CGPoint *positions, CGFloat *angles, size_t count)
+{
+    if (!buildLengthTable(path)) {
+        // An empty path stays at the current point.
+        for (size_t i = 0; i < count; i++) {
+            if (positions) {
+                positions[i] = path->currentPoint;
+            }
+            if (angles) {
+                angles[i] = 0.0;
+            }
+        }
+        return;
+    }
+    
+    const CGFloat length = path->lengths[path->segmentCount * kINTUPathSamplesPerSegment];
+    int sampleHint = 0;
+    for (size_t i = 0; i < count; i++) {
+        CGPoint position;
+        CGFloat angle;
+        evaluateDistance(path, progress[i] * length, &sampleHint, &position, &angle);
+        if (positions) {
+            positions[i] = position;
+        }
+        if (angles) {
+            angles[i] = angle;
+        }
+    }
+}
+
+#pragma mark Internal Functions
+
+static bool addSegment(INTUPathRef path, CGPoint p1, CGPoint p2, CGPoint p3)
+{
+    if (path->segmentCount == path->segmentCapacity) {
+        int newCapacity = path->segmentCapacity ? path->segmentCapacity * 2 : 4;
+        INTUPathSegment *newSegments = realloc(path->segments, sizeof(INTUPathSegment) * newCapacity);
+        if (!newSegments) {
+            return false;
+        }
+        path->segments = newSegments;
+        path->segmentCapacity = newCapacity;
+    }
+    
+    INTUPathSegment segment = { path->currentPoint, p1, p2, p3 };
+    path->segments[path->segmentCount++] = segment;
+    path->currentPoint = p3;
+    
+    // Invalidate the length table.
+    free(path->lengths);
+    path->lengths = NULL;
+    path->speeds = NULL;
+    return true;
+}
+
+/** Builds the length table if needed. Returns whether the path has a length table (false if it is empty or allocation failed). */
+static bool buildLengthTable(INTUPathRef path)
+{
+    if (path->lengths) {
+        return true;
+    }
+    if (path->segmentCount == 0) {
+        return false;
+    }
+    
+    // The speeds are stored in the same allocation as the lengths.
+    const int sampleCount = path->segmentCount * kINTUPathSamplesPerSegment;
+    path->lengths = malloc(sizeof(CGFloat) * (3 * sampleCount + 1));
+    if (!path->lengths) {
+        return false;
+    }
+    path->speeds = path->lengths + sampleCount + 1;
+    
+    const double dt = 1.0 / kINTUPathSamplesPerSegment;
+    double distance = 0.0;
+    int sample = 0;
+    path->lengths[sample++] = 0.0;
+    path->firstSegmentWithLength = -1;
+    path->lastSegmentWithLength = 0;
+    for (int i = 0; i < path->segmentCount; i++) {
+        const double segmentStartDistance = distance;
+        const INTUPathSegment *segment = &path->segments[i];
+        for (int j = 0; j < kINTUPathSamplesPerSegment; j++) {
+            // Integrate the speed |B'(t)| over the interval [j * dt, (j + 1) * dt].
+            const double midpoint = (j + 0.5) * dt;
+            double intervalLength = 0.0;
+            for (int k = 0; k < 5; k++) {
+                CGPoint derivative = segmentDerivative(segment, midpoint + 0.5 * dt * kGaussAbscissae[k]);
+                intervalLength += kGaussWeights[k] * hypot(derivative.x, derivative.y);
+            }
+            distance += 0.5 * dt * intervalLength;
+            
+            CGPoint startDerivative = segmentDerivative(segment, j * dt);
+            CGPoint endDerivative = segmentDerivative(segment, (j + 1) * dt);
+            path->speeds[2 * (sample - 1)] = hypot(startDerivative.x, startDerivative.y);
+            path->speeds[2 * (sample - 1) + 1] = hypot(endDerivative.x, endDerivative.y);
+            path->lengths[sample++] = distance;
+        }
+        if (distance > segmentStartDistance) {
+            if (path->firstSegmentWithLength < 0) {
+                path->firstSegmentWithLength = i;
+            }
+            path->lastSegmentWithLength = i;
+        }
+    }
+    if (path->firstSegmentWithLength < 0) {
+        path->firstSegmentWithLength = 0;
+    }
+    return true;
+}
+
+static CGPoint segmentPosition(const INTUPathSegment *segment, double t)
+{
+    const double u = 1.0 - t;
+    const double b0 = u * u * u, b1 = 3.0 * u * u * t, b2 = 3.0 * u * t * t, b3 = t * t * t;
+    CGPoint point = {
+        b0 * segment->p0.x + b1 * segment->p1.x + b2 * segment->p2.x + b3 * segment->p3.x,
+        b0 * segment->p0.y + b1 * segment->p1.y + b2 * segment->p2.y + b3 * segment->p3.y
+    };
+    return point;
+}
+
+static CGPoint segmentDerivative(const INTUPathSegment *segment, double t)
+{
+    const double u = 1.0 - t;
+    const double d0 = 3.0 * u * u, d1 = 6.0 * u * t, d2 = 3.0 * t * t;
+    CGPoint derivative = {
+        d0 * (segment->p1.x - segment->p0.x) + d1 * (segment->p2.x - segment->p1.x) + d2 * (segment->p3.x - segment->p2.x),
+        d0 * (segment->p1.y - segment->p0.y) + d1 * (segment->p2.y - segment->p1.y) + d2 * (segment->p3.y - segment->p2.y)
+    };
+    return derivative;
+}
+
+static CGFloat segmentAngle(const INTUPathSegment *segment, double t)
+{
+    CGPoint derivative = segmentDerivative(segment, t);
+    if (fabs(derivative.x) < 1e-9 && fabs(derivative.y) < 1e-9) {
+        // The tangent is undefined where a control point coincides with an end point; use the direction of the whole segment instead.
+        return atan2(segment->p3.y - segment->p0.y, segment->p3.x - segment->p0.x);
+    }
+    return atan2(derivative.y, derivative.x);
+}
+
+/**
+ Evaluates the path at the given distance along it. The sample hint is the index of the table interval found by the previous call, which
+ is checked (along with the next interval) before falling back to a binary search, so that ascending distances are found in constant time.
+ */
+static void evaluateDistance(INTUPathRef path, CGFloat distance, int *sampleHint, CGPoint *position, CGFloat *angle)
+{
+    const int sampleCount = path->segmentCount * kINTUPathSamplesPerSegment;
+    const CGFloat *lengths = path->lengths;
+    const CGFloat length = lengths[sampleCount];
+    
+    if (distance <= 0.0 || distance >= length) {
+        // Beyond either end of the path, continue in a straight line along the tangent at that end.
+        const bool atStart = (distance <= 0.0);
+        const INTUPathSegment *segment = &path->segments[atStart ? path->firstSegmentWithLength : path->lastSegmentWithLength];
+        const CGFloat endAngle = segmentAngle(segment, atStart ? 0.0 : 1.0);
+        const CGFloat overshoot = atStart ? distance : distance - length;
+        const CGPoint end = atStart ? segment->p0 : segment->p3;
+        position->x = end.x + overshoot * cos(endAngle);
+        position->y = end.y + overshoot * sin(endAngle);
+        *angle = endAngle;
+        return;
+    }
+    
+    int sample = *sampleHint;
+    if (!(lengths[sample] <= distance && distance < lengths[sample + 1])) {
+        if (sample + 2 <= sampleCount && lengths[sample + 1] <= distance && distance < lengths[sample + 2]) {
+            sample++;
+        } else {
+            // Binary search for the interval that contains the distance.
+            int low = 0, high = sampleCount - 1;
+            while (low < high) {
+                int middle = (low + high + 1) / 2;
+                if (lengths[middle] <= distance) {
+                    low = middle;
+                } else {
+                    high = middle - 1;
+                }
+            }
+            sample = low;
+        }
+    }
+    *sampleHint = sample;
+    
+    // Within the interval, the distance as a function of the bezier parameter is modeled as a cubic Hermite curve through the distance and
+    // speed at each end. Starting from a linear estimate, two Newton steps invert it to find the parameter at the given distance. This
+    // keeps the speed of motion even where the speed of the bezier changes quickly, such as near a sharp corner.
+    const CGFloat intervalLength = lengths[sample + 1] - lengths[sample];
+    const double target = distance - lengths[sample];
+    double fraction = intervalLength > 0.0 ? target / intervalLength : 0.0;
+    const double m0 = path->speeds[2 * sample] / kINTUPathSamplesPerSegment, m1 = path->speeds[2 * sample + 1] / kINTUPathSamplesPerSegment;
+    for (int i = 0; i < 2 && intervalLength > 0.0; i++) {
+        const double u = fraction, u2 = u * u, u3 = u2 * u;
+        const double value = (-2.0 * u3 + 3.0 * u2) * intervalLength + (u3 - 2.0 * u2 + u) * m0 + (u3 - u2) * m1;
+        const double slope = (-6.0 * u2 + 6.0 * u) * intervalLength + (3.0 * u2 - 4.0 * u + 1.0) * m0 + (3.0 * u2 - 2.0 * u) * m1;
+        if (slope <= 0.0) {
+            break;
+        }
+        fraction = fmin(1.0, fmax(0.0, fraction - (value - target) / slope));
+    }
+    const int segmentIndex = sample / kINTUPathSamplesPerSegment;
+    const double t = ((sample % kINTUPathSamplesPerSegment) + fraction) / kINTUPathSamplesPerSegment;
+    const INTUPathSegment *segment = &path->segments[segmentIndex];
+    *position = segmentPosition(segment, t);
+    *angle = segmentAngle(segment, t);
+}
@@ -0,0 +1,112 @@
+//
+//  INTUPath.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUPath_h
+#define INTUPath_h
+
+#include <CoreGraphics/CGGeometry.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// A path made of line, quadratic and cubic bezier segments, that can be evaluated by distance along it instead of by bezier parameter.
+// The bezier parameter t does not advance at a constant speed along a curve (it moves faster where control points are far apart), so
+// animating t directly produces uneven motion. To fix this, the path measures its arc length once, building a table of the distance
+// along the path at evenly spaced parameter values. Evaluating the path at a progress value then maps the distance to a parameter value
+// with a table lookup, and evaluates the bezier at that parameter, so that equal steps of progress move equal distances along the path.
+//
+// The length table is built the first time the path is measured or evaluated. Adding a segment after that invalidates the table, and
+// it will be rebuilt the next time it is needed.
+
+/** A reference to a private struct that stores a path and its arc length table. */
+typedef struct INTUPath *INTUPathRef;
+
+/** Creates and returns a reference to a new empty path, or NULL if it could not be allocated. The current point (and current subpath) starts at the origin. */
+INTUPathRef     INTUPathCreate(void);
+
+/** Destroys (deallocates) the path at the given reference. */
+void            INTUPathDestroy(INTUPathRef path);
+
+/** Starts a new subpath at the given point, without adding a segment. The path jumps from the previous point to this one. */
+void            INTUPathMoveToPoint(INTUPathRef path, CGPoint point);
+
+/**
+ Adds a straight line from the current point back to the start of the current subpath. If the current point is already at the start of
+ the subpath (as at the end of an ellipse), no segment is added, since it would have no length. Returns false if the segment could not be
+ added.
+ */
+bool            INTUPathCloseSubpath(INTUPathRef path);
+
+/** Adds a straight line from the current point to the given point. Returns whether the segment was added. */
+bool            INTUPathAddLineToPoint(INTUPathRef path, CGPoint point);
+
+/** Adds a quadratic bezier curve from the current point to the given point. Returns whether the segment was added. */
+bool            INTUPathAddQuadCurveToPoint(INTUPathRef path, CGPoint controlPoint, CGPoint point);
+
+/** Adds a cubic bezier curve from the current point to the given point. Returns whether the segment was added. */
+bool            INTUPathAddCurveToPoint(INTUPathRef path, CGPoint controlPoint1, CGPoint controlPoint2, CGPoint point);
+
+/** Returns the number of segments in the path. */
+size_t          INTUPathGetSegmentCount(INTUPathRef path);
+
+/**
+ Returns the points of one segment of the path. Every segment is stored as a cubic bezier curve (lines and quadratic curves are
+ converted when they are added), so adding the same segments to a new path, starting each with INTUPathMoveToPoint() if it does not
+ continue from the end of the previous segment, recreates an identical path.
+ 
+ @param path        A reference to the path.
+ @param index       The index of the segment. Must be less than the number of segments.
+ @param points      On return, the start point, the two control points, and the end point of the segment.
+ */
+void            INTUPathGetSegment(INTUPathRef path, size_t index, CGPoint points[4]);
+
+/** Returns the total length of the path. */
+CGFloat         INTUPathGetLength(INTUPathRef path);
+
+/**
+ Evaluates the path at the given progress, moving at a constant speed along the path as progress increases.
+ 
+ @param path        A reference to the path.
+ @param progress    The fraction of the length of the path. Values below 0.0 or above 1.0 (for example, from an easing function that
+                    overshoots) continue in a straight line along the tangent at the start or end of the path.
+ @param position    On return, the position on the path. May be NULL.
+ @param angle       On return, the angle of the tangent to the path, in radians (suitable for rotating a view to face along the path).
+                    May be NULL.
+ */
+void            INTUPathEvaluate(INTUPathRef path, CGFloat progress, CGPoint *position, CGFloat *angle);
+
+/**
+ Evaluates the path at each of the count progress values, for example for many followers moving along one path. This is faster than
+ calling INTUPathEvaluate() for each value, especially when the progress values are in ascending order.
+ 
+ @param path        A reference to the path.
+ @param progress    An array of count progress values.
+ @param positions   An array of count points that the positions are written to. May be NULL.
+ @param angles      An array of count values that the angles are written to. May be NULL.
+ @param count       The number of values to evaluate.
+ */
+void            INTUPathEvaluateBatch(INTUPathRef path, const CGFloat *progress, CGPoint *positions, CGFloat *angles, size_t count);
+
+#endif /* INTUPath_h */
@@ -0,0 +1,423 @@
+//
+//  INTUTransformInterpolation.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "INTUTransformInterpolation.h"
+#include <math.h>
+
+/** The angle (in radians) between two quaternions below which nlerp is used instead of slerp. At this angle, nlerp deviates from the
+    exact rotation by less than 1e-6 radians for progress values in [0.0, 1.0], which is far below anything visible. */
+static const CGFloat kINTUTransformNlerpThreshold = 0.025;
+
+static inline CGFloat lerp(CGFloat start, CGFloat end, CGFloat progress)
+{
+    return start + (end - start) * progress;
+}
+
+#pragma mark - 2D Affine Transforms
+
+void INTUDecomposeAffineTransform(CGAffineTransform transform, INTUDecomposedAffineTransform *decomposed)
+{
+    CGFloat row0x = transform.a, row0y = transform.b;
+    CGFloat row1x = transform.c, row1y = transform.d;
+    
+    decomposed->translation[0] = transform.tx;
+    decomposed->translation[1] = transform.ty;
+    
+    CGFloat scaleX = sqrt(row0x * row0x + row0y * row0y);
+    CGFloat scaleY = sqrt(row1x * row1x + row1y * row1y);
+    // If the determinant is negative, one axis is flipped. Which one is arbitrary; flip the one that keeps the angle smaller.
+    if (row0x * row1y - row0y * row1x < 0.0) {
+        if (row0x < row1y) {
+            scaleX = -scaleX;
+        } else {
+            scaleY = -scaleY;
+        }
+    }
+    if (scaleX != 0.0) {
+        row0x /= scaleX;
+        row0y /= scaleX;
+    }
+    if (scaleY != 0.0) {
+        row1x /= scaleY;
+        row1y /= scaleY;
+    }
+    decomposed->scale[0] = scaleX;
+    decomposed->scale[1] = scaleY;
+    
+    // The first row is now (cos(angle), sin(angle)), so rotating both rows back by the angle leaves only the skew.
+    CGFloat angle = atan2(row0y, row0x);
+    CGFloat cosAngle = cos(angle), sinAngle = sin(angle);
+    decomposed->angle = angle;
+    decomposed->matrix[0] = row0x * cosAngle + row0y * sinAngle;
+    decomposed->matrix[1] = row0y * cosAngle - row0x * sinAngle;
+    decomposed->matrix[2] = row1x * cosAngle + row1y * sinAngle;
+    decomposed->matrix[3] = row1y * cosAngle - row1x * sinAngle;
+}
+
+CGAffineTransform INTURecomposeAffineTransform(const INTUDecomposedAffineTransform *decomposed)
+{
+    const CGFloat *m = decomposed->matrix;
+    CGFloat cosAngle = cos(decomposed->angle), sinAngle = sin(decomposed->angle);
+    CGFloat scaleX = decomposed->scale[0], scaleY = decomposed->scale[1];
+    CGAffineTransform transform;
+    transform.a = scaleX * (m[0] * cosAngle - m[1] * sinAngle);
+    transform.b = scaleX * (m[0] * sinAngle + m[1] * cosAngle);
+    transform.c = scaleY * (m[2] * cosAngle - m[3] * sinAngle);
+    transform.d = scaleY * (m[2] * sinAngle + m[3] * cosAngle);
+    transform.tx = decomposed->translation[0];
+    transform.ty = decomposed->translation[1];
+    return transform;
+}
+
+void INTUAffineTransformInterpolatorInit(INTUAffineTransformInterpolator *interpolator, CGAffineTransform start, CGAffineTransform end)
+{
+    INTUDecomposedAffineTransform *a = &interpolator->start;
+    INTUDecomposedAffineTransform *b = &interpolator->end;
+    INTUDecomposeAffineTransform(start, a);
+    INTUDecomposeAffineTransform(end, b);
+    
+    // If the two transforms flip different axes, flip both axes of the start transform instead (which is the same as rotating it by
+    // 180 degrees), so that the scale does not pass through zero.
+    if ((a->scale[0] < 0.0 && b->scale[1] < 0.0) || (a->scale[1] < 0.0 && b->scale[0] < 0.0)) {
+        a->scale[0] = -a->scale[0];
+        a->scale[1] = -a->scale[1];
+        a->angle += a->angle < 0.0 ? M_PI : -M_PI;
+    }
+    
+    // Rotate in the shortest direction.
+    if (fabs(a->angle - b->angle) > M_PI) {
+        if (a->angle > b->angle) {
+            a->angle -= 2.0 * M_PI;
+        } else {
+            b->angle -= 2.0 * M_PI;
+        }
+    }
+}
+
+static inline CGAffineTransform evaluateAffineTransform(const INTUAffineTransformInterpolator *interpolator, CGFloat progress)
+{
+    const INTUDecomposedAffineTransform *a = &interpolator->start;
+    const INTUDecomposedAffineTransform *b = &interpolator->end;
+    INTUDecomposedAffineTransform decomposed;
+    for (int i = 0; i < 2; i++) {
+        decomposed.translation[i] = lerp(a->translation[i], b->translation[i], progress);
+        decomposed.scale[i] = lerp(a->scale[i], b->scale[i], progress);
+    }
+    for (int i = 0; i < 4; i++) {
+        decomposed.matrix[i] = lerp(a->matrix[i], b->matrix[i], progress);
+    }
+    decomposed.angle = lerp(a->angle, b->angle, progress);
+    return INTURecomposeAffineTransform(&decomposed);
+}
+
+CGAffineTransform INTUAffineTransformInterpolatorEvaluate(const INTUAffineTransformInterpolator *interpolator, CGFloat progress)
+{
+    return evaluateAffineTransform(interpolator, progress);
+}
+
+void INTUAffineTransformInterpolatorEvaluateBatch(const INTUAffineTransformInterpolator *interpolators,
+                                                  const CGFloat *progress,
+                                                  CGAffineTransform *transforms,
+                                                  size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        transforms[i] = evaluateAffineTransform(&interpolators[i], progress[i]);
+    }
+}
+
+#pragma mark - 3D Transforms
+
+bool INTUDecomposeTransform3D(CATransform3D transform, INTUDecomposedTransform3D *decomposed)
+{
+    if (transform.m44 == 0.0) {
+        return false;
+    }
+    
+    // Normalize the matrix, and split it into the upper 3x3 matrix (rows), the translation and the perspective column.
+    const CGFloat n = 1.0 / transform.m44;
+    CGFloat row[3][3] = {
+        { transform.m11 * n, transform.m12 * n, transform.m13 * n },
+        { transform.m21 * n, transform.m22 * n, transform.m23 * n },
+        { transform.m31 * n, transform.m32 * n, transform.m33 * n },
+    };
+    const CGFloat *t = decomposed->translation;
+    decomposed->translation[0] = transform.m41 * n;
+    decomposed->translation[1] = transform.m42 * n;
+    decomposed->translation[2] = transform.m43 * n;
+    const CGFloat column[3] = { transform.m14 * n, transform.m24 * n, transform.m34 * n };
+    
+    // Cofactors of the upper 3x3 matrix, which give both its determinant and its inverse.
+    const CGFloat c00 = row[1][1] * row[2][2] - row[1][2] * row[2][1];
+    const CGFloat c01 = row[1][2] * row[2][0] - row[1][0] * row[2][2];
+    const CGFloat c02 = row[1][0] * row[2][1] - row[1][1] * row[2][0];
+    const CGFloat determinant = row[0][0] * c00 + row[0][1] * c01 + row[0][2] * c02;
+    if (determinant == 0.0 || !isfinite(determinant)) {
+        return false;
+    }
+    
+    // The perspective p satisfies [row, 0; t, 1] * p = [column; 1], so p.xyz = row^-1 * column, and p.w = 1 - t . p.xyz.
+    CGFloat *p = decomposed->perspective;
+    if (column[0] != 0.0 || column[1] != 0.0 || column[2] != 0.0) {
+        const CGFloat c10 = row[0][2] * row[2][1] - row[0][1] * row[2][2];
+        const CGFloat c11 = row[0][0] * row[2][2] - row[0][2] * row[2][0];
+        const CGFloat c12 = row[0][1] * row[2][0] - row[0][0] * row[2][1];
+        const CGFloat c20 = row[0][1] * row[1][2] - row[0][2] * row[1][1];
+        const CGFloat c21 = row[0][2] * row[1][0] - row[0][0] * row[1][2];
+        const CGFloat c22 = row[0][0] * row[1][1] - row[0][1] * row[1][0];
+        const CGFloat inverseDeterminant = 1.0 / determinant;
+        p[0] = (c00 * column[0] + c10 * column[1] + c20 * column[2]) * inverseDeterminant;
+        p[1] = (c01 * column[0] + c11 * column[1] + c21 * column[2]) * inverseDeterminant;
+        p[2] = (c02 * column[0] + c12 * column[1] + c22 * column[2]) * inverseDeterminant;
+        p[3] = 1.0 - (t[0] * p[0] + t[1] * p[1] + t[2] * p[2]);
+    } else {
+        p[0] = p[1] = p[2] = 0.0;
+        p[3] = 1.0;
+    }
+    
+    // Gram-Schmidt orthonormalization of the rows gives the scale and skew, and leaves the rows as a pure rotation.
+    CGFloat *scale = decomposed->scale;
+    CGFloat *skew = decomposed->skew;
+    scale[0] = sqrt(row[0][0] * row[0][0] + row[0][1] * row[0][1] + row[0][2] * row[0][2]);
+    for (int i = 0; i < 3; i++) {
+        row[0][i] /= scale[0];
+    }
+    
+    skew[0] = row[0][0] * row[1][0] + row[0][1] * row[1][1] + row[0][2] * row[1][2];
+    for (int i = 0; i < 3; i++) {
+        row[1][i] -= skew[0] * row[0][i];
+    }
+    scale[1] = sqrt(row[1][0] * row[1][0] + row[1][1] * row[1][1] + row[1][2] * row[1][2]);
+    for (int i = 0; i < 3; i++) {
+        row[1][i] /= scale[1];
+    }
+    skew[0] /= scale[1];
+    
+    skew[1] = row[0][0] * row[2][0] + row[0][1] * row[2][1] + row[0][2] * row[2][2];
+    for (int i = 0; i < 3; i++) {
+        row[2][i] -= skew[1] * row[0][i];
+    }
+    skew[2] = row[1][0] * row[2][0] + row[1][1] * row[2][1] + row[1][2] * row[2][2];
+    for (int i = 0; i < 3; i++) {
+        row[2][i] -= skew[2] * row[1][i];
+    }
+    scale[2] = sqrt(row[2][0] * row[2][0] + row[2][1] * row[2][1] + row[2][2] * row[2][2]);
+    for (int i = 0; i < 3; i++) {
+        row[2][i] /= scale[2];
+    }
+    skew[1] /= scale[2];
+    skew[2] /= scale[2];
+    
+    // If the rows now form a left-handed basis, the transform flips, so negate the scale (and rows) to leave a proper rotation.
+    if (determinant < 0.0) {
+        for (int i = 0; i < 3; i++) {
+            scale[i] = -scale[i];
+            for (int j = 0; j < 3; j++) {
+                row[i][j] = -row[i][j];
+            }
+        }
+    }
+    
+    // Convert the rotation to a quaternion, choosing the formulation based on the largest diagonal term so that it is always well
+    // conditioned (including for rotations of 180 degrees). The rotation matrix is in row vector form, so r[i][j] is element (j, i)
+    // of the usual column vector form.
+    CGFloat *q = decomposed->quaternion;
+    const CGFloat trace = row[0][0] + row[1][1] + row[2][2];
+    if (trace > 0.0) {
+        const CGFloat s = 0.5 / sqrt(trace + 1.0);
+        q[0] = (row[1][2] - row[2][1]) * s;
+        q[1] = (row[2][0] - row[0][2]) * s;
+        q[2] = (row[0][1] - row[1][0]) * s;
+        q[3] = 0.25 / s;
+    } else if (row[0][0] > row[1][1] && row[0][0] > row[2][2]) {
+        const CGFloat s = 2.0 * sqrt(1.0 + row[0][0] - row[1][1] - row[2][2]);
+        q[0] = 0.25 * s;
+        q[1] = (row[1][0] + row[0][1]) / s;
+        q[2] = (row[2][0] + row[0][2]) / s;
+        q[3] = (row[1][2] - row[2][1]) / s;
+    } else if (row[1][1] > row[2][2]) {
+        const CGFloat s = 2.0 * sqrt(1.0 + row[1][1] - row[0][0] - row[2][2]);
+        q[0] = (row[1][0] + row[0][1]) / s;
+        q[1] = 0.25 * s;
+        q[2] = (row[2][1] + row[1][2]) / s;
+        q[3] = (row[2][0] - row[0][2]) / s;
+    } else {
+        const CGFloat s = 2.0 * sqrt(1.0 + row[2][2] - row[0][0] - row[1][1]);
+        q[0] = (row[2][0] + row[0][2]) / s;
+        q[1] = (row[2][1] + row[1][2]) / s;
+        q[2] = 0.25 * s;
+        q[3] = (row[0][1] - row[1][0]) / s;
+    }
+    const CGFloat length = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] /= length;
+    }
+    return true;
+}
+
+CATransform3D INTURecomposeTransform3D(const INTUDecomposedTransform3D *decomposed)
+{
+    const CGFloat x = decomposed->quaternion[0], y = decomposed->quaternion[1];
+    const CGFloat z = decomposed->quaternion[2], w = decomposed->quaternion[3];
+    const CGFloat *scale = decomposed->scale;
+    const CGFloat *skew = decomposed->skew;
+    const CGFloat *t = decomposed->translation;
+    const CGFloat *p = decomposed->perspective;
+    
+    // The rows of the rotation matrix (in row vector form).
+    const CGFloat u0[3] = { 1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + z * w), 2.0 * (x * z - y * w) };
+    const CGFloat u1[3] = { 2.0 * (x * y - z * w), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + x * w) };
+    const CGFloat u2[3] = { 2.0 * (x * z + y * w), 2.0 * (y * z - x * w), 1.0 - 2.0 * (x * x + y * y) };
+    
+    // Reapply the skew and scale to each row (the inverse of the Gram-Schmidt orthonormalization).
+    CGFloat row[3][3];
+    for (int i = 0; i < 3; i++) {
+        row[0][i] = scale[0] * u0[i];
+        row[1][i] = scale[1] * (u1[i] + skew[0] * u0[i]);
+        row[2][i] = scale[2] * (u2[i] + skew[1] * u0[i] + skew[2] * u1[i]);
+    }
+    
+    CATransform3D transform;
+    transform.m11 = row[0][0];
+    transform.m12 = row[0][1];
+    transform.m13 = row[0][2];
+    transform.m14 = row[0][0] * p[0] + row[0][1] * p[1] + row[0][2] * p[2];
+    transform.m21 = row[1][0];
+    transform.m22 = row[1][1];
+    transform.m23 = row[1][2];
+    transform.m24 = row[1][0] * p[0] + row[1][1] * p[1] + row[1][2] * p[2];
+    transform.m31 = row[2][0];
+    transform.m32 = row[2][1];
+    transform.m33 = row[2][2];
+    transform.m34 = row[2][0] * p[0] + row[2][1] * p[1] + row[2][2] * p[2];
+    transform.m41 = t[0];
+    transform.m42 = t[1];
+    transform.m43 = t[2];
+    transform.m44 = t[0] * p[0] + t[1] * p[1] + t[2] * p[2] + p[3];
+    return transform;
+}
+
+bool INTUTransform3DInterpolatorInit(INTUTransform3DInterpolator *interpolator, CATransform3D start, CATransform3D end)
+{
+    interpolator->startTransform = start;
+    interpolator->endTransform = end;
+    interpolator->angle = 0.0;
+    interpolator->inverseSinAngle = 0.0;
+    interpolator->decomposed = INTUDecomposeTransform3D(start, &interpolator->start) && INTUDecomposeTransform3D(end, &interpolator->end);
+    if (!interpolator->decomposed) {
+        return false;
+    }
+    
+    // q and -q are the same rotation, so flip the end quaternion if needed to take the shorter arc.
+    CGFloat *a = interpolator->start.quaternion;
+    CGFloat *b = interpolator->end.quaternion;
+    CGFloat dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    if (dot < 0.0) {
+        for (int i = 0; i < 4; i++) {
+            b[i] = -b[i];
+        }
+        dot = -dot;
+    }
+    const CGFloat angle = acos(fmin(dot, 1.0));
+    if (angle >= kINTUTransformNlerpThreshold) {
+        interpolator->angle = angle;
+        interpolator->inverseSinAngle = 1.0 / sin(angle);
+    }
+    return true;
+}
+
+static inline CATransform3D evaluateTransform3D(const INTUTransform3DInterpolator *interpolator, CGFloat progress)
+{
+    if (!interpolator->decomposed) {
+        const CATransform3D *a = &interpolator->startTransform;
+        const CATransform3D *b = &interpolator->endTransform;
+        CATransform3D transform;
+        transform.m11 = lerp(a->m11, b->m11, progress);
+        transform.m12 = lerp(a->m12, b->m12, progress);
+        transform.m13 = lerp(a->m13, b->m13, progress);
+        transform.m14 = lerp(a->m14, b->m14, progress);
+        transform.m21 = lerp(a->m21, b->m21, progress);
+        transform.m22 = lerp(a->m22, b->m22, progress);
+        transform.m23 = lerp(a->m23, b->m23, progress);
+        transform.m24 = lerp(a->m24, b->m24, progress);
+        transform.m31 = lerp(a->m31, b->m31, progress);
+        transform.m32 = lerp(a->m32, b->m32, progress);
+        transform.m33 = lerp(a->m33, b->m33, progress);
+        transform.m34 = lerp(a->m34, b->m34, progress);
+        transform.m41 = lerp(a->m41, b->m41, progress);
+        transform.m42 = lerp(a->m42, b->m42, progress);
+        transform.m43 = lerp(a->m43, b->m43, progress);
+        transform.m44 = lerp(a->m44, b->m44, progress);
+        return transform;
+    }
+    
+    const INTUDecomposedTransform3D *a = &interpolator->start;
+    const INTUDecomposedTransform3D *b = &interpolator->end;
+    INTUDecomposedTransform3D decomposed;
+    for (int i = 0; i < 3; i++) {
+        decomposed.translation[i] = lerp(a->translation[i], b->translation[i], progress);
+        decomposed.scale[i] = lerp(a->scale[i], b->scale[i], progress);
+        decomposed.skew[i] = lerp(a->skew[i], b->skew[i], progress);
+    }
+    for (int i = 0; i < 4; i++) {
+        decomposed.perspective[i] = lerp(a->perspective[i], b->perspective[i], progress);
+    }
+    
+    if (interpolator->angle > 0.0) {
+        // slerp: the weights keep the result on the unit sphere, moving at a constant angular velocity.
+        const CGFloat weightA = sin((1.0 - progress) * interpolator->angle) * interpolator->inverseSinAngle;
+        const CGFloat weightB = sin(progress * interpolator->angle) * interpolator->inverseSinAngle;
+        for (int i = 0; i < 4; i++) {
+            decomposed.quaternion[i] = weightA * a->quaternion[i] + weightB * b->quaternion[i];
+        }
+    } else {
+        // nlerp: interpolate linearly, then project back onto the unit sphere.
+        CGFloat lengthSquared = 0.0;
+        for (int i = 0; i < 4; i++) {
+            decomposed.quaternion[i] = lerp(a->quaternion[i], b->quaternion[i], progress);
+            lengthSquared += decomposed.quaternion[i] * decomposed.quaternion[i];
+        }
+        const CGFloat inverseLength = 1.0 / sqrt(lengthSquared);
+        for (int i = 0; i < 4; i++) {
+            decomposed.quaternion[i] *= inverseLength;
+        }
+    }
+    return INTURecomposeTransform3D(&decomposed);
+}
+
+CATransform3D INTUTransform3DInterpolatorEvaluate(const INTUTransform3DInterpolator *interpolator, CGFloat progress)
+{
+    return evaluateTransform3D(interpolator, progress);
+}
+
+void INTUTransform3DInterpolatorEvaluateBatch(const INTUTransform3DInterpolator *interpolators,
+                                              const CGFloat *progress,
+                                              CATransform3D *transforms,
+                                              size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        transforms[i] = evaluateTransform3D(&interpolators[i], progress[i]);
+    }
+}
@@ -0,0 +1,147 @@
+//
+//  INTUTransformInterpolation.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUTransformInterpolation_h
+#define INTUTransformInterpolation_h
+
+#include <CoreGraphics/CGAffineTransform.h>
+#include <QuartzCore/CATransform3D.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Interpolating the elements of two transform matrices directly does not produce a natural animation: a rotation from 0 to 180 degrees
+// passes through a zero matrix (the layer shrinks to nothing and grows back), and any combination of rotation and scale shears midway.
+// Instead, each end transform is decomposed into translation, scale, skew and rotation components, which are interpolated individually
+// and then recomposed into a matrix. 2D affine transforms interpolate the rotation as an angle (in the shortest direction), and 3D
+// transforms interpolate it as a unit quaternion using spherical linear interpolation (slerp).
+//
+// Decomposition is relatively expensive (it involves square roots, a 3x3 inverse and a matrix-to-quaternion conversion), so it is done
+// only once, when an interpolator is initialized with the start and end transforms. Evaluating an interpolator at a given progress then
+// only needs a linear interpolation of each component, the slerp (two sines, whose angle is also precomputed) and the recomposition,
+// which is a few dozen multiply-adds written out directly rather than as a chain of 4x4 matrix multiplications. When the two rotations
+// are close together, slerp is replaced by a normalized linear interpolation (nlerp), which skips the sines and is indistinguishable at
+// small angles. Interpolators for many transforms can be stored in a contiguous array and evaluated in a single batch call. The batch
+// calls are plain scalar loops over the interpolators: they save a function call per transform and walk memory in order, but they are
+// not vectorized, since a 2D evaluation calls sin() and cos() to recompose the rotation, and a 3D evaluation branches between the
+// element-wise fallback, slerp (which calls sin() twice) and nlerp.
+//
+// The decomposition follows the CSS Transforms specification ("unmatrix"), so transforms animate the same way as CSS transitions.
+
+#pragma mark - 2D Affine Transforms
+
+/** The components of a decomposed CGAffineTransform. */
+typedef struct {
+    /** The translation along the x and y axes. */
+    CGFloat translation[2];
+    /** The scale along the x and y axes (one of which is negative if the transform flips). */
+    CGFloat scale[2];
+    /** The rotation angle, in radians. */
+    CGFloat angle;
+    /** The remaining 2x2 matrix (a, b, c, d) once the translation, scale and rotation have been removed, which holds any skew. */
+    CGFloat matrix[4];
+} INTUDecomposedAffineTransform;
+
+/** An interpolator between two CGAffineTransforms. Must be initialized with INTUAffineTransformInterpolatorInit() before use. */
+typedef struct {
+    INTUDecomposedAffineTransform start;
+    INTUDecomposedAffineTransform end;
+} INTUAffineTransformInterpolator;
+
+/** Decomposes an affine transform into its components. */
+void    INTUDecomposeAffineTransform(CGAffineTransform transform, INTUDecomposedAffineTransform *decomposed);
+
+/** Recomposes an affine transform from its components. */
+CGAffineTransform INTURecomposeAffineTransform(const INTUDecomposedAffineTransform *decomposed);
+
+/** Initializes an interpolator between a start transform (progress = 0.0) and an end transform (progress = 1.0). */
+void    INTUAffineTransformInterpolatorInit(INTUAffineTransformInterpolator *interpolator, CGAffineTransform start, CGAffineTransform end);
+
+/** Returns the transform at the given progress. Progress values outside [0.0, 1.0] extrapolate each component. */
+CGAffineTransform INTUAffineTransformInterpolatorEvaluate(const INTUAffineTransformInterpolator *interpolator, CGFloat progress);
+
+/** Evaluates count interpolators in one scalar loop, writing transforms[i] for interpolators[i] at progress[i]. */
+void    INTUAffineTransformInterpolatorEvaluateBatch(const INTUAffineTransformInterpolator *interpolators,
+                                                     const CGFloat *progress,
+                                                     CGAffineTransform *transforms,
+                                                     size_t count);
+
+#pragma mark - 3D Transforms
+
+/** The components of a decomposed CATransform3D. */
+typedef struct {
+    /** The translation along the x, y and z axes. */
+    CGFloat translation[3];
+    /** The scale along the x, y and z axes (all of which are negative if the transform flips). */
+    CGFloat scale[3];
+    /** The skew factors in the xy, xz and yz planes. */
+    CGFloat skew[3];
+    /** The perspective of the transform, which is (0, 0, 0, 1) for an affine transform. */
+    CGFloat perspective[4];
+    /** The rotation, as a unit quaternion (x, y, z, w). */
+    CGFloat quaternion[4];
+} INTUDecomposedTransform3D;
+
+/** An interpolator between two CATransform3Ds. Must be initialized with INTUTransform3DInterpolatorInit() before use. */
+typedef struct {
+    INTUDecomposedTransform3D start;
+    INTUDecomposedTransform3D end;
+    /** The angle between the start and end quaternions, or 0.0 if they are close enough to use nlerp. */
+    CGFloat angle;
+    /** 1 / sin(angle), precomputed for slerp. */
+    CGFloat inverseSinAngle;
+    /** Whether both transforms could be decomposed. If not, the matrix elements are interpolated directly. */
+    bool decomposed;
+    CATransform3D startTransform;
+    CATransform3D endTransform;
+} INTUTransform3DInterpolator;
+
+/**
+ Decomposes a 3D transform into its components.
+ 
+ @return Whether the transform could be decomposed, which is not possible if it is singular (for example, if it has a scale of zero).
+ */
+bool    INTUDecomposeTransform3D(CATransform3D transform, INTUDecomposedTransform3D *decomposed);
+
+/** Recomposes a 3D transform from its components. */
+CATransform3D INTURecomposeTransform3D(const INTUDecomposedTransform3D *decomposed);
+
+/**
+ Initializes an interpolator between a start transform (progress = 0.0) and an end transform (progress = 1.0).
+ 
+ @return Whether both transforms could be decomposed. If not, the interpolator falls back to interpolating each matrix element.
+ */
+bool    INTUTransform3DInterpolatorInit(INTUTransform3DInterpolator *interpolator, CATransform3D start, CATransform3D end);
+
+/** Returns the transform at the given progress. Progress values outside [0.0, 1.0] extrapolate each component (and the rotation). */
+CATransform3D INTUTransform3DInterpolatorEvaluate(const INTUTransform3DInterpolator *interpolator, CGFloat progress);
+
+/** Evaluates count interpolators in one scalar loop, writing transforms[i] for interpolators[i] at progress[i]. */
+void    INTUTransform3DInterpolatorEvaluateBatch(const INTUTransform3DInterpolator *interpolators,
+                                                 const CGFloat *progress,
+                                                 CATransform3D *transforms,
+                                                 size_t count);
+
+#endif /* INTUTransformInterpolation_h */
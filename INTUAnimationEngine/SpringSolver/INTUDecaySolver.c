@@ -0,0 +1,99 @@
+//
+//  INTUDecaySolver.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2014 Facebook, Inc. All rights reserved.
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice, this
+//     list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//   * Neither the name Facebook nor the names of its contributors may be used to
+//     endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+//  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+//  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+//  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "INTUDecaySolver.h"
+#include <math.h>
+
+const double kINTUDecelerationRateNormal = 0.998;
+const double kINTUDecelerationRateFast = 0.99;
+
+// The deceleration rate is per millisecond; the velocity decays as decelerationRate^(1000 * t) = exp(1000 * log(decelerationRate) * t).
+// Integrating the velocity gives the position: x(t) = x0 + v0 * (exp(c * t) - 1) / c, where c is the decay constant. As t approaches
+// infinity, exp(c * t) approaches zero, so the resting position is x0 - v0 / c.
+
+INTUDecay INTUDecayMake(double initialPosition, double initialVelocity, double decelerationRate)
+{
+    INTUDecay decay;
+    decay.initialPosition = initialPosition;
+    if (decelerationRate > 0.0 && decelerationRate < 1.0) {
+        decay.initialVelocity = initialVelocity;
+        decay.decayConstant = 1000.0 * log(decelerationRate);
+    } else {
+        decay.initialVelocity = 0.0;
+        decay.decayConstant = 1000.0 * log(kINTUDecelerationRateNormal);
+    }
+    return decay;
+}
+
+double INTUDecayPositionAtTime(INTUDecay decay, double time)
+{
+    // expm1 keeps full precision for small values of decayConstant * time (at the start of the decay).
+    return decay.initialPosition + decay.initialVelocity * expm1(decay.decayConstant * time) / decay.decayConstant;
+}
+
+double INTUDecayVelocityAtTime(INTUDecay decay, double time)
+{
+    return decay.initialVelocity * exp(decay.decayConstant * time);
+}
+
+double INTUDecayRestingPosition(INTUDecay decay)
+{
+    return decay.initialPosition - decay.initialVelocity / decay.decayConstant;
+}
+
+double INTUDecayDuration(INTUDecay decay, double threshold)
+{
+    // The remaining distance at time t is |v0 / c| * exp(c * t); solve for the time at which this equals the threshold.
+    double distance = fabs(decay.initialVelocity / decay.decayConstant);
+    if (threshold <= 0.0 || distance <= threshold) {
+        return 0.0;
+    }
+    return log(threshold / distance) / decay.decayConstant;
+}
+
+double INTUDecayTimeToReachPosition(INTUDecay decay, double position)
+{
+    // Solve x0 + v0 * (exp(c * t) - 1) / c = position for t.
+    if (position == decay.initialPosition) {
+        return 0.0;
+    }
+    if (decay.initialVelocity == 0.0) {
+        return INFINITY;
+    }
+    double fraction = 1.0 + decay.decayConstant * (position - decay.initialPosition) / decay.initialVelocity;
+    if (fraction <= 0.0 || fraction > 1.0) {
+        // The position is at or beyond the resting position, or behind the direction of motion.
+        return INFINITY;
+    }
+    return log(fraction) / decay.decayConstant;
+}
@@ -0,0 +1,120 @@
+//
+//  INTUDecaySolver.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2014 Facebook, Inc. All rights reserved.
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice, this
+//     list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//   * Neither the name Facebook nor the names of its contributors may be used to
+//     endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+//  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+//  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+//  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef INTUDecaySolver_h
+#define INTUDecaySolver_h
+
+#include <stdbool.h>
+
+// The decay solver models inertial motion that slows down over time, such as a scroll view coasting after a fling. The velocity decays
+// exponentially: every millisecond it is multiplied by the deceleration rate, the same model used by UIScrollView. Since the motion has a
+// closed form solution, the position and velocity at any time are evaluated directly in O(1), with no integration, and the resting
+// position and duration of the motion are known up front.
+//
+// A decay is a small value type that does not need to be created or destroyed. Each dimension of a multi-dimensional decay (for example,
+// the x and y axes of a fling) is independent, so use one decay per dimension.
+
+/** The deceleration rate of UIScrollViewDecelerationRateNormal. */
+extern const double kINTUDecelerationRateNormal;
+/** The deceleration rate of UIScrollViewDecelerationRateFast. */
+extern const double kINTUDecelerationRateFast;
+
+struct INTUDecay {
+    /** The position at time zero. */
+    double initialPosition;
+    /** The velocity at time zero, in units per second. */
+    double initialVelocity;
+    /** The (negative) exponent of the decay, in units of 1/second: the velocity at time t is initialVelocity * exp(decayConstant * t). */
+    double decayConstant;
+};
+/** A structure that holds the parameters of a decay. */
+typedef struct INTUDecay INTUDecay;
+
+/**
+ Returns a new decay starting at the given position and velocity.
+ 
+ @param initialPosition     The position at time zero.
+ @param initialVelocity     The velocity at time zero, in units per second.
+ @param decelerationRate    The factor the velocity is multiplied by every millisecond. Must be greater than zero and less than one. Typical
+                            values are kINTUDecelerationRateNormal and kINTUDecelerationRateFast. If invalid, the returned decay does not move.
+ 
+ @return A decay with the given parameters.
+ */
+INTUDecay   INTUDecayMake(double initialPosition, double initialVelocity, double decelerationRate);
+
+/**
+ Returns the position of the decay at the given time.
+ 
+ @param decay   The decay.
+ @param time    The time (in seconds) since the start of the decay. Must be greater than or equal to zero.
+ */
+double      INTUDecayPositionAtTime(INTUDecay decay, double time);
+
+/**
+ Returns the velocity of the decay at the given time, in units per second.
+ 
+ @param decay   The decay.
+ @param time    The time (in seconds) since the start of the decay. Must be greater than or equal to zero.
+ */
+double      INTUDecayVelocityAtTime(INTUDecay decay, double time);
+
+/**
+ Returns the position the decay comes to rest at (as time approaches infinity).
+ 
+ @param decay   The decay.
+ */
+double      INTUDecayRestingPosition(INTUDecay decay);
+
+/**
+ Returns how long the decay takes to come within the given distance of its resting position.
+ 
+ @param decay       The decay.
+ @param threshold   The distance from the resting position that is considered close enough to be at rest. Must be greater than zero.
+ 
+ @return The duration of the decay in seconds, or zero if it starts within the threshold of its resting position.
+ */
+double      INTUDecayDuration(INTUDecay decay, double threshold);
+
+/**
+ Returns the time at which the decay reaches the given position. This is used to find when a decay crosses a boundary, so that the motion
+ can be handed off to a spring.
+ 
+ @param decay       The decay.
+ @param position    The position to reach.
+ 
+ @return The time in seconds, or INFINITY if the decay never reaches the position (because it is behind the initial position, or beyond
+         the resting position).
+ */
+double      INTUDecayTimeToReachPosition(INTUDecay decay, double position);
+
+#endif /* INTUDecaySolver_h */
@@ -0,0 +1,417 @@
+//
+//  INTUSpringNetwork.c
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2014 Facebook, Inc. All rights reserved.
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice, this
+//     list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//   * Neither the name Facebook nor the names of its contributors may be used to
+//     endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+//  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+//  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+//  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "INTUSpringNetwork.h"
+#include "INTUVector.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef INTU_SPRING_SOLVER_SINGLE_PRECISION
+// Route the vector functions to their single precision variants.
+#   define zeroVector                  zeroVectorf
+#   define copyVector                  copyVectorf
+#   define multiplyScalarWithVector    multiplyScalarWithVectorf
+#   define addVectors                  addVectorsf
+#   define subVectors                  subVectorsf
+#   define squaredNorm                 squaredNormf
+#endif
+
+struct INTUSpringNetworkContext {
+    /** The number of nodes in the network. */
+    int nodeCount;
+    /** The number of scalar components in each state array (nodeCount * kINTUSpringSolverDimensions). */
+    int componentCount;
+    /** The number of springs connecting the nodes. */
+    int springCount;
+    /** The maximum number of springs that can connect the nodes. */
+    int maxSprings;
+    
+    /** The threshold used to determine when the springs are sufficiently close to their rest points. */
+    INTUSpringScalar thresholdPosition;
+    /** The threshold used to determine when the velocity of each node is sufficiently close to the quiescent state. */
+    INTUSpringScalar thresholdVelocity;
+    /** The threshold used to determine when the acceleration of each node is sufficiently close to the quiescent state. */
+    INTUSpringScalar thresholdAcceleration;
+    
+    /** The time when the spring network was last advanced. */
+    double lastTime;
+    /** The accumulated time that remains over which the network's state needs to be calculated. */
+    double accumulatedTime;
+    /** Whether the network has been advanced yet. */
+    bool started;
+    
+    /** The inverse mass of each node, or zero for a pinned node (so that no force can move it). */
+    INTUSpringScalar *inverseMass;
+    
+    /** The state of every node after the last integration step. */
+    INTUSpringScalar *position;
+    INTUSpringScalar *velocity;
+    INTUSpringScalar *acceleration;
+    /** The state of every node before the last integration step, used to interpolate to times between steps. */
+    INTUSpringScalar *previousPosition;
+    INTUSpringScalar *previousVelocity;
+    /** The positions of every node interpolated to the time that the network was last advanced to. */
+    INTUSpringScalar *outputPosition;
+    
+    /** Scratch space for the intermediate stages of each integration step. */
+    INTUSpringScalar *stagePosition;
+    INTUSpringScalar *stageVelocity;
+    INTUSpringScalar *stageAcceleration;
+    INTUSpringScalar *sumPosition;
+    INTUSpringScalar *sumVelocity;
+    
+    /** The springs, stored as parallel arrays indexed by spring. */
+    int *springNodeA;
+    int *springNodeB;
+    INTUSpringScalar *springStiffness;
+    INTUSpringScalar *springDamping;
+    /** The rest offset of each spring, with the kINTUSpringSolverDimensions components of each spring stored next to each other. */
+    INTUSpringScalar *springRestOffset;
+};
+/** A private struct that stores the internal state of a spring network. */
+typedef struct INTUSpringNetworkContext INTUSpringNetworkContext;
+
+
+static void integrate(INTUSpringNetworkContextRef context, double dt);
+
+static void accelerations(INTUSpringNetworkContextRef context,
+                          const INTUSpringScalar *positions,
+                          const INTUSpringScalar *velocities,
+                          INTUSpringScalar *outputAccelerations);
+
+static void interpolate(INTUSpringNetworkContextRef context, INTUSpringScalar alpha);
+
+
+#pragma mark Public API
+
+INTUSpringNetworkContextRef INTUSpringNetworkContextCreate(int nodeCount, int maxSprings, double threshold)
+{
+    if (nodeCount <= 0 ||
+        maxSprings < 0 ||
+        !isfinite(threshold) ||
+        threshold <= 0.0) {
+        return NULL;
+    }
+    
+    INTUSpringNetworkContextRef context = calloc(1, sizeof(INTUSpringNetworkContext));
+    if (context == NULL) {
+        return NULL;
+    }
+    
+    int componentCount = nodeCount * kINTUSpringSolverDimensions;
+    context->nodeCount = nodeCount;
+    context->componentCount = componentCount;
+    context->maxSprings = maxSprings;
+    
+    // All of the per-node state arrays are allocated as a single contiguous block.
+    const int stateArrayCount = 11;
+    INTUSpringScalar *state = calloc((size_t)nodeCount + (size_t)stateArrayCount * componentCount, sizeof(INTUSpringScalar));
+    INTUSpringScalar *springScalars = calloc((size_t)maxSprings * (2 + kINTUSpringSolverDimensions) + 1, sizeof(INTUSpringScalar));
+    int *springNodes = calloc((size_t)maxSprings * 2 + 1, sizeof(int));
+    if (state == NULL || springScalars == NULL || springNodes == NULL) {
+        free(state);
+        free(springScalars);
+        free(springNodes);
+        free(context);
+        return NULL;
+    }
+    
+    context->inverseMass = state;
+    context->position = context->inverseMass + nodeCount;
+    context->velocity = context->position + componentCount;
+    context->acceleration = context->velocity + componentCount;
+    context->previousPosition = context->acceleration + componentCount;
+    context->previousVelocity = context->previousPosition + componentCount;
+    context->outputPosition = context->previousVelocity + componentCount;
+    context->stagePosition = context->outputPosition + componentCount;
+    context->stageVelocity = context->stagePosition + componentCount;
+    context->stageAcceleration = context->stageVelocity + componentCount;
+    context->sumPosition = context->stageAcceleration + componentCount;
+    context->sumVelocity = context->sumPosition + componentCount;
+    
+    context->springStiffness = springScalars;
+    context->springDamping = context->springStiffness + maxSprings;
+    context->springRestOffset = context->springDamping + maxSprings;
+    context->springNodeA = springNodes;
+    context->springNodeB = context->springNodeA + maxSprings;
+    
+    for (int i = 0; i < nodeCount; i++) {
+        context->inverseMass[i] = 1.0;
+    }
+    
+    // These match the thresholds used by the spring solver for a threshold of the same value.
+    context->thresholdPosition = threshold / 2;
+    context->thresholdVelocity = 25.0 * threshold;
+    context->thresholdAcceleration = 625.0 * threshold * threshold;
+    
+    return context;
+}
+
+void INTUSpringNetworkContextDestroy(INTUSpringNetworkContextRef context)
+{
+    if (context == NULL) {
+        return;
+    }
+    free(context->inverseMass);
+    free(context->springStiffness);
+    free(context->springNodeA);
+    free(context);
+}
+
+bool INTUSpringNetworkSetNode(INTUSpringNetworkContextRef context,
+                              int node,
+                              double mass,
+                              const INTUSpringScalar *position,
+                              const INTUSpringScalar *velocity,
+                              bool pinned)
+{
+    if (node < 0 ||
+        node >= context->nodeCount ||
+        (!pinned && (!isfinite(mass) || mass <= 0.0)) ||
+        position == NULL ||
+        velocity == NULL) {
+        return false;
+    }
+    
+    int offset = node * kINTUSpringSolverDimensions;
+    context->inverseMass[node] = pinned ? 0.0 : (1.0 / mass);
+    INTUSpringNetworkSetNodePosition(context, node, position);
+    if (pinned) {
+        zeroVector(kINTUSpringSolverDimensions, context->velocity + offset);
+    } else {
+        copyVector(kINTUSpringSolverDimensions, velocity, context->velocity + offset);
+    }
+    copyVector(kINTUSpringSolverDimensions, context->velocity + offset, context->previousVelocity + offset);
+    return true;
+}
+
+void INTUSpringNetworkSetNodePosition(INTUSpringNetworkContextRef context, int node, const INTUSpringScalar *position)
+{
+    if (node < 0 || node >= context->nodeCount || position == NULL) {
+        return;
+    }
+    
+    int offset = node * kINTUSpringSolverDimensions;
+    copyVector(kINTUSpringSolverDimensions, position, context->position + offset);
+    copyVector(kINTUSpringSolverDimensions, position, context->previousPosition + offset);
+    copyVector(kINTUSpringSolverDimensions, position, context->outputPosition + offset);
+}
+
+bool INTUSpringNetworkConnect(INTUSpringNetworkContextRef context,
+                              int nodeA,
+                              int nodeB,
+                              double stiffness,
+                              double damping,
+                              const INTUSpringScalar *restOffset)
+{
+    if (context->springCount >= context->maxSprings ||
+        nodeA < 0 || nodeA >= context->nodeCount ||
+        nodeB < 0 || nodeB >= context->nodeCount ||
+        nodeA == nodeB ||
+        !isfinite(stiffness) ||
+        stiffness <= 0.0 ||
+        !isfinite(damping) ||
+        damping < 0.0) {
+        return false;
+    }
+    
+    int spring = context->springCount;
+    context->springNodeA[spring] = nodeA;
+    context->springNodeB[spring] = nodeB;
+    context->springStiffness[spring] = stiffness;
+    context->springDamping[spring] = damping;
+    if (restOffset) {
+        copyVector(kINTUSpringSolverDimensions, restOffset, context->springRestOffset + spring * kINTUSpringSolverDimensions);
+    } else {
+        zeroVector(kINTUSpringSolverDimensions, context->springRestOffset + spring * kINTUSpringSolverDimensions);
+    }
+    context->springCount++;
+    return true;
+}
+
+void INTUAdvanceSpringNetwork(INTUSpringNetworkContextRef context, double newTime)
+{
+    if (newTime < context->lastTime) {
+        // The spring network must always be advanced; ignore any time earlier than the last time.
+        return;
+    }
+    context->started = true;
+    
+    context->accumulatedTime += (newTime - context->lastTime);
+    context->lastTime = newTime;
+    
+    while (context->accumulatedTime >= kINTUSolverDt) {
+        copyVector(context->componentCount, context->position, context->previousPosition);
+        copyVector(context->componentCount, context->velocity, context->previousVelocity);
+        
+        integrate(context, kINTUSolverDt);
+        
+        context->accumulatedTime -= kINTUSolverDt;
+    }
+    
+    interpolate(context, (INTUSpringScalar)(context->accumulatedTime / kINTUSolverDt));
+}
+
+const INTUSpringScalar *INTUSpringNetworkGetPositions(INTUSpringNetworkContextRef context)
+{
+    return context->outputPosition;
+}
+
+bool INTUSpringNetworkHasConverged(INTUSpringNetworkContextRef context)
+{
+    if (!context->started) {
+        return false;
+    }
+    
+    // Every spring must be (nearly) at its rest point...
+    for (int spring = 0; spring < context->springCount; spring++) {
+        const INTUSpringScalar *positionA = context->position + context->springNodeA[spring] * kINTUSpringSolverDimensions;
+        const INTUSpringScalar *positionB = context->position + context->springNodeB[spring] * kINTUSpringSolverDimensions;
+        const INTUSpringScalar *restOffset = context->springRestOffset + spring * kINTUSpringSolverDimensions;
+        for (int i = 0; i < kINTUSpringSolverDimensions; i++) {
+            if (fabs(positionB[i] - positionA[i] - restOffset[i]) >= context->thresholdPosition) {
+                return false;
+            }
+        }
+    }
+    
+    // ...and every unpinned node must have come to rest.
+    for (int node = 0; node < context->nodeCount; node++) {
+        if (context->inverseMass[node] == 0.0) {
+            continue;
+        }
+        int offset = node * kINTUSpringSolverDimensions;
+        if (squaredNorm(kINTUSpringSolverDimensions, context->velocity + offset) >= context->thresholdVelocity ||
+            squaredNorm(kINTUSpringSolverDimensions, context->acceleration + offset) >= context->thresholdAcceleration) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+#pragma mark Internal Functions
+
+/**
+ Advances the state of every node by one RK4 step of size dt. Each stage operates on the whole network at once, so the work per stage is
+ a handful of passes over contiguous arrays plus one pass over the springs.
+ */
+static void integrate(INTUSpringNetworkContextRef context, double dt)
+{
+    const int count = context->componentCount;
+    const INTUSpringScalar halfStep = dt * 0.5;
+    INTUSpringScalar *stagePosition = context->stagePosition;
+    INTUSpringScalar *stageVelocity = context->stageVelocity;
+    INTUSpringScalar *stageAcceleration = context->stageAcceleration;
+    INTUSpringScalar *sumPosition = context->sumPosition;
+    INTUSpringScalar *sumVelocity = context->sumVelocity;
+    
+    // Stage A, evaluated at the initial state
+    accelerations(context, context->position, context->velocity, stageAcceleration);
+    copyVector(count, context->velocity, sumPosition);
+    copyVector(count, stageAcceleration, sumVelocity);
+    copyVector(count, context->velocity, stageVelocity);
+    
+    // Stages B and C, evaluated at the half step using the derivatives of the previous stage
+    for (int stage = 0; stage < 2; stage++) {
+        for (int i = 0; i < count; i++) {
+            stagePosition[i] = context->position[i] + halfStep * stageVelocity[i];
+            stageVelocity[i] = context->velocity[i] + halfStep * stageAcceleration[i];
+        }
+        accelerations(context, stagePosition, stageVelocity, stageAcceleration);
+        for (int i = 0; i < count; i++) {
+            sumPosition[i] += 2.0 * stageVelocity[i];
+            sumVelocity[i] += 2.0 * stageAcceleration[i];
+        }
+    }
+    
+    // Stage D, evaluated at the full step using the derivatives of stage C
+    for (int i = 0; i < count; i++) {
+        stagePosition[i] = context->position[i] + dt * stageVelocity[i];
+        stageVelocity[i] = context->velocity[i] + dt * stageAcceleration[i];
+    }
+    accelerations(context, stagePosition, stageVelocity, stageAcceleration);
+    
+    const INTUSpringScalar sixth = 1.0 / 6.0;
+    for (int i = 0; i < count; i++) {
+        INTUSpringScalar dpdt = (sumPosition[i] + stageVelocity[i]) * sixth;
+        INTUSpringScalar dvdt = (sumVelocity[i] + stageAcceleration[i]) * sixth;
+        context->position[i] += dt * dpdt;
+        context->velocity[i] += dt * dvdt;
+        context->acceleration[i] = dvdt;
+    }
+}
+
+/**
+ Calculates the acceleration of every node. Each spring applies an equal and opposite force to the two nodes it connects, and each force is
+ scaled by the inverse mass of the node (which is zero for pinned nodes, so they never move).
+ */
+static void accelerations(INTUSpringNetworkContextRef context,
+                          const INTUSpringScalar *positions,
+                          const INTUSpringScalar *velocities,
+                          INTUSpringScalar *outputAccelerations)
+{
+    zeroVector(context->componentCount, outputAccelerations);
+    
+    for (int spring = 0; spring < context->springCount; spring++) {
+        const int offsetA = context->springNodeA[spring] * kINTUSpringSolverDimensions;
+        const int offsetB = context->springNodeB[spring] * kINTUSpringSolverDimensions;
+        const INTUSpringScalar *restOffset = context->springRestOffset + spring * kINTUSpringSolverDimensions;
+        const INTUSpringScalar stiffness = context->springStiffness[spring];
+        const INTUSpringScalar damping = context->springDamping[spring];
+        for (int i = 0; i < kINTUSpringSolverDimensions; i++) {
+            INTUSpringScalar displacement = positions[offsetB + i] - positions[offsetA + i] - restOffset[i];
+            INTUSpringScalar relativeVelocity = velocities[offsetB + i] - velocities[offsetA + i];
+            INTUSpringScalar force = -stiffness * displacement - damping * relativeVelocity;
+            outputAccelerations[offsetB + i] += force;
+            outputAccelerations[offsetA + i] -= force;
+        }
+    }
+    
+    for (int node = 0; node < context->nodeCount; node++) {
+        multiplyScalarWithVector(kINTUSpringSolverDimensions,
+                                 context->inverseMass[node],
+                                 outputAccelerations + node * kINTUSpringSolverDimensions,
+                                 outputAccelerations + node * kINTUSpringSolverDimensions);
+    }
+}
+
+/**
+ Interpolates the positions of every node between the previous and current integration steps, storing the result in the output positions.
+ */
+static void interpolate(INTUSpringNetworkContextRef context, INTUSpringScalar alpha)
+{
+    for (int i = 0; i < context->componentCount; i++) {
+        context->outputPosition[i] = context->previousPosition[i] * (1 - alpha) + context->position[i] * alpha;
+    }
+}
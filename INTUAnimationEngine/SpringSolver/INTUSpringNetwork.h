@@ -0,0 +1,160 @@
+//
+//  INTUSpringNetwork.h
+//  https://github.com/intuit/AnimationEngine
+//
+//  Copyright (c) 2014 Facebook, Inc. All rights reserved.
+//  Copyright (c) 2015 Intuit Inc.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice, this
+//     list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//   * Neither the name Facebook nor the names of its contributors may be used to
+//     endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+//  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+//  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+//  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef INTUSpringNetwork_h
+#define INTUSpringNetwork_h
+
+#include <stdbool.h>
+#include "INTUSpringSolver.h"
+
+// A spring network simulates a set of nodes (masses) connected to each other by springs, so that the rest point of each node depends on
+// the current position of the nodes it is connected to. This is useful for chained effects such as trailing cards or follow-the-leader
+// motion, where the nodes must respond to each other in the same frame.
+//
+// All nodes are integrated together in one pass using the same stiffness/damping/mass model and fixed time step as the spring solver.
+// Node state is stored in contiguous arrays, with the kINTUSpringSolverDimensions components of each node stored next to each other.
+// Connections are stored as a sparse list of springs, so each node only pays for the springs attached to it.
+//
+// Pinned nodes are not moved by the simulation. They act as anchors (or leaders) for the rest of the network, and can be moved at any
+// time using INTUSpringNetworkSetNodePosition().
+
+/** A reference to a private struct that stores the internal state of a spring network. */
+typedef struct INTUSpringNetworkContext *INTUSpringNetworkContextRef;
+
+/**
+ Creates and returns a reference to a new spring network with the given capacity. Every node starts unpinned, at rest at the zero vector,
+ with a mass of 1.0.
+ 
+ @param nodeCount       The number of nodes in the network. Must be greater than zero.
+ @param maxSprings      The maximum number of springs that can connect the nodes. Must be greater than or equal to zero.
+ @param threshold       The distance that is considered close enough to the quiescent state for the network to have converged, in the same
+                        units as the node positions. For example, when the nodes represent points onscreen this could be 0.5 points.
+                        Must be finite and greater than zero.
+ 
+ @return A reference to the fully initialized spring network, or NULL if any parameter is invalid.
+ 
+ @discussion The calling code takes ownership of the created context, and when finished with it must call INTUSpringNetworkContextDestroy()
+             passing in the reference to this context to avoid a memory leak.
+ */
+INTUSpringNetworkContextRef     INTUSpringNetworkContextCreate(int nodeCount, int maxSprings, double threshold);
+
+/**
+ Destroys (deallocates) the spring network at the given reference.
+ 
+ @param context A reference to the spring network.
+ */
+void                            INTUSpringNetworkContextDestroy(INTUSpringNetworkContextRef context);
+
+/**
+ Sets the properties and state of one node in the spring network.
+ 
+ @param context     A reference to the spring network.
+ @param node        The index of the node, in the range 0 <= node < nodeCount.
+ @param mass        The amount of mass of the node. Must be finite and greater than zero. Ignored for pinned nodes.
+ @param position    A vector representing the position of the node. Must be an array of kINTUSpringSolverDimensions values.
+ @param velocity    A vector representing the velocity of the node. Must be an array of kINTUSpringSolverDimensions values. Ignored for
+                    pinned nodes.
+ @param pinned      Whether the node is pinned in place. Pinned nodes are not moved by the simulation.
+ 
+ @return Whether the node was set. Returns false if any parameter is invalid.
+ */
+bool                            INTUSpringNetworkSetNode(INTUSpringNetworkContextRef context,
+                                                         int node,
+                                                         double mass,
+                                                         const INTUSpringScalar *position,
+                                                         const INTUSpringScalar *velocity,
+                                                         bool pinned);
+
+/**
+ Moves a node to a new position. This is typically used to move a pinned node that leads the rest of the network (for example, to follow
+ a pan gesture), and takes effect the next time the network is advanced.
+ 
+ @param context     A reference to the spring network.
+ @param node        The index of the node, in the range 0 <= node < nodeCount.
+ @param position    A vector representing the new position of the node. Must be an array of kINTUSpringSolverDimensions values.
+ */
+void                            INTUSpringNetworkSetNodePosition(INTUSpringNetworkContextRef context,
+                                                                 int node,
+                                                                 const INTUSpringScalar *position);
+
+/**
+ Connects two nodes with a spring. The spring pulls node B towards a rest point at an offset from node A, and pulls node A equally in the
+ opposite direction.
+ 
+ @param context     A reference to the spring network.
+ @param nodeA       The index of the node that the rest point is relative to.
+ @param nodeB       The index of the node that is pulled towards the rest point.
+ @param stiffness   The stiffness of the spring. Must be finite and greater than zero. Typical range: 1.0 to 500.0
+ @param damping     The amount of friction, applied to the relative velocity of the two nodes. Must be finite and greater than or equal to
+                    zero. Typical range: 1.0 to 30.0
+ @param restOffset  A vector representing the position of node B relative to node A when the spring is at rest, or NULL for the zero vector.
+                    Must be an array of kINTUSpringSolverDimensions values.
+ 
+ @return Whether the spring was added. Returns false if any parameter is invalid, or if the network already has maxSprings springs.
+ */
+bool                            INTUSpringNetworkConnect(INTUSpringNetworkContextRef context,
+                                                         int nodeA,
+                                                         int nodeB,
+                                                         double stiffness,
+                                                         double damping,
+                                                         const INTUSpringScalar *restOffset);
+
+/**
+ Advances every node in the spring network to the new time.
+ 
+ @param context A reference to the spring network.
+ @param newTime The new time (in seconds) to advance the spring network to. The new time must be greater than zero, and greater than the
+                time passed into the previous call to advance the spring network.
+ */
+void                            INTUAdvanceSpringNetwork(INTUSpringNetworkContextRef context, double newTime);
+
+/**
+ Returns the current positions of all nodes in the spring network, as of the last time it was advanced.
+ 
+ @param context A reference to the spring network.
+ 
+ @return A contiguous array of nodeCount * kINTUSpringSolverDimensions values, where the position of node i starts at index
+         i * kINTUSpringSolverDimensions. The array is owned by the context, and remains valid until the context is destroyed.
+ */
+const INTUSpringScalar *        INTUSpringNetworkGetPositions(INTUSpringNetworkContextRef context);
+
+/**
+ Returns whether or not the spring network has converged: every spring is at its rest point, and every unpinned node has come to rest.
+ 
+ @param context A reference to the spring network.
+ 
+ @return Whether or not the whole spring network has reached its quiescent state.
+ */
+bool                            INTUSpringNetworkHasConverged(INTUSpringNetworkContextRef context);
+
+#endif /* INTUSpringNetwork_h */
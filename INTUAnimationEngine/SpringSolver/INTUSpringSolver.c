@@ -34,6 +34,18 @@
 #include "INTUSpringSolver.h"
 #include "INTUVector.h"
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef INTU_SPRING_SOLVER_SINGLE_PRECISION
+// Route the vector functions to their single precision variants.
+#   define zeroVector                  zeroVectorf
+#   define copyVector                  copyVectorf
+#   define multiplyScalarWithVector    multiplyScalarWithVectorf
+#   define addVectors                  addVectorsf
+#   define subVectors                  subVectorsf
+#   define squaredNorm                 squaredNormf
+#   define norm                        normf
+#endif
 
 /** The time step that the solver uses, in seconds. */
 const double kINTUSolverDt = 0.001;
@@ -43,18 +55,18 @@ const double kINTUThresholdFactor = 0.0001; // 0.01%
 
 struct INTUSpringSolverContext {
     /** The stiffness of the spring. Must be greater than zero. */
-    double stiffness;
+    INTUSpringScalar stiffness;
     /** The amount of friction. Must be greater than or equal to zero. If exactly zero, the harmonic motion will continue forever and the solver will never converge.  */
-    double damping;
+    INTUSpringScalar damping;
     /** The amount of mass being moved by the spring. Must be greater than zero. */
-    double mass;
+    INTUSpringScalar mass;
     
     /** The threshold used to determine when the position is sufficiently close to the quiescent state. */
-    double thresholdPosition;
+    INTUSpringScalar thresholdPosition;
     /** The threshold used to determine when the velocity is sufficiently close to the quiescent state. */
-    double thresholdVelocity;
+    INTUSpringScalar thresholdVelocity;
     /** The threshold used to determine when the acceleration is sufficiently close to the quiescent state. */
-    double thresholdAcceleration;
+    INTUSpringScalar thresholdAcceleration;
     
     /** The time when the spring solver was last advanced. */
     double lastTime;
@@ -62,11 +74,14 @@ struct INTUSpringSolverContext {
     double accumulatedTime;
     
     /** The current position of the mass on the spring. */
-    double currentPosition[kINTUSpringSolverDimensions];
+    INTUSpringScalar currentPosition[kINTUSpringSolverDimensions];
     /** The current velocity of the mass on the spring. */
-    double currentVelocity[kINTUSpringSolverDimensions];
+    INTUSpringScalar currentVelocity[kINTUSpringSolverDimensions];
     /** The current acceleration of the mass on the spring. */
-    double currentAcceleration[kINTUSpringSolverDimensions];
+    INTUSpringScalar currentAcceleration[kINTUSpringSolverDimensions];
+    
+    /** The number of integration steps taken by the last call to advance the solver. */
+    unsigned int lastStepCount;
     
     /** Whether the system that this context represents has been advanced yet. */
     bool started;
@@ -77,56 +92,56 @@ typedef struct INTUSpringSolverContext INTUSpringSolverContext;
 
 static void resetContext(INTUSpringSolverContextRef context);
 
-static void setConstants(INTUSpringSolverContextRef context, double k, double b, double m);
+static void setConstants(INTUSpringSolverContextRef context, INTUSpringScalar k, INTUSpringScalar b, INTUSpringScalar m);
 
-static void setThreshold(INTUSpringSolverContextRef context, double t);
+static void setThreshold(INTUSpringSolverContextRef context, INTUSpringScalar threshold);
 
 static void integrate(INTUSpringSolverContextRef context,
-                      const double *positionVector,
-                      const double *velocityVector,
+                      const INTUSpringScalar *positionVector,
+                      const INTUSpringScalar *velocityVector,
                       double t,
                       double dt,
-                      double *outputPositionVector,
-                      double *outputVelocityVector);
+                      INTUSpringScalar *outputPositionVector,
+                      INTUSpringScalar *outputVelocityVector);
 
 static void derivative(int dimension,
-                       double *ax,
-                       double *bx,
-                       double *cx,
-                       double *dx,
-                       double *output);
+                       INTUSpringScalar *ax,
+                       INTUSpringScalar *bx,
+                       INTUSpringScalar *cx,
+                       INTUSpringScalar *dx,
+                       INTUSpringScalar *output);
 
 static void evaluate(INTUSpringSolverContextRef context,
-                     const double *positionVector,
-                     const double *velocityVector,
+                     const INTUSpringScalar *positionVector,
+                     const INTUSpringScalar *velocityVector,
                      double t,
-                     double *deltaPosition,
-                     double *deltaVelocity);
+                     INTUSpringScalar *deltaPosition,
+                     INTUSpringScalar *deltaVelocity);
 
 static void evaluateWithDerivative(INTUSpringSolverContextRef context,
-                                   const double *positionVector,
-                                   const double *velocityVector,
+                                   const INTUSpringScalar *positionVector,
+                                   const INTUSpringScalar *velocityVector,
                                    double t,
                                    double dt,
-                                   const double *inputDeltaPosition,
-                                   const double *inputDeltaVelocity,
-                                   double *outputDeltaPosition,
-                                   double *outputDeltaVelocity);
+                                   const INTUSpringScalar *inputDeltaPosition,
+                                   const INTUSpringScalar *inputDeltaVelocity,
+                                   INTUSpringScalar *outputDeltaPosition,
+                                   INTUSpringScalar *outputDeltaVelocity);
 
 static void acceleration(const INTUSpringSolverContextRef context,
-                         const double *positionVector,
-                         const double *velocityVector,
+                         const INTUSpringScalar *positionVector,
+                         const INTUSpringScalar *velocityVector,
                          double t,
-                         double *accelerationVector);
+                         INTUSpringScalar *accelerationVector);
 
 static void interpolate(int dimension,
-                        const double *previousPositionVector,
-                        const double *previousVelocityVector,
-                        const double *currentPositionVector,
-                        const double *currentVelocityVector,
-                        double alpha,
-                        double *outputPositionVector,
-                        double *outputVelocityVector);
+                        const INTUSpringScalar *previousPositionVector,
+                        const INTUSpringScalar *previousVelocityVector,
+                        const INTUSpringScalar *currentPositionVector,
+                        const INTUSpringScalar *currentVelocityVector,
+                        INTUSpringScalar alpha,
+                        INTUSpringScalar *outputPositionVector,
+                        INTUSpringScalar *outputVelocityVector);
 
 
 #pragma mark Public API
@@ -134,14 +149,32 @@ static void interpolate(int dimension,
 INTUSpringSolverContextRef INTUSpringSolverContextCreate(double stiffness,
                                                          double damping,
                                                          double mass,
-                                                         const double *initialPosition,
-                                                         const double *initialVelocity)
+                                                         const INTUSpringScalar *initialPosition,
+                                                         const INTUSpringScalar *initialVelocity)
+{
+    if (initialPosition == NULL) {
+        return NULL;
+    }
+    
+    // Take the norm of the initial position and multiply it by the threshold factor to get the threshold value.
+    // This makes the threshold relative to the scale of whatever unit is being used in the starting position.
+    double threshold = norm(kINTUSpringSolverDimensions, initialPosition) * kINTUThresholdFactor;
+    return INTUSpringSolverContextCreateWithThreshold(stiffness, damping, mass, initialPosition, initialVelocity, threshold);
+}
+
+INTUSpringSolverContextRef INTUSpringSolverContextCreateWithThreshold(double stiffness,
+                                                                      double damping,
+                                                                      double mass,
+                                                                      const INTUSpringScalar *initialPosition,
+                                                                      const INTUSpringScalar *initialVelocity,
+                                                                      double threshold)
 {
     if (stiffness <= 0.0 ||
         damping < 0.0 ||
         mass <= 0.0 ||
         initialPosition == NULL ||
-        initialVelocity == NULL) {
+        initialVelocity == NULL ||
+        threshold < 0.0) {
         return NULL;
     }
     
@@ -151,9 +184,6 @@ INTUSpringSolverContextRef INTUSpringSolverContextCreate(double stiffness,
     
     setConstants(context, stiffness, damping, mass);
     
-    // Take the norm of the initial position and multiply it by the threshold factor to get the threshold value.
-    // This makes the threshold relative to the scale of whatever unit is being used in the starting position.
-    double threshold = norm(kINTUSpringSolverDimensions, initialPosition) * kINTUThresholdFactor;
     setThreshold(context, threshold);
     
     copyVector(kINTUSpringSolverDimensions, initialPosition, context->currentPosition);
@@ -162,6 +192,53 @@ INTUSpringSolverContextRef INTUSpringSolverContextCreate(double stiffness,
     return context;
 }
 
+INTUSpringSolverContextRef INTUSpringSolverContextCreateWithSnapshot(const INTUSpringSolverSnapshot *snapshot)
+{
+    if (snapshot == NULL ||
+        !(snapshot->stiffness > 0.0) ||
+        !(snapshot->damping >= 0.0) ||
+        !(snapshot->mass > 0.0) ||
+        !(snapshot->lastTime >= 0.0) ||
+        !(snapshot->accumulatedTime >= 0.0)) {
+        return NULL;
+    }
+    
+    INTUSpringSolverContextRef context = malloc(sizeof(INTUSpringSolverContext));
+    
+    setConstants(context, snapshot->stiffness, snapshot->damping, snapshot->mass);
+    
+    context->thresholdPosition = snapshot->thresholdPosition;
+    context->thresholdVelocity = snapshot->thresholdVelocity;
+    context->thresholdAcceleration = snapshot->thresholdAcceleration;
+    context->lastTime = snapshot->lastTime;
+    context->accumulatedTime = snapshot->accumulatedTime;
+    copyVector(kINTUSpringSolverDimensions, snapshot->position, context->currentPosition);
+    copyVector(kINTUSpringSolverDimensions, snapshot->velocity, context->currentVelocity);
+    copyVector(kINTUSpringSolverDimensions, snapshot->acceleration, context->currentAcceleration);
+    context->lastStepCount = snapshot->lastStepCount;
+    context->started = snapshot->started;
+    
+    return context;
+}
+
+void INTUSpringSolverContextGetSnapshot(INTUSpringSolverContextRef context, INTUSpringSolverSnapshot *snapshot)
+{
+    memset(snapshot, 0, sizeof(INTUSpringSolverSnapshot));
+    snapshot->stiffness = context->stiffness;
+    snapshot->damping = context->damping;
+    snapshot->mass = context->mass;
+    snapshot->thresholdPosition = context->thresholdPosition;
+    snapshot->thresholdVelocity = context->thresholdVelocity;
+    snapshot->thresholdAcceleration = context->thresholdAcceleration;
+    snapshot->lastTime = context->lastTime;
+    snapshot->accumulatedTime = context->accumulatedTime;
+    copyVector(kINTUSpringSolverDimensions, context->currentPosition, snapshot->position);
+    copyVector(kINTUSpringSolverDimensions, context->currentVelocity, snapshot->velocity);
+    copyVector(kINTUSpringSolverDimensions, context->currentAcceleration, snapshot->acceleration);
+    snapshot->lastStepCount = context->lastStepCount;
+    snapshot->started = context->started;
+}
+
 void INTUSpringSolverContextDestroy(INTUSpringSolverContextRef context)
 {
     free(context);
@@ -182,14 +259,15 @@ INTUSpringState INTUAdvanceSpringSolver(INTUSpringSolverContextRef context, doub
     double t = context->lastTime;
     context->lastTime = newTime;
     
-    double currentPosition[kINTUSpringSolverDimensions], currentVelocity[kINTUSpringSolverDimensions];
-    double previousPosition[kINTUSpringSolverDimensions], previousVelocity[kINTUSpringSolverDimensions];
+    INTUSpringScalar currentPosition[kINTUSpringSolverDimensions], currentVelocity[kINTUSpringSolverDimensions];
+    INTUSpringScalar previousPosition[kINTUSpringSolverDimensions], previousVelocity[kINTUSpringSolverDimensions];
     
     copyVector(kINTUSpringSolverDimensions, context->currentPosition, currentPosition);
     copyVector(kINTUSpringSolverDimensions, context->currentVelocity, currentVelocity);
     copyVector(kINTUSpringSolverDimensions, currentPosition, previousPosition);
     copyVector(kINTUSpringSolverDimensions, currentVelocity, previousVelocity);
     
+    unsigned int stepCount = 0;
     while (context->accumulatedTime >= kINTUSolverDt) {
         copyVector(kINTUSpringSolverDimensions, currentPosition, previousPosition);
         copyVector(kINTUSpringSolverDimensions, currentVelocity, previousVelocity);
@@ -198,10 +276,12 @@ INTUSpringState INTUAdvanceSpringSolver(INTUSpringSolverContextRef context, doub
         
         t += kINTUSolverDt;
         context->accumulatedTime -= kINTUSolverDt;
+        stepCount++;
     }
+    context->lastStepCount = stepCount;
     
-    double alpha = context->accumulatedTime / kINTUSolverDt;
-    double advancedPosition[kINTUSpringSolverDimensions], advancedVelocity[kINTUSpringSolverDimensions];
+    INTUSpringScalar alpha = (INTUSpringScalar)(context->accumulatedTime / kINTUSolverDt);
+    INTUSpringScalar advancedPosition[kINTUSpringSolverDimensions], advancedVelocity[kINTUSpringSolverDimensions];
     
     interpolate(kINTUSpringSolverDimensions, previousPosition, previousVelocity, currentPosition, currentVelocity, alpha, advancedPosition, advancedVelocity);
     copyVector(kINTUSpringSolverDimensions, advancedPosition, context->currentPosition);
@@ -233,26 +313,32 @@ bool INTUSpringSolverHasConverged(INTUSpringSolverContextRef context)
     return velocityConverged && accelerationConverged;
 }
 
+unsigned int INTUSpringSolverGetLastStepCount(INTUSpringSolverContextRef context)
+{
+    return context->lastStepCount;
+}
+
 #pragma mark Internal Functions
 
 static void resetContext(INTUSpringSolverContextRef context)
 {
     context->lastTime = 0.0;
     context->accumulatedTime = 0.0;
+    context->lastStepCount = 0;
     zeroVector(kINTUSpringSolverDimensions, context->currentPosition);
     zeroVector(kINTUSpringSolverDimensions, context->currentVelocity);
     zeroVector(kINTUSpringSolverDimensions, context->currentAcceleration);
     context->started = false;
 }
 
-static void setConstants(INTUSpringSolverContextRef context, double k, double b, double m)
+static void setConstants(INTUSpringSolverContextRef context, INTUSpringScalar k, INTUSpringScalar b, INTUSpringScalar m)
 {
     context->stiffness = k;
     context->damping = b;
     context->mass = m;
 }
 
-static void setThreshold(INTUSpringSolverContextRef context, double threshold)
+static void setThreshold(INTUSpringSolverContextRef context, INTUSpringScalar threshold)
 {
     context->thresholdPosition = threshold / 2; // half a unit
     context->thresholdVelocity = 25.0 * threshold; // 5 units per second, squared for comparison
@@ -260,19 +346,19 @@ static void setThreshold(INTUSpringSolverContextRef context, double threshold)
 }
 
 static void integrate(INTUSpringSolverContextRef context,
-                      const double *positionVector,
-                      const double *velocityVector,
+                      const INTUSpringScalar *positionVector,
+                      const INTUSpringScalar *velocityVector,
                       double t,
                       double dt,
-                      double *outputPositionVector,
-                      double *outputVelocityVector)
+                      INTUSpringScalar *outputPositionVector,
+                      INTUSpringScalar *outputVelocityVector)
 {
-    double derivativePositionA[kINTUSpringSolverDimensions], derivativeVelocityA[kINTUSpringSolverDimensions];
-    double derivativePositionB[kINTUSpringSolverDimensions], derivativeVelocityB[kINTUSpringSolverDimensions];
-    double derivativePositionC[kINTUSpringSolverDimensions], derivativeVelocityC[kINTUSpringSolverDimensions];
-    double derivativePositionD[kINTUSpringSolverDimensions], derivativeVelocityD[kINTUSpringSolverDimensions];
-    double dpdt[kINTUSpringSolverDimensions], dvdt[kINTUSpringSolverDimensions];
-    double dpdtTimesDt[kINTUSpringSolverDimensions], dvdtTimesDt[kINTUSpringSolverDimensions];
+    INTUSpringScalar derivativePositionA[kINTUSpringSolverDimensions], derivativeVelocityA[kINTUSpringSolverDimensions];
+    INTUSpringScalar derivativePositionB[kINTUSpringSolverDimensions], derivativeVelocityB[kINTUSpringSolverDimensions];
+    INTUSpringScalar derivativePositionC[kINTUSpringSolverDimensions], derivativeVelocityC[kINTUSpringSolverDimensions];
+    INTUSpringScalar derivativePositionD[kINTUSpringSolverDimensions], derivativeVelocityD[kINTUSpringSolverDimensions];
+    INTUSpringScalar dpdt[kINTUSpringSolverDimensions], dvdt[kINTUSpringSolverDimensions];
+    INTUSpringScalar dpdtTimesDt[kINTUSpringSolverDimensions], dvdtTimesDt[kINTUSpringSolverDimensions];
     
     evaluate(context, positionVector, velocityVector, t, derivativePositionA, derivativeVelocityA);
     
@@ -293,11 +379,11 @@ static void integrate(INTUSpringSolverContextRef context,
 }
 
 static void derivative(int dimension,
-                       double *ax,
-                       double *bx,
-                       double *cx,
-                       double *dx,
-                       double *output)
+                       INTUSpringScalar *ax,
+                       INTUSpringScalar *bx,
+                       INTUSpringScalar *cx,
+                       INTUSpringScalar *dx,
+                       INTUSpringScalar *output)
 {
     addVectors(dimension, bx, cx, output);
     multiplyScalarWithVector(dimension, 2.0, output, output);
@@ -307,28 +393,28 @@ static void derivative(int dimension,
 }
 
 static void evaluate(INTUSpringSolverContextRef context,
-                     const double *positionVector,
-                     const double *velocityVector,
+                     const INTUSpringScalar *positionVector,
+                     const INTUSpringScalar *velocityVector,
                      double t,
-                     double *deltaPosition,
-                     double *deltaVelocity)
+                     INTUSpringScalar *deltaPosition,
+                     INTUSpringScalar *deltaVelocity)
 {
     copyVector(kINTUSpringSolverDimensions, velocityVector, deltaPosition);
     acceleration(context, positionVector, velocityVector, t, deltaVelocity);
 }
 
 static void evaluateWithDerivative(INTUSpringSolverContextRef context,
-                                   const double *initialPositionVector,
-                                   const double *initialVelocityVector,
+                                   const INTUSpringScalar *initialPositionVector,
+                                   const INTUSpringScalar *initialVelocityVector,
                                    double t,
                                    double dt,
-                                   const double *inputDeltaPosition,
-                                   const double *inputDeltaVelocity,
-                                   double *outputDeltaPosition,
-                                   double *outputDeltaVelocity)
+                                   const INTUSpringScalar *inputDeltaPosition,
+                                   const INTUSpringScalar *inputDeltaVelocity,
+                                   INTUSpringScalar *outputDeltaPosition,
+                                   INTUSpringScalar *outputDeltaVelocity)
 {
-    double dpdt[kINTUSpringSolverDimensions], dvdt[kINTUSpringSolverDimensions];
-    double positionVector[kINTUSpringSolverDimensions], velocityVector[kINTUSpringSolverDimensions];
+    INTUSpringScalar dpdt[kINTUSpringSolverDimensions], dvdt[kINTUSpringSolverDimensions];
+    INTUSpringScalar positionVector[kINTUSpringSolverDimensions], velocityVector[kINTUSpringSolverDimensions];
     
     multiplyScalarWithVector(kINTUSpringSolverDimensions, dt, inputDeltaPosition, dpdt);
     multiplyScalarWithVector(kINTUSpringSolverDimensions, dt, inputDeltaVelocity, dvdt);
@@ -341,12 +427,12 @@ static void evaluateWithDerivative(INTUSpringSolverContextRef context,
 }
 
 static void acceleration(const INTUSpringSolverContextRef context,
-                         const double *positionVector,
-                         const double *velocityVector,
+                         const INTUSpringScalar *positionVector,
+                         const INTUSpringScalar *velocityVector,
                          double t,
-                         double *accelerationVector)
+                         INTUSpringScalar *accelerationVector)
 {
-    double intermediate1[kINTUSpringSolverDimensions], intermediate2[kINTUSpringSolverDimensions];
+    INTUSpringScalar intermediate1[kINTUSpringSolverDimensions], intermediate2[kINTUSpringSolverDimensions];
     
     multiplyScalarWithVector(kINTUSpringSolverDimensions, (-context->stiffness/context->mass), positionVector, intermediate1);
     multiplyScalarWithVector(kINTUSpringSolverDimensions, (context->damping/context->mass), velocityVector, intermediate2);
@@ -355,15 +441,15 @@ static void acceleration(const INTUSpringSolverContextRef context,
 }
 
 static void interpolate(int dimension,
-                        const double *previousPositionVector,
-                        const double *previousVelocityVector,
-                        const double *currentPositionVector,
-                        const double *currentVelocityVector,
-                        double alpha,
-                        double *outputPositionVector,
-                        double *outputVelocityVector)
+                        const INTUSpringScalar *previousPositionVector,
+                        const INTUSpringScalar *previousVelocityVector,
+                        const INTUSpringScalar *currentPositionVector,
+                        const INTUSpringScalar *currentVelocityVector,
+                        INTUSpringScalar alpha,
+                        INTUSpringScalar *outputPositionVector,
+                        INTUSpringScalar *outputVelocityVector)
 {
-    double currentPositionTimesAlpha[kINTUSpringSolverDimensions], currentVelocityTimesAlpha[kINTUSpringSolverDimensions];
+    INTUSpringScalar currentPositionTimesAlpha[kINTUSpringSolverDimensions], currentVelocityTimesAlpha[kINTUSpringSolverDimensions];
     
     multiplyScalarWithVector(dimension, alpha, currentPositionVector, currentPositionTimesAlpha);
     multiplyScalarWithVector(dimension, alpha, currentVelocityVector, currentVelocityTimesAlpha);
@@ -87,4 +87,60 @@ static inline double norm(int dimensions, const double *v)
     return sqrt(squaredNorm(dimensions, v));
 }
 
+#pragma mark Single Precision
+
+// Single precision (float) variants of the vector functions above. These are used by the spring solver when it is built with
+// INTU_SPRING_SOLVER_SINGLE_PRECISION, and can be used directly by batch code that wants to fit twice as many lanes in a SIMD register.
+
+static inline void zeroVectorf(int dimensions, float *components)
+{
+    for (int i = 0; i < dimensions; i++) {
+        components[i] = 0.0f;
+    }
+}
+
+static inline void copyVectorf(int dimensions, const float *input, float *output)
+{
+    for (int i = 0; i < dimensions; i++) {
+        output[i] = input[i];
+    }
+}
+
+static inline void multiplyScalarWithVectorf(int dimensions, float scalar, const float *input, float *output)
+{
+    for (int i = 0; i < dimensions; i++) {
+        output[i] = input[i] * scalar;
+    }
+}
+
+static inline void addVectorsf(int dimensions, const float *v1, const float *v2, float *output)
+{
+    for (int i = 0; i < dimensions; i++) {
+        output[i] = v1[i] + v2[i];
+    }
+}
+
+static inline void subVectorsf(int dimensions, const float *v1, const float *v2, float *output)
+{
+    for (int i = 0; i < dimensions; i++) {
+        output[i] = v1[i] - v2[i];
+    }
+}
+
+static inline float squaredNormf(int dimensions, const float *v)
+{
+    float result = 0.0f;
+    
+    for (int i = 0; i < dimensions; i++) {
+        result += v[i] * v[i];
+    }
+    
+    return result;
+}
+
+static inline float normf(int dimensions, const float *v)
+{
+    return sqrtf(squaredNormf(dimensions, v));
+}
+
 #endif /* INTUVector_h */